@@ -0,0 +1,38 @@
+/**********************************************************************
+* IAR intrinsics.h for msp430-elf-gcc
+
+msp430.h brings in TI's in430.h with __bis_SR_register, __bic_SR_register_on_exit,
+__enable_interrupt and the rest.  The ones it may not have are added here.
+**********************************************************************/
+
+/************************ Revision History ****************************
+YYYY-MM-DD  Comments
+-------------------------------------------------------------------------------------------
+2026-10-19  File created
+
+************************************************************************/
+
+#ifndef __GCC_INTRINSICS_HEADER
+#define __GCC_INTRINSICS_HEADER
+
+#include "io430.h"
+
+#ifndef __even_in_range
+#define __even_in_range(value, bound)   (value)
+#endif
+
+#define __istate_t                      unsigned short
+#ifndef __get_interrupt_state
+#define __get_interrupt_state()         __get_SR_register()
+#endif
+#ifndef __set_interrupt_state
+#define __set_interrupt_state(state)    __bis_SR_register((state) & GIE)
+#endif
+
+/* stack.c only asks for CSTACK, lnk430F2122_BLINK.ld gives its bounds */
+extern unsigned char __cstack_begin[];
+extern unsigned char __cstack_end[];
+#define __segment_begin(segment)        ((void*)__cstack_begin)
+#define __segment_end(segment)          ((void*)__cstack_end)
+
+#endif /* __GCC_INTRINSICS_HEADER */
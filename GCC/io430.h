@@ -0,0 +1,27 @@
+/**********************************************************************
+* IAR io430.h for msp430-elf-gcc
+
+The firmware includes IAR's io430.h, io430f2122.h and intrinsics.h.  The GNU build puts this
+directory first on the include path so the same sources build with TI's msp430.h instead.
+The register and bit names are the same in both.
+**********************************************************************/
+
+/************************ Revision History ****************************
+YYYY-MM-DD  Comments
+-------------------------------------------------------------------------------------------
+2026-10-19  File created
+
+************************************************************************/
+
+#ifndef __GCC_IO430_HEADER
+#define __GCC_IO430_HEADER
+
+#include <msp430.h>
+
+/* Left alone by cstartup.S, see .noinit in lnk430F2122_BLINK.ld */
+#define __no_init              __attribute__((section(".noinit")))
+
+/* Only in prototypes, main.c gives the definitions the interrupt attribute */
+#define __interrupt
+
+#endif /* __GCC_IO430_HEADER */
@@ -0,0 +1,12 @@
+/**********************************************************************
+* IAR io430f2122.h for msp430-elf-gcc, see io430.h
+**********************************************************************/
+
+/************************ Revision History ****************************
+YYYY-MM-DD  Comments
+-------------------------------------------------------------------------------------------
+2026-10-19  File created
+
+************************************************************************/
+
+#include "io430.h"
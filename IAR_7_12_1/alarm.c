@@ -0,0 +1,249 @@
+/**********************************************************************
+* Definitions for alarm functions
+**********************************************************************/
+
+/************************ Revision History ****************************
+YYYY-MM-DD  Comments
+-------------------------------------------------------------------------------------------
+2026-10-19  File created
+
+************************************************************************/
+
+#include "io430.h"
+#include "typedef_MSP430.h"
+#include "alarm.h"
+#include "buzzer.h"
+#include "bnclk-efwd-01.h"
+
+#if ALARMS_ENABLED
+
+/******************** External Globals ************************/
+/* Globally available variables from other files as indicated */
+extern const NoteInformation GG_aMelodyAlarm[];    /* From buzzer.c */
+
+/******************** Program Globals ************************/
+/* Global variable definitions intended for scope across multiple files */
+u16 GG_u16Next_Alarm_Key = ALARM_KEY_NONE;        //the alarm or snooze that rings next, see ALARM_KEY
+u8 GG_u8Alarm_Ringing = 0;                        //minutes left before a ringing alarm stops by itself
+
+/******************** Local Globals ************************/
+/* Global variable definitions intended only for the scope of this file */
+#if CLOCK_24_HOUR
+AlarmInformation LG_aAlarms[ALARM_COUNT] = {{7, 0, false},
+                                            {7, 0, false}};
+#else
+AlarmInformation LG_aAlarms[ALARM_COUNT] = {{7, 0, false, false},
+                                            {7, 0, false, false}};
+#endif
+u16 LG_u16Snooze_Key = ALARM_KEY_NONE;            //pending snooze, rings like another alarm
+
+/******************** Function Definitions ************************/
+
+/*------------------------------------------------------------------------------
+Function: Key_Minutes
+
+Description: Converts an ALARM_KEY to minutes since midnight, 12AM (or hour 0) is 0
+ 
+Requires: 
+
+Promises: Returns 0 - 1439
+*/
+u16 Key_Minutes(u16 u16Key)
+{
+  u8 u8Hour = (u8)(u16Key >> 8) & 0x1F;
+  
+#if !CLOCK_24_HOUR
+  if(u8Hour == 12)
+  {
+    u8Hour = 0;
+  }
+  if(u16Key & 0x8000)
+  {
+    u8Hour += 12;
+  }
+#endif
+  return (u16)u8Hour * MINUTES_PER_HOUR + (u16Key & 0x3F);
+  
+} /* end Key_Minutes */
+
+/*------------------------------------------------------------------------------
+Function: Alarm_Get
+
+Description: Gives access to one alarm's settings for displaying and editing
+ 
+Requires: u8Index < ALARM_COUNT
+
+Promises: Returns a pointer to the alarm, Alarm_Select_Next must be called after changing it
+*/
+AlarmInformation* Alarm_Get(u8 u8Index)
+{
+  return &LG_aAlarms[u8Index];
+  
+} /* end Alarm_Get */
+
+/*------------------------------------------------------------------------------
+Function: Alarm_Select_Next
+
+Description: Scans the alarms and any snooze for the one that is due soonest after now.
+This only runs when the time or an alarm is changed, or an alarm has just rung, so the
+minute rollover only has to compare against GG_u16Next_Alarm_Key.
+ 
+Requires: u16Now_Key is ALARM_KEY of the current time
+
+Promises: GG_u16Next_Alarm_Key is the next alarm, or ALARM_KEY_NONE if none are on.
+An alarm set to the current minute is due tomorrow.
+*/
+void Alarm_Select_Next(u16 u16Now_Key)
+{
+  u16 u16Now = Key_Minutes(u16Now_Key);
+  u16 u16Best_Wait = 0xFFFF;
+  u16 u16Wait;
+  u16 u16Key;
+  u8 i;
+  
+  GG_u16Next_Alarm_Key = ALARM_KEY_NONE;
+  for(i = 0; i <= ALARM_COUNT; i++)
+  {
+    if(i == ALARM_COUNT)
+    {
+      u16Key = LG_u16Snooze_Key;
+      if(u16Key == ALARM_KEY_NONE)
+      {
+        break;
+      }
+    }
+    else if(LG_aAlarms[i].u8On)
+    {
+      u16Key = ALARM_KEY(LG_aAlarms[i].u8Hour, LG_aAlarms[i].u8Minute, LG_aAlarms[i].u8PM);
+    }
+    else
+    {
+      continue;
+    }
+    
+    u16Wait = Key_Minutes(u16Key);
+    if(u16Wait <= u16Now)
+    {
+      u16Wait += MINUTES_PER_DAY;
+    }
+    u16Wait -= u16Now;
+    if(u16Wait < u16Best_Wait)
+    {
+      u16Best_Wait = u16Wait;
+      GG_u16Next_Alarm_Key = u16Key;
+    }
+  }
+  
+} /* end Alarm_Select_Next */
+
+/*------------------------------------------------------------------------------
+Function: Alarm_Minute
+
+Description: Starts the buzzer when the next alarm is due and counts down a ringing alarm
+ 
+Requires: Called on a minute rollover when u16Now_Key == GG_u16Next_Alarm_Key or GG_u8Alarm_Ringing
+
+Promises: 
+  - A due alarm rings for ALARM_RING_MINUTES and the alarm after it is selected
+  - A ringing alarm that nobody answered is stopped
+*/
+void Alarm_Minute(u16 u16Now_Key)
+{
+  if(GG_u8Alarm_Ringing)
+  {
+    GG_u8Alarm_Ringing--;
+    if(GG_u8Alarm_Ringing == 0)
+    {
+      Melody_Stop();
+    }
+  }
+  
+  if(u16Now_Key == GG_u16Next_Alarm_Key)
+  {
+    if(u16Now_Key == LG_u16Snooze_Key)
+    {
+      LG_u16Snooze_Key = ALARM_KEY_NONE;
+    }
+    Alarm_Ring();
+    Alarm_Select_Next(u16Now_Key);
+  }
+  
+} /* end Alarm_Minute */
+
+/*------------------------------------------------------------------------------
+Function: Alarm_Ring
+
+Description: Starts the alarm pattern, for a due alarm or the countdown running out
+ 
+Requires: 
+
+Promises: The buzzer rings for ALARM_RING_MINUTES and can be snoozed or dismissed like any alarm
+*/
+void Alarm_Ring()
+{
+  Melody_Play(GG_aMelodyAlarm);
+  GG_u8Alarm_Ringing = ALARM_RING_MINUTES;
+  
+} /* end Alarm_Ring */
+
+/*------------------------------------------------------------------------------
+Function: Alarm_Snooze
+
+Description: Stops a ringing alarm and schedules it to ring again ALARM_SNOOZE_MINUTES from now
+ 
+Requires: u16Now_Key is ALARM_KEY of the current time
+
+Promises: The snooze is one of the candidates for GG_u16Next_Alarm_Key until it rings or is dismissed
+*/
+void Alarm_Snooze(u16 u16Now_Key)
+{
+  u8 u8Hour = (u8)(u16Now_Key >> 8) & 0x1F;
+  u8 u8Minute = (u8)(u16Now_Key & 0x3F) + ALARM_SNOOZE_MINUTES;
+#if !CLOCK_24_HOUR
+  u8 u8PM = (u16Now_Key & 0x8000) != 0;
+#endif
+  
+  if(u8Minute >= MINUTES_PER_HOUR)   //the snooze is under an hour so it carries once, no divider needed
+  {
+    u8Minute -= MINUTES_PER_HOUR;
+    u8Hour++;
+#if CLOCK_24_HOUR
+    if(u8Hour == 24)
+    {
+      u8Hour = 0;
+    }
+#else
+    if(u8Hour == 12)                 //11:5x AM snoozes to 12:0x PM, like Time_Rollover
+    {
+      u8PM = !u8PM;
+    }
+    else if(u8Hour == 13)
+    {
+      u8Hour = 1;
+    }
+#endif
+  }
+  
+  LG_u16Snooze_Key = ALARM_KEY(u8Hour, u8Minute, u8PM);
+  Alarm_Dismiss();
+  Alarm_Select_Next(u16Now_Key);
+  
+} /* end Alarm_Snooze */
+
+/*------------------------------------------------------------------------------
+Function: Alarm_Dismiss
+
+Description: Stops a ringing alarm
+ 
+Requires: 
+
+Promises: The buzzer is off, a pending snooze is not cancelled by this
+*/
+void Alarm_Dismiss()
+{
+  GG_u8Alarm_Ringing = 0;
+  Melody_Stop();
+  
+} /* end Alarm_Dismiss */
+
+#endif /* ALARMS_ENABLED */
@@ -0,0 +1,69 @@
+/**********************************************************************
+* Header file for alarm functions
+**********************************************************************/
+
+/************************ Revision History ****************************
+YYYY-MM-DD  Comments
+-------------------------------------------------------------------------------------------
+2026-10-19  File created
+
+************************************************************************/
+
+#ifndef __ALARM_HEADER
+#define __ALARM_HEADER
+
+#include "typedef_MSP430.h"
+#include "bnclk-efwd-01.h"
+
+/******************************************************************************
+Type Definitions
+******************************************************************************/
+
+typedef struct
+{
+  u8 u8Hour;
+  u8 u8Minute;
+#if !CLOCK_24_HOUR
+  u8 u8PM;
+#endif
+  u8 u8On;
+}AlarmInformation;
+
+/****************************************************************************************
+Constants
+****************************************************************************************/
+
+#if ALARMS_ENABLED
+#define ALARM_COUNT            (u8)2
+#else
+#define ALARM_COUNT            (u8)0     /* no alarm modes */
+#endif
+#define ALARM_RING_MINUTES     (u8)5     /* an alarm nobody answers stops by itself */
+#define ALARM_SNOOZE_MINUTES   (u16)9     /* under an hour, Alarm_Snooze carries into the hour once */
+#define MINUTES_PER_HOUR       (u16)60
+#define MINUTES_PER_DAY        (u16)1440
+
+/* A time of day packed so the clock can be compared to the next alarm with one compare:
+   <15> PM, <12-8> hour, <5-0> minute.  The 24 hour variant has no PM and leaves the argument out */
+#if CLOCK_24_HOUR
+#define ALARM_KEY(hour, minute, pm)  ((u16)((u16)(hour) << 8) | (u16)(minute))
+#else
+#define ALARM_KEY(hour, minute, pm)  ((u16)((u16)(pm) << 15) | (u16)((u16)(hour) << 8) | (u16)(minute))
+#endif
+#define ALARM_KEY_NONE         (u16)0xFFFF  /* never matches a real time */
+
+/************************ Function Declarations ****************************/
+
+#if ALARMS_ENABLED
+u16 Key_Minutes(u16 u16Key);              /*Converts an ALARM_KEY to minutes since midnight*/
+AlarmInformation* Alarm_Get(u8 u8Index);  /*The settings for alarm u8Index*/
+void Alarm_Select_Next(u16 u16Now_Key);   /*Finds the next alarm after now and stores it in GG_u16Next_Alarm_Key*/
+void Alarm_Minute(u16 u16Now_Key);        /*Minute rollover work, only called when the next alarm is due or one is ringing*/
+void Alarm_Ring();                        /*Starts the buzzer ringing as an alarm*/
+void Alarm_Snooze(u16 u16Now_Key);        /*Stops the buzzer and rings again in ALARM_SNOOZE_MINUTES*/
+void Alarm_Dismiss();                     /*Stops the buzzer*/
+#else
+#define Alarm_Select_Next(now)
+#endif
+
+#endif /* __ALARM_HEADER */
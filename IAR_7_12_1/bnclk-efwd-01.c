@@ -14,55 +14,81 @@ YYYY-MM-DD  Comments
 #include "intrinsics.h"
 #include "bnclk-efwd-01.h"
 #include "leds.h"
+#include "alarm.h"
+#include "buzzer.h"
+#include "calendar.h"
+#include "stopwatch.h"
+#include "console.h"
+#include "telemetry.h"
+#include "profile.h"
+#include "counters.h"
+#include "stack.h"
 #include "main.h"
+#include "camper.h"
 
 /******************** External Globals ************************/
 /* Globally available variables from other files as indicated */
+#if ALARMS_ENABLED
+extern u16 GG_u16Next_Alarm_Key;                   /* From alarm.c */
+extern u8 GG_u8Alarm_Ringing;                      /* From alarm.c */
+#else
+#define GG_u8Alarm_Ringing false                   /* nothing rings without the alarms */
+#endif
+#if HOURLY_CHIME_ENABLED
+extern const NoteInformation GG_aMelodyChime[];    /* From buzzer.c */
+#endif
+#if TIMERS_ENABLED
+extern volatile u8 GG_u8Countdown_Done;            /* From stopwatch.c */
+#endif
+extern s16 GG_s16Calibration;                      /* From console.c */
+extern u32 GG_au32Counter[];                       /* From counters.c */
+#if PROFILE_ENABLED
+extern ProfileInformation GG_aProfile[];           /* From profile.c */
+#endif
 
 
 /******************** Program Globals ************************/
 /* Global variable definitions intended for scope across multiple files */
 fnCode_type GG_fpCLOCKSM;      //the state machine function pointer
 int GG_u8Second_Counter = 0;                       //the second counter
+volatile u8 GG_u8Wake_Countdown = 1;               //Timer A ticks left before TimerAISR wakes the main loop
+volatile u8 GG_u8Button_Fast_Ticks = 0;            //Timer A ticks left in the fast button sampling window
+volatile u16 GG_u16Tick_Count = 0;                 //Timer A ticks, free running, with TAR it timestamps the stopwatch and countdown
+#if NEXT_FRAME_ENABLED
+u8 GG_au8Next_Frame[3];                            //LED bits of P1OUT, P2OUT and P3OUT for the next minute
+volatile u8 GG_u8Next_Frame_Ready = false;         //GG_au8Next_Frame is for the next minute boundary and nothing has run since
+#endif
 
 /******************** Local Globals ************************/
 /* Global variable definitions intended only for the scope of this file */
 u8 LG_u8Minute_Counter = 0;                       //the minute counter
 u8 LG_u8Hour_Counter = 12;                        //the hour counter
+#if !CLOCK_24_HOUR
 u8 LG_u8PM = 1;                                   //AM/PM counter, when LSB is 1 output is PM, 0>AM
+#endif
 u8 LG_u8Flash = 1;                                //on/off for when flashing outputs
+u8 LG_u8Button_History = 0;                       //buttons that were down at the last sample, P3 and P2 bits don't overlap
+u8 LG_u8Button_Active = 0;                        //the button the current press is for, one of the button pin masks
+u8 LG_u8Repeat_Count = 0;                         //steps taken so far while the current button is held
+u8 LG_u8Mode = MODE_CLOCK;                        //MODE_CLOCK, the alarm number + 1 being set, MODE_DATE to MODE_COUNTDOWN
+u8 LG_u8Mode_Timeout = 0;                         //seconds left before an alarm being set goes back to the clock
 
-LedInformation LG_aLedInfoHourLeds[LEDS_FOR_HOURS] = {{(u16*)0x0019, P3_2_HOUR_0},
-                                                      {(u16*)0x0019, P3_1_HOUR_1},
-                                                      {(u16*)0x0019, P3_0_HOUR_2},
-                                                      {(u16*)0x0029, P2_2_HOUR_3}};
-//This is so that the campers will have a simpler names to use
-#define hourCounter LG_u8Hour_Counter
-#define hourLeds LG_aLedInfoHourLeds
-#define HOUR_LED_ZERO hourLeds[0]
-#define HOUR_LED_ONE hourLeds[1]
-#define HOUR_LED_TWO hourLeds[2]
-#define HOUR_LED_THREE hourLeds[3]
-
-LedInformation LG_aLedInfoMinuteLeds[LEDS_FOR_MINUTES] = {{(u16*)0x0021, P1_3_MINUTE_0},
-                                                          {(u16*)0x0021, P1_2_MINUTE_1},
-                                                          {(u16*)0x0021, P1_1_MINUTE_2},
-                                                          {(u16*)0x0021, P1_0_MINUTE_3},
-                                                          {(u16*)0x0029, P2_4_MINUTE_4},
-                                                          {(u16*)0x0029, P2_3_MINUTE_5}};
-//This is so that the campers will have a simpler names to use
-#define minuteCounter LG_u8Minute_Counter
-#define minuteLeds LG_aLedInfoMinuteLeds
-#define MINUTE_LED_ZERO minuteLeds[0]
-#define MINUTE_LED_ONE minuteLeds[1]
-#define MINUTE_LED_TWO minuteLeds[2]
-#define MINUTE_LED_THREE minuteLeds[3]
-#define MINUTE_LED_FOUR minuteLeds[4]
-#define MINUTE_LED_FIVE minuteLeds[5]
-
-LedInformation LG_LedInfoPMLed = {(u16*)0x0019, P3_5_POMI_PM_IND};
-#define PM_LED LG_LedInfoPMLed
-#define PM LG_u8PM
+LedInformation LG_aLedInfoHourLeds[LEDS_FOR_HOURS] = {{&P3OUT, P3_2_HOUR_0},
+                                                      {&P3OUT, P3_1_HOUR_1},
+                                                      {&P3OUT, P3_0_HOUR_2},
+                                                      {&P2OUT, P2_2_HOUR_3}};
+
+LedInformation LG_aLedInfoMinuteLeds[LEDS_FOR_MINUTES] = {{&P1OUT, P1_3_MINUTE_0},
+                                                          {&P1OUT, P1_2_MINUTE_1},
+                                                          {&P1OUT, P1_1_MINUTE_2},
+                                                          {&P1OUT, P1_0_MINUTE_3},
+                                                          {&P2OUT, P2_4_MINUTE_4},
+                                                          {&P2OUT, P2_3_MINUTE_5}};
+
+#if !CLOCK_24_HOUR
+LedInformation LG_LedInfoPMLed = {&P3OUT, P3_5_POMI_PM_IND};
+#endif
+//The simpler names the campers use for these are in camper.h
 
 /******************** Function Definitions ************************/
 /*------------------------------------------------------------------------------
@@ -94,7 +120,12 @@ void ClockSM_Start()
     P3OUT &= Port3_Clear_Mask;    
   }
   
-  Poll_Buttons();                 /*this is the only way to break from the start routine*/
+  if(Poll_Buttons())              /*this is the only way to break from the start routine*/
+  {
+    return;                       //run ClockSM_Button_Press straight away
+  }
+  GG_u8Wake_Countdown = 1;        //flashing needs every tick
+  Profile_End(PROFILE_SITE_STATE);
   __bis_SR_register(LPM3_bits);   //sleep until timer A expires
 
 } /* end ClockSM_Start */
@@ -109,30 +140,115 @@ Requires: Timer A has been started
 
 Promises: To flash the TICK LED ~ every 1s, and keep the current time.
 If the buttons are held for an extended time ClockSM_Tick should force the time to recover in a few cycles.
+If the power is off ClockSM_LP_Sleep runs instead, see below.
 */
 void ClockSM_Tick()
 {
+  u8 u8Phase;
+
+  /*Port2ISR makes ClockSM_LP_Sleep the next state when the power goes, but a state function that
+  was running at the time can overwrite it on its way back here (ClockSM_Button_Press sets ClockSM_Tick
+  first thing).  The edge is gone by then so the level is checked on every wake, found by tools/host/model_check*/
+  if(!(P2IN & P2_5_LOST_POWER_IND))
+  {
+    GG_fpCLOCKSM = ClockSM_LP_Sleep;
+    return;                       //the main loop runs it straight away, Port2ISR has logged the loss
+  }
+
   /*Check if the time needs to be updated*/
   if(GG_u8Second_Counter>=240)
   {   //currently using 500ms update cycles
     GG_u8Second_Counter -= 240;   //this should set us to zero but catches any missed half second cycles
     LG_u8Minute_Counter++;
+    COUNT(COUNTER_MINUTES);
+    COUNT(COUNTER_WORK_WAKES);
     Time_Rollover();
-    Update_Display();
+    if(CLOCK_MIDNIGHT())
+    {
+      Calendar_Midnight();
+    }
+    if(LG_u8Minute_Counter == 0)
+    {
+      Telemetry_Log(EVENT_HOUR, Hour_24());
+    }
+    Display_Refresh();
+#if ALARMS_ENABLED
+    if(ALARM_KEY(LG_u8Hour_Counter, LG_u8Minute_Counter, LG_u8PM) == GG_u16Next_Alarm_Key || GG_u8Alarm_Ringing)
+    {
+      Alarm_Minute(ALARM_KEY(LG_u8Hour_Counter, LG_u8Minute_Counter, LG_u8PM));
+    }
+#endif
+#if HOURLY_CHIME_ENABLED
+    if(LG_u8Minute_Counter == 0 && !GG_u8Alarm_Ringing)
+    {
+      Melody_Play(GG_aMelodyChime);
+    }
+#endif
+  }
+#if TIMERS_ENABLED
+  if(GG_u8Countdown_Done)
+  {
+    GG_u8Countdown_Done = false;
+    Alarm_Ring();
   }
+#endif
   
-  /*Toggle the TICK LED*/
-  if (LG_u8Flash==3){
-    LG_u8Flash = 0;
+  /*The TICK LED is on for the first tick of every second.  240 is a multiple of 4 so the
+  minute rollover always lands on phase 0.  While an alarm is being set it is on steadily if that alarm is on.
+  The stopwatch and countdown are shown again on the same wake, they never time out*/
+  u8Phase = GG_u8Second_Counter & TICK_PHASE_MASK;
+  if(MODE_TIMES_OUT(LG_u8Mode) && u8Phase == 0 && --LG_u8Mode_Timeout == 0)
+  {
+    LG_u8Mode = MODE_CLOCK;
+    Update_Display();
+  }
+  if(MODE_IS_TIMER(LG_u8Mode) && u8Phase == 0)
+  {
+    Display_Refresh();
+  }
+#if ALARMS_ENABLED
+  if (MODE_IS_ALARM(LG_u8Mode) ? Alarm_Get(LG_u8Mode - 1)->u8On : (u8Phase == 0)){
+#else
+  if (u8Phase == 0){
+#endif
     P3OUT |= P3_4_PIMO_TICK;           //Turn on TICK
   }
   else
   {
-    LG_u8Flash++;
     P3OUT &= ~P3_4_PIMO_TICK;          //Turn off TICK
   }
   
-  Poll_Buttons();
+  if(Poll_Buttons())
+  {
+    return;                       //run ClockSM_Button_Press straight away
+  }
+#if CONSOLE_ENABLED
+  if(Console_Pending())
+  {
+    GG_fpCLOCKSM = ClockSM_Console;   //a line came in while a button was being handled
+    return;
+  }
+#endif
+  
+  /*Sleep through the ticks where there is nothing to do. The next wake is the TICK LED turning off
+  or the TICK LED turning back on (which is also where the minute rolls over).  TimerAISR samples
+  buttons 1 and 2 on every tick and wakes the main loop for a new press, every 62.5ms for a few seconds
+  after any button activity, and Timer1AISR wakes the main loop for auto-repeat while a button is held*/
+  if(u8Phase == 0)
+  {
+    GG_u8Wake_Countdown = 1;
+  }
+  else
+  {
+    GG_u8Wake_Countdown = TICKS_PER_SECOND - u8Phase;
+  }
+#if NEXT_FRAME_ENABLED
+  if(GG_u8Second_Counter + GG_u8Wake_Countdown >= 240)
+  {
+    Next_Frame_Prepare();         //the next wake is the minute boundary
+  }
+#endif
+  Profile_End(PROFILE_SITE_STATE);
   __bis_SR_register(LPM3_bits);   //sleep until timer A expires
   
 } /* end ClockSM_Tick */
@@ -140,39 +256,164 @@ void ClockSM_Tick()
 /*------------------------------------------------------------------------------
 Function: ClockSM_Button_Press
 
-Description: Debounces the buttons (on a ~250ms debounce which may need to be changed)
-Increments the minute and hour counters for button 1 and 2 respectively
+Description: Steps the time for the button that is down.  Buttons 1 and 2 step the minute and hour and
+auto-repeat while held, starting slowly and speeding up.  The minute steps by 1, then by 5, then by 15
+(always landing on a multiple of the step) so any time can be reached quickly by holding and then tapping.
+The seconds restart when the minute button is released, see Time_Set_Latch.
+Button 0 toggles AM/PM when it is let go, or moves on to setting the next alarm when it is held for
+BUTTON_0_HOLD, then on to showing the date, the stopwatch and the countdown.  While an alarm is being set the
+same buttons step the alarm, and a tap of button 0 turns it on or off.  While the date is shown buttons 1 and 2 set it,
+see Date_Step, and for the stopwatch and countdown they are the controls, see Timer_Step.  While an alarm is ringing button 0 dismisses it and the other buttons snooze it.
  
 Requires: 
   - PIMO and POMI are not being used to communication currently
   - P3_5, 3_4, 2_1 are configured as inputs
+  - LG_u8Button_Active is the button that was pressed, LG_u8Repeat_Count is 0 for a new press
 
 Promises: 
-  - Increases the minute or hour 2X per second as requested
+  - The display is updated once per step
+  - Timer1_A is armed for the next repeat while the button is held, and stopped once it is released
 
 */
 void ClockSM_Button_Press()
 {
-  if(!(P2IN&P2_1_BUTTON_0))
+  u8 u8Step;
+  u8 u8Remainder;
+  u8 u8Button = LG_u8Button_Active;
+  
+  GG_fpCLOCKSM = ClockSM_Tick;
+  TA1CTL = TIMER1_STOP;             //Repeat_Next starts it again if this press carries on
+  COUNT(COUNTER_WORK_WAKES);
+  LG_u8Mode_Timeout = MODE_TIMEOUT_SECONDS;
+  
+#if ALARMS_ENABLED
+  if(GG_u8Alarm_Ringing)
   {
-    //Toggles AM/PM
-    if(LG_u8PM == true)
+    if(u8Button == P2_1_BUTTON_0)
     {
-      LG_u8PM = false;
+      Alarm_Dismiss();
     }
     else
     {
-      LG_u8PM = true;
+      Alarm_Snooze(ALARM_KEY(LG_u8Hour_Counter, LG_u8Minute_Counter, LG_u8PM));
     }
+    TA1CCTL1 = 0;
+    LG_u8Button_Active = 0;         //the rest of this press does nothing
+    return;
   }
-  else if(!(P3IN&P3_7_BUTTON_1))
+#endif
+  
+  if(!(Buttons_Down() & u8Button))
   {
-    LG_u8Minute_Counter++;  //button one increases the minute
-    GG_u8Second_Counter = 0; // and clears the current second so timing the button press give 500ms accuracy approximately
+    //released before the repeat timer ran out
+    if(u8Button == P2_1_BUTTON_0 && LG_u8Repeat_Count == 1)
+    {
+      Button_0_Tap();
+    }
+    else if(TA1CCTL1 & CCIE)
+    {
+      Time_Set_Latch();             //released in the gap between Timer1AISR and here
+    }
+    TA1CCTL1 = 0;
+    LG_u8Repeat_Count = 0;
+    return;
   }
-  else if(!(P3IN&P3_6_BUTTON_2))
+  
+  if(u8Button == P2_1_BUTTON_0)
+  {
+    if(LG_u8Repeat_Count == 0)
+    {
+      TA1CCTL1 = CCIE;              //wait to see if this is a tap or a hold
+      Repeat_Next();
+    }
+    else
+    {
+      //held for BUTTON_0_HOLD, move on to the next alarm, the date, the timers, the console or back to the clock
+      TA1CCTL1 = 0;
+      LG_u8Button_Active = 0;
+      LG_u8Mode++;
+      if(LG_u8Mode > MODE_LAST)
+      {
+        LG_u8Mode = MODE_CLOCK;
+#if CONSOLE_ENABLED
+        Console_Off();
+      }
+      else if(LG_u8Mode == MODE_CONSOLE)
+      {
+        Console_On();
+#endif
+      }
+      Display_Refresh();
+    }
+    return;
+  }
+  
+  if(LG_u8Mode == MODE_CONSOLE)
+  {
+    return;                         //buttons 1 and 2 do nothing while the console sets the clock
+  }
+  
+#if TIMERS_ENABLED
+  if(MODE_IS_TIMER(LG_u8Mode))
+  {
+    Timer_Step(u8Button);           //no auto-repeat, each press is one action
+    Display_Refresh();
+    return;
+  }
+#endif
+  
+#if CALENDAR_ENABLED
+  if(MODE_IS_DATE(LG_u8Mode))
+  {
+    Date_Step(u8Button);
+    Display_Refresh();
+    Repeat_Next();
+    return;
+  }
+#endif
+  
+#if ALARMS_ENABLED
+  if(LG_u8Mode != MODE_CLOCK)
+  {
+    Alarm_Swap();                   //step the alarm with the same code that steps the clock
+  }
+#endif
+  if(u8Button == P3_7_BUTTON_1)
+  {
+    //button one increases the minute to the next multiple of the step
+    if(LG_u8Repeat_Count < REPEAT_STEPS_OF_1)
+    {
+      u8Step = 1;
+    }
+    else if(LG_u8Repeat_Count < REPEAT_STEPS_OF_5)
+    {
+      u8Step = 5;
+    }
+    else
+    {
+      u8Step = 15;
+    }
+    //the F2122 has no divider or multiplier, the remainder by subtraction is at most 11 passes of 5
+    u8Remainder = 0;
+    if(u8Step != 1)
+    {
+      u8Remainder = LG_u8Minute_Counter;
+      while(u8Remainder >= u8Step)
+      {
+        u8Remainder -= u8Step;
+      }
+    }
+    LG_u8Minute_Counter += u8Step - u8Remainder;
+    if(LG_u8Mode == MODE_CLOCK)
+    {
+      GG_u8Second_Counter = 0; // no rollover while setting
+      TA1CCTL1 = CCIE;        // and watches for the release to restart the minute, see Time_Set_Latch
+    }
+  }
+  else
   {
     LG_u8Hour_Counter++;  //button two increases the hour
+#if !CLOCK_24_HOUR
     if(LG_u8Hour_Counter == 12)
     {
       if(LG_u8PM == false)
@@ -184,11 +425,19 @@ void ClockSM_Button_Press()
         LG_u8PM = false;
       }
     }
+#endif
   }
   
   Time_Rollover();
-  Update_Display();
-  GG_fpCLOCKSM = ClockSM_Tick;
+#if ALARMS_ENABLED
+  if(LG_u8Mode != MODE_CLOCK)
+  {
+    Alarm_Swap();
+  }
+#endif
+  Display_Refresh();
+  Alarm_Select_Next(ALARM_KEY(LG_u8Hour_Counter, LG_u8Minute_Counter, LG_u8PM));
+  Repeat_Next();
   
 } /* end ClockSM_Button_Press */
 
@@ -197,7 +446,7 @@ void ClockSM_Button_Press()
 Function: ClockSM_LP_Sleep
 
 Description: Effectively the same as Tick but doesn't poll the buttons or update the display
-until power returns
+until power returns.  The LEDs are turned off on battery, TICK included
 
 Requires: 
   - LP_IND is low
@@ -205,6 +454,7 @@ Requires:
 
 Promises: 
   - Keeps the current time when power is lost and use the least amount of power possible
+  - No LED is lit on battery, the console's pins are left to the UART
 
 */
 void ClockSM_LP_Sleep()
@@ -213,7 +463,34 @@ void ClockSM_LP_Sleep()
   if(P2IN&P2_5_LOST_POWER_IND)
   {
     GG_fpCLOCKSM = ClockSM_Tick;
+    Telemetry_Log(EVENT_POWER_BACK, 0);
+#if CONSOLE_ENABLED
+    if(LG_u8Mode == MODE_CONSOLE)
+    {
+      Console_Off();
+    }
+#endif
+    LG_u8Mode = MODE_CLOCK;
     Update_Display();
+    Alarm_Select_Next(ALARM_KEY(LG_u8Hour_Counter, LG_u8Minute_Counter, LG_u8PM));  //skip alarms missed on battery
+  }
+  else
+  {
+    COUNT(COUNTER_BATTERY_TICKS);
+    P1OUT &= Port1_Clear_Mask;    //dark on battery, Update_Display lights the time again when the power is back
+    P2OUT &= Port2_Clear_Mask;
+    P3OUT &= Port3_Clear_Mask & ~P3_4_PIMO_TICK;
+#if TIMERS_ENABLED
+    GG_u8Countdown_Done = false;  //a countdown that runs out on battery is not signalled
+#endif
+    if(Melody_Playing())
+    {
+#if ALARMS_ENABLED
+      Alarm_Dismiss();            //silences the chime as well
+#else
+      Melody_Stop();
+#endif
+    }
   }
   
     /*Check if the time needs to be updated*/
@@ -221,14 +498,127 @@ void ClockSM_LP_Sleep()
   {
     GG_u8Second_Counter -= 240;
     LG_u8Minute_Counter++;
+    COUNT(COUNTER_MINUTES);
     Time_Rollover();
+    if(CLOCK_MIDNIGHT())
+    {
+      Calendar_Midnight();
+    }
+    if(LG_u8Minute_Counter == 0)
+    {
+      Telemetry_Log(EVENT_HOUR, Hour_24());
+    }
   }
   
+  GG_u8Wake_Countdown = 1;      //check for power every tick
+  Profile_End(PROFILE_SITE_STATE);
   __bis_SR_register(LPM3_bits); //sleep until timer A expires
   
 } /* end ClockSM_LP_Sleep */
 
 
+/*------------------------------------------------------------------------------
+Function: ClockSM_Console
+
+Description: Runs the command lines received by the UART console.  Every command is one letter, on its own
+it reads a value back and with numbers after it sets it:
+  T hh:mm:ss    the time, always 24 hour, the second restarts when the command runs
+  D yyyy-mm-dd  the date
+  C             counters: Timer A ticks and console bytes lost (read only)
+  E             the next records of the telemetry log in hex, removed from the log, empty when it is (read only)
+  K n           calibration, ACLK counts per minute the crystal runs fast, -127 to 127
+  W             stack: the most bytes used since reset and the size of CSTACK (read only)
+  S n           counter n (see counters.h): n, then its value (read only)
+  P n           profile site n (see profile.h): n, then the min, max and average cycles and the sample count (read only)
+The reply is the letter and the value, or the letter and '?' for a bad command.
+ 
+Requires: 
+  - The console is on, LG_u8Mode is MODE_CONSOLE
+  - USCIRxISR or ClockSM_Tick made this the state because a whole line has been received
+
+Promises: 
+  - Every waiting line is answered, nothing waits for the UART
+  - ClockSM_Tick is the next state
+*/
+void ClockSM_Console()
+{
+  u8 au8Line[CONSOLE_LINE_SIZE];
+  u16 au16Value[CONSOLE_VALUES_MAX];
+  u8 u8Count;
+  bool bOk;
+  
+  GG_fpCLOCKSM = ClockSM_Tick;
+  COUNT(COUNTER_WORK_WAKES);
+  while(Console_Read_Line(au8Line))
+  {
+    u8Count = Console_Numbers(&au8Line[1], au16Value);
+    bOk = (u8Count == 0);           //any command can be read back
+    switch(au8Line[0])
+    {
+      case 'T':
+        if(u8Count == 3 && au16Value[0] < 24 && au16Value[1] < Seconds_Per_Minute && au16Value[2] < Seconds_Per_Minute)
+        {
+          Time_Set((u8)au16Value[0], (u8)au16Value[1], (u8)au16Value[2]);
+          bOk = TRUE;
+        }
+        break;
+        
+#if CALENDAR_ENABLED
+      case 'D':
+        if(u8Count == 3)
+        {
+          bOk = Calendar_Set(au16Value[0], au16Value[1], au16Value[2]);
+        }
+        break;
+#endif
+        
+      case 'C':
+#if TELEMETRY_ENABLED
+      case 'E':
+#endif
+        break;
+        
+      case 'K':
+        if(u8Count == 1 && (s16)au16Value[0] >= -CALIBRATION_MAX && (s16)au16Value[0] <= CALIBRATION_MAX)
+        {
+          GG_s16Calibration = (s16)au16Value[0];
+          bOk = TRUE;
+        }
+        break;
+        
+#if PROFILE_ENABLED
+      case 'P':
+        bOk = (u8Count == 1 && au16Value[0] < PROFILE_SITES);
+        break;
+#endif
+        
+      case 'S':
+        bOk = (u8Count == 1 && au16Value[0] < COUNTERS);
+        break;
+        
+      case 'W':
+        break;
+        
+      default:
+        bOk = FALSE;
+        break;
+    }
+    
+    Console_Put(au8Line[0]);
+    if(bOk)
+    {
+      Console_Reply(au8Line[0], au16Value[0]);
+    }
+    else
+    {
+      Console_Put('?');
+    }
+    Console_Put_String("\r\n");
+  }
+  
+} /* end ClockSM_Console */
+
+
 /*------------------------------------------------------------------------------
 Function: Clock_Initialize
 
@@ -268,24 +658,797 @@ void Clock_Initialize()
 -------------------------------------------------------
 Function: Poll_Buttons
 
-Description:  Checks if button 0-2 have been pressed
+Description:  Checks if button 0-2 have been pressed since the last sample
  
 Requires: 
 
 Promises:
-
+  - ClockSM_Button_Press is the next state and TRUE is returned for a new press. A held button
+    is not a new press, it is repeated by Timer1AISR
+  - The button 0 edge interrupt is re-armed once button 0 is released
 */
-void Poll_Buttons()
+bool Poll_Buttons()
 {
-  if(!(P3IN&P3_7_BUTTON_1) || !(P2IN&P2_1_BUTTON_0) || !(P3IN & P3_6_BUTTON_2))
+  u8 u8Down = Buttons_Down();
+  u8 u8New_Press = u8Down & ~LG_u8Button_History;
+  
+  LG_u8Button_History = u8Down;
+  if(!(u8Down & P2_1_BUTTON_0))
   {
-    GG_fpCLOCKSM = ClockSM_Button_Press;
+    P2IFG &= ~P2_1_BUTTON_0;
+    P2IE |= P2_1_BUTTON_0;
   }
   
+  if(u8New_Press)
+  {
+    Button_New_Press(u8New_Press);
+    return TRUE;
+  }
+  return FALSE;
+  
 } /* end Poll_Buttons() */
 
+/*------------------------------------------------------------------------------
+Function: Buttons_Down
+
+Description: Samples all three buttons
+ 
+Requires: 
+
+Promises: Returns the pin masks of the buttons that are down, button 0 is P2_1_BUTTON_0
+*/
+u8 Buttons_Down()
+{
+  return (~P3IN & (P3_6_BUTTON_2 | P3_7_BUTTON_1)) | (~P2IN & P2_1_BUTTON_0);
+  
+} /* end Buttons_Down() */
+
+/*------------------------------------------------------------------------------
+Function: Button_New_Press
+
+Description: Common handling for a new press found by Poll_Buttons, TimerAISR or Port2ISR
+ 
+Requires: 
+
+Promises: ClockSM_Button_Press is the next state and starts a fresh auto-repeat for the new button,
+button 0 first if more than one went down together.  The last press's release sampling is stopped and
+the fast sampling window is (re)started
+*/
+void Button_New_Press(u8 u8New_Press)
+{
+  if(u8New_Press & P2_1_BUTTON_0)
+  {
+    LG_u8Button_Active = P2_1_BUTTON_0;
+  }
+  else if(u8New_Press & P3_7_BUTTON_1)
+  {
+    LG_u8Button_Active = P3_7_BUTTON_1;
+  }
+  else
+  {
+    LG_u8Button_Active = P3_6_BUTTON_2;
+  }
+  GG_fpCLOCKSM = ClockSM_Button_Press;
+  LG_u8Repeat_Count = 0;
+  TA1CCTL1 = 0;                     //the last press's release sampling must not latch on this one
+  Button_Fast_Start();
+  COUNT(COUNTER_BUTTONS);
+  if(LG_u8Button_Active == P2_1_BUTTON_0)
+  {
+    Telemetry_Log(EVENT_BUTTON_0, 0);
+  }
+  else if(LG_u8Button_Active == P3_7_BUTTON_1)
+  {
+    Telemetry_Log(EVENT_BUTTON_1, 0);
+  }
+  else
+  {
+    Telemetry_Log(EVENT_BUTTON_2, 0);
+  }
+  
+} /* end Button_New_Press() */
+
+/*------------------------------------------------------------------------------
+Function: Button_Fast_Start
+
+Description: Starts sampling buttons 1 and 2 every 62.5ms from TimerAISR using TACCR1.
+Port 3 has no pin interrupts so this is how presses shortly after other activity get a fast response.
+ 
+Requires: Timer A is running in up mode to TIME_250MS
+
+Promises: TimerAISR gets a CCR1 interrupt 62.5ms, 125ms and 187.5ms into every tick for BUTTON_FAST_TICKS ticks
+*/
+void Button_Fast_Start()
+{
+  if(GG_u8Button_Fast_Ticks == 0)
+  {
+    TACCR1 = TIME_62MS;
+    TACCTL1 = CCIE;
+  }
+  GG_u8Button_Fast_Ticks = BUTTON_FAST_TICKS;
+  
+} /* end Button_Fast_Start() */
+
+/*------------------------------------------------------------------------------
+Function: Button_Fast_Sample
+
+Description: Runs from TimerAISR on every tick, and on every sub-tick of the fast sampling window.
+Only new presses are acted on here, a button that is held is repeated by Timer1AISR.
+ 
+Requires: Only called from interrupt context
+
+Promises: 
+  - Returns TRUE and makes ClockSM_Button_Press the next state if button 1 or 2 went down
+  - The fast window is closed after BUTTON_FAST_TICKS ticks without activity
+*/
+bool Button_Fast_Sample()
+{
+  u8 u8Pressed = ~P3IN & (P3_6_BUTTON_2 | P3_7_BUTTON_1);
+  u8 u8New_Press = u8Pressed & ~LG_u8Button_History;
+  
+  LG_u8Button_History = (LG_u8Button_History & P2_1_BUTTON_0) | u8Pressed;
+  if(u8New_Press && GG_fpCLOCKSM != ClockSM_LP_Sleep)
+  {
+    Button_New_Press(u8New_Press);
+    return TRUE;
+  }
+  return FALSE;
+  
+} /* end Button_Fast_Sample() */
+
+/*------------------------------------------------------------------------------
+Function: Button_0_Pressed
+
+Description: Runs from Port2ISR on the falling edge of button 0.  The edge interrupt is
+turned off until Poll_Buttons sees the button released so contact bounce cannot toggle AM/PM twice.
+ 
+Requires: Only called from interrupt context
+
+Promises: Returns TRUE and makes ClockSM_Button_Press the next state unless power is lost
+*/
+bool Button_0_Pressed()
+{
+  P2IE &= ~P2_1_BUTTON_0;
+  LG_u8Button_History |= P2_1_BUTTON_0;
+  if(GG_fpCLOCKSM == ClockSM_LP_Sleep)
+  {
+    return FALSE;
+  }
+  Button_New_Press(P2_1_BUTTON_0);
+  return TRUE;
+  
+} /* end Button_0_Pressed() */
+
+/*------------------------------------------------------------------------------
+Function: Repeat_Next
+
+Description: Arms Timer1_A as a one shot for the next auto-repeat step of the held button.
+The first repeat waits REPEAT_FIRST_DELAY so a normal press only steps once, repeats then
+come every REPEAT_SLOW and every REPEAT_FAST once the minute is stepping by 15.
+Button 0 never repeats, it only gets one BUTTON_0_HOLD interval to tell a tap from a hold.
+ 
+Requires: Called right after a step by ClockSM_Button_Press
+
+Promises: Timer1AISR wakes the main loop into ClockSM_Button_Press when the interval is over
+*/
+void Repeat_Next()
+{
+  u16 u16Interval;
+  
+  if(LG_u8Button_Active == P2_1_BUTTON_0)
+  {
+    u16Interval = BUTTON_0_HOLD;
+  }
+  else if(LG_u8Repeat_Count == 0)
+  {
+    u16Interval = REPEAT_FIRST_DELAY;
+  }
+  else if(LG_u8Repeat_Count < REPEAT_STEPS_OF_5)
+  {
+    u16Interval = REPEAT_SLOW;
+  }
+  else
+  {
+    u16Interval = REPEAT_FAST;
+  }
+  if(LG_u8Repeat_Count < REPEAT_STEPS_OF_5)
+  {
+    LG_u8Repeat_Count++;          //no need to count past the last speed up
+  }
+  
+  TA1CCR0 = u16Interval;
+  TA1CCR1 = TIME_SET_SAMPLE;
+  TA1CCTL0 = CCIE;
+  TA1CTL = TIMER1_REPEAT_START;
+  
+} /* end Repeat_Next() */
+
+/*------------------------------------------------------------------------------
+Function: Time_Set_Latch
+
+Description: Ends a minute set when the minute button is released.  Timer A and the tick count
+are both restarted so the new minute begins on the release, e.g. when setting against a time signal,
+instead of part way through whatever quarter second was running when the button was pressed.
+The release is found by Timer1A1ISR sampling the button every TIME_SET_SAMPLE while it is held.
+ 
+Requires: Interrupts are off (called from Timer1A1ISR or with TA1CCTL1 sampling stopped)
+
+Promises: 
+  - TAR and GG_u8Second_Counter are 0 so the next minute rollover is exactly 60s away
+  - The release sampling and the auto-repeat timer are stopped
+*/
+void Time_Set_Latch()
+{
+  TACTL = TIMERA_INITIALIZE;      //clears TAR and the divider, keeps up mode and the interrupt
+  Profile_Cancel();
+  GG_u8Second_Counter = 0;
+  TA1CCTL1 = 0;
+  TA1CTL = TIMER1_STOP;
+  GG_u8Wake_Countdown = 1;        //the TICK LED phase moved, let ClockSM_Tick reschedule
+  Telemetry_Log(EVENT_TIME_SET, 0);
+  
+} /* end Time_Set_Latch() */
+
+/*------------------------------------------------------------------------------
+Function: Button_Release_Sample
+
+Description: Runs from Timer1A1ISR every TIME_SET_SAMPLE while a button is held so a release is
+acted on straight away instead of at the next repeat.  Releasing the minute button while the clock's
+time is being set restarts the minute, see Time_Set_Latch, releasing button 0 before BUTTON_0_HOLD makes
+it a tap.  The release of any other press only stops the sampling.
+ 
+Requires: Only called from interrupt context, Timer1_A is running
+
+Promises: Returns TRUE and makes ClockSM_Button_Press the next state when button 0 is released
+*/
+bool Button_Release_Sample()
+{
+  if(Buttons_Down() & LG_u8Button_Active)
+  {
+    TA1CCR1 += TIME_SET_SAMPLE;
+    return FALSE;
+  }
+  if(LG_u8Button_Active != P2_1_BUTTON_0 && LG_u8Mode == MODE_CLOCK)
+  {
+    Time_Set_Latch();
+    return FALSE;
+  }
+  
+  TA1CCTL1 = 0;
+  TA1CTL = TIMER1_STOP;
+  if(LG_u8Button_Active != P2_1_BUTTON_0 || GG_fpCLOCKSM == ClockSM_LP_Sleep)
+  {
+    return FALSE;
+  }
+  GG_fpCLOCKSM = ClockSM_Button_Press;
+  return TRUE;
+  
+} /* end Button_Release_Sample() */
+
+/*------------------------------------------------------------------------------
+Function: Button_0_Tap
+
+Description: A short press of button 0.  Toggles AM/PM, or turns the alarm being set on or off.
+It does nothing while the date is shown, or on the clock in the 24 hour variant.
+ 
+Requires: 
+
+Promises: The display and the next alarm are up to date
+*/
+void Button_0_Tap()
+{
+#if ALARMS_ENABLED
+  AlarmInformation* pAlarm;
+#endif
+  
+#if !CLOCK_24_HOUR
+  if(LG_u8Mode == MODE_CLOCK)
+  {
+    if(LG_u8PM == false)
+    {
+      LG_u8PM = true;
+    }
+    else
+    {
+      LG_u8PM = false;
+    }
+  }
+#endif
+#if ALARMS_ENABLED
+  if(MODE_IS_ALARM(LG_u8Mode))
+  {
+    pAlarm = Alarm_Get(LG_u8Mode - 1);
+    if(pAlarm->u8On == false)
+    {
+      pAlarm->u8On = true;
+    }
+    else
+    {
+      pAlarm->u8On = false;
+    }
+  }
+#endif
+  Display_Refresh();
+  Alarm_Select_Next(ALARM_KEY(LG_u8Hour_Counter, LG_u8Minute_Counter, LG_u8PM));
+  
+} /* end Button_0_Tap() */
+
+#if ALARMS_ENABLED
+/*------------------------------------------------------------------------------
+Function: Alarm_Swap
+
+Description: Swaps the clock time with the alarm being set so the alarm can be stepped, rolled over
+and shown by the same code as the clock.  Calling it a second time swaps them back.
+ 
+Requires: LG_u8Mode is an alarm, not MODE_CLOCK.  Interrupts never use the clock time
+
+Promises: The hour, minute and PM of the clock and the alarm are exchanged
+*/
+void Alarm_Swap()
+{
+  AlarmInformation* pAlarm = Alarm_Get(LG_u8Mode - 1);
+  u8 u8Temp;
+  
+  u8Temp = pAlarm->u8Hour;
+  pAlarm->u8Hour = LG_u8Hour_Counter;
+  LG_u8Hour_Counter = u8Temp;
+  
+  u8Temp = pAlarm->u8Minute;
+  pAlarm->u8Minute = LG_u8Minute_Counter;
+  LG_u8Minute_Counter = u8Temp;
+  
+#if !CLOCK_24_HOUR
+  u8Temp = pAlarm->u8PM;
+  pAlarm->u8PM = LG_u8PM;
+  LG_u8PM = u8Temp;
+#endif
+  
+} /* end Alarm_Swap() */
+#endif
+
+/*------------------------------------------------------------------------------
+Function: Display_Refresh
+
+Description: Shows the clock, the alarm being set, the date or a timer.  The date is shown as the month on the
+hour LEDs and the day on the minute LEDs, then the weekday (1 Monday - 7 Sunday) on the hour LEDs and
+the year of the century on the minute LEDs with the PM LED as its 64s bit.  The stopwatch and countdown
+are shown as minutes and seconds, see Display_Duration.
+ 
+Requires: 
+
+Promises: The hour, minute and PM LEDs match the current mode
+*/
+void Display_Refresh()
+{
+#if CALENDAR_ENABLED
+  CalendarInformation* pCalendar;
+#endif
+  
+#if TIMERS_ENABLED
+  if(LG_u8Mode == MODE_STOPWATCH)
+  {
+    Display_Duration(Stopwatch_Shown());
+    return;
+  }
+  if(LG_u8Mode == MODE_COUNTDOWN)
+  {
+    Display_Duration(Countdown_Remaining());
+    return;
+  }
+#endif
+#if CALENDAR_ENABLED
+  if(MODE_IS_DATE(LG_u8Mode))
+  {
+    pCalendar = Calendar_Get();
+    if(LG_u8Mode == MODE_DATE)
+    {
+      Display_Show(pCalendar->u8Month, pCalendar->u8Day, false);
+    }
+    else
+    {
+      Display_Show(pCalendar->u8Weekday, pCalendar->u8Year & 0x3F, pCalendar->u8Year >> 6);
+    }
+    return;
+  }
+#endif
+#if ALARMS_ENABLED
+  if(MODE_IS_ALARM(LG_u8Mode))
+  {
+    Alarm_Swap();
+    Update_Display();
+    Alarm_Swap();
+    return;
+  }
+#endif
+  Update_Display();                 //the clock, also while the console has the TICK and PM pins
+  
+} /* end Display_Refresh() */
+
+/*------------------------------------------------------------------------------
+Function: Display_Show
+
+Description: Shows any value on the LEDs in plain binary, used for everything that is not the 12 hour time.
+Each port is written once so an LED that stays the same does not blink off on the way.
+ 
+Requires: u8Hour is 0 - 15, u8Minute is 0 - 63, u8PM is true or false
+
+Promises: The hour, minute and PM LEDs show the values given, the time is unchanged
+*/
+void Display_Show(u8 u8Hour, u8 u8Minute, u8 u8PM)
+{
+  u8 au8Frame[3];
+
+  Display_Frame(u8Hour, u8Minute, u8PM, au8Frame);
+  P1OUT = (P1OUT & Port1_Clear_Mask) | au8Frame[0];
+  P2OUT = (P2OUT & Port2_Clear_Mask) | au8Frame[1];
+  P3OUT = (P3OUT & Port3_Clear_Mask) | au8Frame[2];
+  
+} /* end Display_Show() */
+
+/*------------------------------------------------------------------------------
+Function: Display_Frame
+
+Description: The LED bits of each port for a value shown in plain binary, the same bits Update_Display
+drives for a 12 hour time (hours 1 - 12 are plain binary on the hour LEDs)
+ 
+Requires: u8Hour is 0 - 15, u8Minute is 0 - 63, u8PM is true or false
+
+Promises: au8Frame[0..2] are the P1OUT, P2OUT and P3OUT LED bits, the other bits are 0
+*/
+void Display_Frame(u8 u8Hour, u8 u8Minute, u8 u8PM, u8* au8Frame)
+{
+  u8 Port_Update_Value = 0;
+
+  /*Port 1 LED driver  output port is x x x x m0 m1 m2 m3*/
+  for(u8 i = 0; i < 4; i++)
+  {
+    Port_Update_Value |= (((u8Minute<<i) & Port1_Update_Mask)>>(3-i));
+  }
+  au8Frame[0] = Port_Update_Value;
+  
+  /*Port 2 LED driver  output port is x x x m4 m5 h3 x x*/
+  au8Frame[1] = ((u8Minute >> 2) & P2_3_MINUTE_5) | (u8Minute & P2_4_MINUTE_4) | ((u8Hour >> 1) & P2_2_HOUR_3);
+  
+  /*Port 3 LED driver output port is x PM x x x h0 h1 h2 */
+  Port_Update_Value = 0;
+  for(u8 i = 0; i < 3; i++)
+  {
+    Port_Update_Value |= (((u8Hour<<(i)) & Port3_Update_Mask)>>(2-i));
+  }
+  au8Frame[2] = Port_Update_Value | ((u8PM << 5) & P3_5_POMI_PM_IND);
+  
+} /* end Display_Frame() */
+
+#if NEXT_FRAME_ENABLED
+/*------------------------------------------------------------------------------
+Function: Next_Frame_Prepare
+
+Description: Works out the LEDs of the next minute on the wake before the minute changes, for TimerAISR
+to show on the tick it changes with a few writes that take the same cycles every time.  Without it the
+LEDs change when the main loop has woken and run ClockSM_Tick, Time_Rollover and Update_Display, a
+different number of cycles for every time and state.  That wake still runs them all and draws the same
+LEDs again, so the display is right even when no frame was ready.
+ 
+Requires: 
+  - Called last thing before sleeping when the next wake is at or after the minute boundary
+  - The main loop clears GG_u8Next_Frame_Ready on every wake and Port2ISR on a power loss, so a frame
+    is only shown if nothing has run since it was made
+
+Promises: When the clock is shown, GG_au8Next_Frame
+is the LEDs of the next minute and GG_u8Next_Frame_Ready is set.  The time is unchanged.
+*/
+void Next_Frame_Prepare()
+{
+  u8 u8Minute = LG_u8Minute_Counter;
+  u8 u8Hour = LG_u8Hour_Counter;
+#if !CLOCK_24_HOUR
+  u8 u8PM = LG_u8PM;
+#endif
+
+  if(LG_u8Mode != MODE_CLOCK)
+  {
+    return;
+  }
+  
+  /*Time_Rollover is the one rule for the next time, the counters are put back after it*/
+  LG_u8Minute_Counter++;
+#if CLOCK_24_HOUR
+  Time_Rollover();
+  Display_Frame(LG_u8Hour_Counter & 0x0F, LG_u8Minute_Counter, LG_u8Hour_Counter >> 4, GG_au8Next_Frame);
+#else
+  Time_Rollover();
+  Display_Frame(LG_u8Hour_Counter, LG_u8Minute_Counter, LG_u8PM, GG_au8Next_Frame);
+  LG_u8PM = u8PM;
+#endif
+  LG_u8Minute_Counter = u8Minute;
+  LG_u8Hour_Counter = u8Hour;
+  GG_u8Next_Frame_Ready = true;
+  
+} /* end Next_Frame_Prepare() */
+#endif
+
+#if CALENDAR_ENABLED
+/*------------------------------------------------------------------------------
+Function: Date_Step
+
+Description: Date setting while the date is shown.  With the month and day shown button 1 steps
+the day and button 2 the month, with the weekday and year shown button 1 steps the year by 1 and
+button 2 by YEAR_STEP_BIG.
+ 
+Requires: LG_u8Mode is MODE_DATE or MODE_YEAR
+
+Promises: The date is changed and the weekday recalculated
+*/
+void Date_Step(u8 u8Button)
+{
+  if(LG_u8Mode == MODE_DATE)
+  {
+    if(u8Button == P3_7_BUTTON_1)
+    {
+      Calendar_Step_Day();
+    }
+    else
+    {
+      Calendar_Step_Month();
+    }
+  }
+  else
+  {
+    if(u8Button == P3_7_BUTTON_1)
+    {
+      Calendar_Step_Year(1);
+    }
+    else
+    {
+      Calendar_Step_Year(YEAR_STEP_BIG);
+    }
+  }
+  
+} /* end Date_Step() */
+#endif
+
+#if TIMERS_ENABLED
+/*------------------------------------------------------------------------------
+Function: Timer_Step
+
+Description: Stopwatch and countdown controls.  For the stopwatch button 1 starts and stops it and
+button 2 shows a lap while running or resets while stopped.  For the countdown button 1 starts and
+pauses it and button 2 adds a minute while stopped or cancels while running.
+ 
+Requires: LG_u8Mode is MODE_STOPWATCH or MODE_COUNTDOWN
+
+Promises: The stopwatch or countdown is changed, the time is unchanged
+*/
+void Timer_Step(u8 u8Button)
+{
+  if(LG_u8Mode == MODE_STOPWATCH)
+  {
+    if(u8Button == P3_7_BUTTON_1)
+    {
+      Stopwatch_Start_Stop();
+    }
+    else
+    {
+      Stopwatch_Lap_Reset();
+    }
+  }
+  else
+  {
+    if(u8Button == P3_7_BUTTON_1)
+    {
+      Countdown_Start_Stop();
+    }
+    else
+    {
+      Countdown_Add_Minute();
+    }
+  }
+  
+} /* end Timer_Step() */
+
+/*------------------------------------------------------------------------------
+Function: Display_Duration
+
+Description: Shows a stopwatch or countdown time as minutes on the hour LEDs with the PM LED as
+the 16s bit, and seconds on the minute LEDs.  Minutes past 31 wrap around.
+ 
+Requires: u32Counts is in ACLK counts
+
+Promises: The hour, minute and PM LEDs show the whole minutes and seconds of u32Counts
+*/
+void Display_Duration(u32 u32Counts)
+{
+  u16 u16Seconds = (u16)(u32Counts >> COUNTS_PER_SECOND_SHIFT);
+  u8 u8Minutes = (u8)(u16Seconds / Seconds_Per_Minute);
+  
+  Display_Show(u8Minutes & 0x0F, (u8)(u16Seconds % Seconds_Per_Minute), (u8Minutes >> 4) & 0x01);
+  
+} /* end Display_Duration() */
+#endif
+
+/*------------------------------------------------------------------------------
+Function: Time_Set
+
+Description: Sets the clock from a 24 hour time, for the console.  Timer A is restarted like
+Time_Set_Latch so the second starts now.
+ 
+Requires: u8Hour < 24, u8Minute < 60, u8Second < 60
+
+Promises: The time is set and shown, and the next alarm is found again
+*/
+void Time_Set(u8 u8Hour, u8 u8Minute, u8 u8Second)
+{
+  TACTL = TIMERA_INITIALIZE;      //clears TAR so no tick comes before the second counter is set
+  Profile_Cancel();
+  GG_u8Second_Counter = u8Second * TICKS_PER_SECOND;
+#if CLOCK_24_HOUR
+  LG_u8Hour_Counter = u8Hour;
+#else
+  LG_u8PM = false;
+  if(u8Hour >= 12)
+  {
+    LG_u8PM = true;
+    u8Hour -= 12;
+  }
+  if(u8Hour == 0)
+  {
+    u8Hour = 12;                  //12:xx AM is just after midnight
+  }
+  LG_u8Hour_Counter = u8Hour;
+#endif
+  LG_u8Minute_Counter = u8Minute;
+  Telemetry_Log(EVENT_TIME_SET, 0);
+  
+  Display_Refresh();
+  Alarm_Select_Next(ALARM_KEY(LG_u8Hour_Counter, LG_u8Minute_Counter, LG_u8PM));
+  
+} /* end Time_Set() */
+
+/*------------------------------------------------------------------------------
+Function: Hour_24
+
+Description: The hour of the clock time in 24 hour form, for the console and the telemetry log
+ 
+Requires: 
+
+Promises: Returns 0 - 23
+*/
+u8 Hour_24()
+{
+#if CLOCK_24_HOUR
+  return LG_u8Hour_Counter;
+#else
+  u8 u8Hour = LG_u8Hour_Counter;
+  
+  if(u8Hour == 12)
+  {
+    u8Hour = 0;                   //12:xx AM is just after midnight
+  }
+  if(LG_u8PM)
+  {
+    u8Hour += 12;
+  }
+  return u8Hour;
+#endif
+  
+} /* end Hour_24() */
+
+/*------------------------------------------------------------------------------
+Function: Console_Reply
+
+Description: Queues the value a console command reads back, after its letter
+ 
+Requires: 
+  - u8Command is a command ClockSM_Console knows
+  - u16Index is the entry to read for the commands that read a table, it is checked by ClockSM_Console
+
+Promises: The value is queued in the same format the command takes it
+*/
+void Console_Reply(u8 u8Command, u16 u16Index)
+{
+#if CALENDAR_ENABLED
+  CalendarInformation* pCalendar;
+#endif
+#if TELEMETRY_ENABLED
+  u8 au8Burst[TELEMETRY_BURST];
+  u8 u8Count;
+  u8 u8Max;
+#endif
+#if PROFILE_ENABLED
+  ProfileInformation* pProfile;
+#endif
+  
+  Console_Put(' ');
+  switch(u8Command)
+  {
+    case 'T':
+      Console_Put_Number(Hour_24(), 2);
+      Console_Put(':');
+      Console_Put_Number(LG_u8Minute_Counter, 2);
+      Console_Put(':');
+      Console_Put_Number(GG_u8Second_Counter / TICKS_PER_SECOND, 2);
+      break;
+      
+#if CALENDAR_ENABLED
+    case 'D':
+      pCalendar = Calendar_Get();
+      Console_Put_Number(pCalendar->u8Century, 2);
+      Console_Put_Number(pCalendar->u8Year, 2);
+      Console_Put('-');
+      Console_Put_Number(pCalendar->u8Month, 2);
+      Console_Put('-');
+      Console_Put_Number(pCalendar->u8Day, 2);
+      break;
+#endif
+      
+    case 'C':
+      Console_Put_Number(GG_u16Tick_Count, 1);
+      Console_Put(' ');
+      Console_Put_Number(Console_Lost(), 1);
+      break;
+      
+    case 'K':
+      if(GG_s16Calibration < 0)
+      {
+        Console_Put('-');
+      }
+      Console_Put_Number(GG_s16Calibration < 0 ? -GG_s16Calibration : GG_s16Calibration, 1);
+      break;
+      
+#if TELEMETRY_ENABLED
+    case 'E':
+      //only take out of the log what the transmit ring has room for, as hex, with the line end
+      u8Max = Console_Room();
+      u8Max = (u8Max > 2) ? (u8Max - 2) / 2 : 0;
+      if(u8Max > TELEMETRY_BURST)
+      {
+        u8Max = TELEMETRY_BURST;
+      }
+      u8Count = Telemetry_Drain(au8Burst, u8Max);
+      for(u8 i = 0; i < u8Count; i++)
+      {
+        Console_Put_Hex(au8Burst[i]);
+      }
+      break;
+#endif
+      
+    case 'W':
+      Console_Put_Number(Stack_Used(), 1);
+      Console_Put(' ');
+      Console_Put_Number(Stack_Size(), 1);
+      break;
+      
+    case 'S':
+      Console_Put_Number(u16Index, 1);
+      Console_Put(' ');
+      Console_Put_Number(GG_au32Counter[u16Index], 1);
+      break;
+      
+#if PROFILE_ENABLED
+    case 'P':
+      pProfile = &GG_aProfile[u16Index];
+      Console_Put_Number(u16Index, 1);
+      Console_Put(' ');
+      Console_Put_Number(pProfile->u16Count ? pProfile->u16Min : 0, 1);
+      Console_Put(' ');
+      Console_Put_Number(pProfile->u16Max, 1);
+      Console_Put(' ');
+      Console_Put_Number(pProfile->u16Count ? (u16)(pProfile->u32Total / pProfile->u16Count) : 0, 1);
+      Console_Put(' ');
+      Console_Put_Number(pProfile->u16Count, 1);
+      break;
+#endif
+  }
+  
+} /* end Console_Reply() */
+
+#if !CAMPER_SUBMISSION
 void Update_Display()
 {
+  Profile_Begin(PROFILE_SITE_DISPLAY);
+#if CLOCK_24_HOUR
+  Display_Show(LG_u8Hour_Counter & 0x0F, LG_u8Minute_Counter, LG_u8Hour_Counter >> 4);   //the PM LED is the 16s bit of the hour
+#else
   u8 Port_Update_Value = 0;
 
   /*Port 1 LED driver  output port is x x x x m0 m1 m2 m3*/
@@ -294,14 +1457,13 @@ void Update_Display()
     Port_Update_Value |= (((LG_u8Minute_Counter<<i) & Port1_Update_Mask)>>(3-i));
   }
   
-  //port update value should now be 0b0000 m0 m1 m2 m3
-  P1OUT &= Port1_Clear_Mask;
-  P1OUT |= Port_Update_Value;
+  //port update value should now be 0b0000 m0 m1 m2 m3, each port is written once so an LED that stays the same does not blink
+  P1OUT = (P1OUT & Port1_Clear_Mask) | Port_Update_Value;
   
   /*Port 2 LED driver  output port is x x x m4 m5 h3 x x  done directly as a loop isn't worth it here*/
-  P2OUT &= Port2_Clear_Mask;                            // clears m4, m5 and h3
-  P2OUT |= (LG_u8Minute_Counter >> 2) & P2_3_MINUTE_5;    // shift m5 from bit 5 to bit 3, mask, drive
-  P2OUT |= LG_u8Minute_Counter & P2_4_MINUTE_4;         // whoo! m4 is already in the right spot, mask, drive
+  P2OUT = (P2OUT & (Port2_Clear_Mask | P2_2_HOUR_3))     // clears m4 and m5, h3 is the hours'
+          | ((LG_u8Minute_Counter >> 2) & P2_3_MINUTE_5)  // shift m5 from bit 5 to bit 3, mask, drive
+          | (LG_u8Minute_Counter & P2_4_MINUTE_4);        // whoo! m4 is already in the right spot, mask, drive
   if(CUSTOM_CODE_ENABLED)
   {
     Update_Display_Hours();
@@ -309,21 +1471,22 @@ void Update_Display()
   }
   else
   {
-    P2OUT |= (LG_u8Hour_Counter >> 1) & P2_2_HOUR_3;        //  shift h3 from bit 3 to bit 2, mask, drive
+    P2OUT = (P2OUT & ~P2_2_HOUR_3) | ((LG_u8Hour_Counter >> 1) & P2_2_HOUR_3);   //  shift h3 from bit 3 to bit 2, mask, drive
     /*Port 3 LED driver output port is x PM x x x h0 h1 h2 */
     Port_Update_Value = 0;  // zero our update value
     for(u8 i = 0; i < 3; i++)
     {
       Port_Update_Value |= (((LG_u8Hour_Counter<<(i)) & Port3_Update_Mask)>>(2-i));
     }
-    P3OUT &= Port3_Clear_Mask;
-    Port_Update_Value = 0;
     Port_Update_Value |= ((LG_u8PM<<5)&P3_5_POMI_PM_IND);  
   
     //port update value should now be 0 PM 000 h0 h1 h2
-    P3OUT |= Port_Update_Value;
+    P3OUT = (P3OUT & Port3_Clear_Mask) | Port_Update_Value;
   }
+#endif
+  Profile_End(PROFILE_SITE_DISPLAY);
 }
+#endif
 
 
 
@@ -340,8 +1503,11 @@ They will need to fill out the following functions:
 -void LedOn(LedInformation LedInfo)    turns on the LED with the specified LedInformation
 -void LedOff{LedInformation LedInfo)   turns off the LED with the specified LedInformation
 
+With CAMPER_SUBMISSION 1 they are left out here and in leds.c, for a camper's own to be linked in.
 ------------------------------------------------------------------------------*/
 
+#if !CAMPER_SUBMISSION
+#if !CLOCK_24_HOUR
 void Update_Display_AMPM()
 {
   if(PM == false)
@@ -356,98 +1522,20 @@ void Update_Display_AMPM()
 
 void Update_Display_Hours()
 {
-  if(hourCounter == 0)
-  {
-    LedOff(HOUR_LED_ZERO);
-    LedOff(HOUR_LED_ONE);
-    LedOff(HOUR_LED_TWO);
-    LedOff(HOUR_LED_THREE);
-  }
-  else if(hourCounter == 1)
+  //hour LED i shows bit i of the hour, one LED at a time so the loop is the same for all four
+  for(u8 i = 0; i < LEDS_FOR_HOURS; i++)
   {
-    LedOn(HOUR_LED_ZERO);
-    LedOff(HOUR_LED_ONE);
-    LedOff(HOUR_LED_TWO);
-    LedOff(HOUR_LED_THREE);
-  }
-  else if(hourCounter == 2)
-  {
-    LedOff(HOUR_LED_ZERO);
-    LedOn(HOUR_LED_ONE);
-    LedOff(HOUR_LED_TWO);
-    LedOff(HOUR_LED_THREE);
-  }
-  else if(hourCounter == 3)
-  {
-    LedOn(HOUR_LED_ZERO);
-    LedOn(HOUR_LED_ONE);
-    LedOff(HOUR_LED_TWO);
-    LedOff(HOUR_LED_THREE);
-  }
-  else if(hourCounter == 4)
-  {
-    LedOff(HOUR_LED_ZERO);
-    LedOff(HOUR_LED_ONE);
-    LedOn(HOUR_LED_TWO);
-    LedOff(HOUR_LED_THREE);
-  }
-  else if(hourCounter == 5)
-  {
-    LedOn(HOUR_LED_ZERO);
-    LedOff(HOUR_LED_ONE);
-    LedOn(HOUR_LED_TWO);
-    LedOff(HOUR_LED_THREE);
-  }
-  else if(hourCounter == 6)
-  {
-    LedOff(HOUR_LED_ZERO);
-    LedOn(HOUR_LED_ONE);
-    LedOn(HOUR_LED_TWO);
-    LedOff(HOUR_LED_THREE);
-  }
-  else if(hourCounter == 7)
-  {
-    LedOn(HOUR_LED_ZERO);
-    LedOn(HOUR_LED_ONE);
-    LedOn(HOUR_LED_TWO);
-    LedOff(HOUR_LED_THREE);
-  }
-  else if(hourCounter == 8)
-  {
-    LedOff(HOUR_LED_ZERO);
-    LedOff(HOUR_LED_ONE);
-    LedOff(HOUR_LED_TWO);
-    LedOn(HOUR_LED_THREE);
-  }
-  else if(hourCounter == 9)
-  {
-    LedOn(HOUR_LED_ZERO);
-    LedOff(HOUR_LED_ONE);
-    LedOff(HOUR_LED_TWO);
-    LedOn(HOUR_LED_THREE);
-  }
-  else if(hourCounter == 10)
-  {
-    LedOff(HOUR_LED_ZERO);
-    LedOn(HOUR_LED_ONE);
-    LedOff(HOUR_LED_TWO);
-    LedOn(HOUR_LED_THREE);
-  }
-  else if(hourCounter == 11)
-  {
-    LedOn(HOUR_LED_ZERO);
-    LedOn(HOUR_LED_ONE);
-    LedOff(HOUR_LED_TWO);
-    LedOn(HOUR_LED_THREE);
-  }
-  else if(hourCounter == 12)
-  {
-    LedOff(HOUR_LED_ZERO);
-    LedOff(HOUR_LED_ONE);
-    LedOn(HOUR_LED_TWO);
-    LedOn(HOUR_LED_THREE);
+    if(hourCounter & (1 << i))
+    {
+      LedOn(hourLeds[i]);
+    }
+    else
+    {
+      LedOff(hourLeds[i]);
+    }
   }
 } /* end Update_Display_Hours */
+#endif
 
 void Time_Rollover()
 {
@@ -455,6 +1543,7 @@ void Time_Rollover()
   {
     minuteCounter = minuteCounter - 60;
     hourCounter = hourCounter + 1;
+#if !CLOCK_24_HOUR
     if(hourCounter == 12)
     {
       if(PM == false)
@@ -466,10 +1555,19 @@ void Time_Rollover()
         PM = false;
       }
     }
+#endif
   }
   
+#if CLOCK_24_HOUR
+  if(hourCounter >= 24)
+  {
+    hourCounter = hourCounter - 24;
+  }
+#else
   if(hourCounter >= 13)
   {
     hourCounter = hourCounter - 12;
   }
+#endif
 } /* end Time_Rollover() */
+#endif /* !CAMPER_SUBMISSION */
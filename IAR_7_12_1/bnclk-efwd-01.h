@@ -22,10 +22,93 @@ Constants
 #define LEDS_FOR_HOURS (u8)4
 #define LEDS_FOR_MINUTES (u8)6
 #define CUSTOM_CODE_ENABLED 1
+#define CLOCK_24_HOUR 0           /* 1 builds the 24 hour variant: hours 0-23, the PM LED is the 16s bit of the hour
+                                     and all AM/PM code is left out */
+
+/* Features.  Flash of the image built by LLVM/Makefile (clang 14 -Os, lld --gc-sections) with each set, of the 4094
+bytes of the F2122 (tools/footprint.py, the vectors included):
+    the clock by itself 2422                     + NEXT_FRAME 2806
+    ALARMS + HOURLY_CHIME 3708, the defaults     + NEXT_FRAME 4088, 6 free    + PROFILE 4032
+    CALENDAR + HOURLY_CHIME 3918                 ALARMS + CALENDAR 4702       ALARMS + HOURLY_CHIME + TELEMETRY 4152
+    CONSOLE by itself 4728                       ALARMS + TIMERS 5348         all of them 10376
+CONSOLE and TIMERS do not fit the F2122 with anything else, they are for the 8KB F2132.  LLVM/Makefile, GCC/Makefile and
+the IAR post-build step run tools/footprint.py, which fails the build when the image does not fit.  Each can be set on
+the compiler's command line instead, the host build in tools/host turns them all on */
+#ifndef ALARMS_ENABLED
+#define ALARMS_ENABLED 1          /* two alarms set with button 0 held, rung with the buzzer, snoozed and dismissed */
+#endif
+#ifndef CALENDAR_ENABLED
+#define CALENDAR_ENABLED 0        /* the date, kept at midnight, shown and set after the alarms */
+#endif
+#ifndef TIMERS_ENABLED
+#define TIMERS_ENABLED 0          /* the stopwatch and the countdown after the date, the countdown rings like an alarm */
+#endif
+#ifndef HOURLY_CHIME_ENABLED
+#define HOURLY_CHIME_ENABLED 1    /* play GG_aMelodyChime at the top of every hour */
+#endif
+#ifndef CONSOLE_ENABLED
+#define CONSOLE_ENABLED 0         /* MODE_CONSOLE gives P3.4 and P3.5 to a 9600 baud UART console for setting the clock */
+#endif
+#ifndef TELEMETRY_ENABLED
+#define TELEMETRY_ENABLED 0       /* keep a log of power, button and time events in RAM, read with the console E command */
+#endif
+#ifndef PROFILE_ENABLED
+#define PROFILE_ENABLED 0         /* 1 builds the cycle profiler: min, max and average cycles of the state machine,
+                                     the Timer A and Port 2 ISRs and Update_Display, read with the console P command */
+#endif
+#ifndef NEXT_FRAME_ENABLED
+#define NEXT_FRAME_ENABLED 0      /* the LEDs of the next minute are worked out on the wake before it and TimerAISR shows
+                                     them on the tick the minute changes, a fixed few cycles after it, see Next_Frame_Prepare */
+#endif
+#define BUZZER_ENABLED (ALARMS_ENABLED || HOURLY_CHIME_ENABLED)   /* USCI_B0 tone and the melody player, for either */
+#if TIMERS_ENABLED && !ALARMS_ENABLED
+#error "TIMERS_ENABLED needs ALARMS_ENABLED, a countdown that runs out rings and is dismissed like an alarm"
+#endif
+#ifndef CAMPER_SUBMISSION
+#define CAMPER_SUBMISSION 0       /* 1 leaves out the campers' functions, Time_Rollover, Update_Display and the LedOn and
+                                     LedOff of leds.c, for tools/camper_grade.py to link a camper's own (camper.h) */
+#endif
 
 /* Timing constants */
 #define TIME_250MS          (u16)8191  /* Taccro for X = (0.25s * (32768Hz)) - 1; max = 65535
 This depends on a 32768Hz oscillator and usage of the divider*/
+#define TIMERA_PERIOD       (u16)8192  /* Timer A counts per tick, TIME_250MS + 1 */
+#define TIME_62MS           (u16)2048  /* TACCR1 step for the fast button sampling sub-ticks = 0.0625s * 32768Hz */
+
+#define TICKS_PER_SECOND    (u8)4      /* Timer A ticks per second, the TICK LED is on for the first one */
+#define TICK_PHASE_MASK     (u8)0x03   /* GG_u8Second_Counter & mask = tick number within the current second */
+#define BUTTON_FAST_TICKS   (u8)12     /* Ticks (3s) that buttons 1 and 2 are sampled every 62.5ms after any button activity */
+
+/* Auto-repeat constants, Timer1_A counts ACLK so these are (time * 32768Hz) - 1 */
+#define REPEAT_FIRST_DELAY  (u16)16383 /* 500ms from the press to the first repeat */
+#define REPEAT_SLOW         (u16)8191  /* 250ms between repeats */
+#define REPEAT_FAST         (u16)4095  /* 125ms between repeats once the minute steps by 15 */
+#define REPEAT_STEPS_OF_1   (u8)8      /* the press and the first 7 repeats step the minute by 1 */
+#define REPEAT_STEPS_OF_5   (u8)16     /* the next 8 repeats step by 5, after that by 15 */
+#define TIME_SET_SAMPLE     (u16)256   /* ~7.8ms between samples of a held minute button, bounds the release error */
+#define BUTTON_0_HOLD       (u16)49151 /* 1.5s, button 0 held this long moves on to setting the next alarm */
+
+/* Start of a new day, tested once a minute on the rollover */
+#if CLOCK_24_HOUR
+#define CLOCK_MIDNIGHT()  (LG_u8Minute_Counter == 0 && LG_u8Hour_Counter == 0)
+#else
+#define CLOCK_MIDNIGHT()  (LG_u8Minute_Counter == 0 && LG_u8Hour_Counter == 12 && LG_u8PM == false)
+#endif
+
+/* Display modes, in the order a hold of button 0 steps through them.  A feature that is not built has no modes */
+#define MODE_CLOCK            (u8)0    /* 1 to ALARM_COUNT is the alarm being set */
+#define MODE_DATE             (u8)(ALARM_COUNT + 1)   /* month and day */
+#define MODE_YEAR             (u8)(ALARM_COUNT + 2)   /* weekday and year */
+#define MODE_STOPWATCH        (u8)(MODE_DATE + 2 * CALENDAR_ENABLED)   /* minutes and seconds, button 1 start/stop, button 2 lap/reset */
+#define MODE_COUNTDOWN        (u8)(MODE_STOPWATCH + 1)   /* minutes and seconds, button 1 start/pause, button 2 add a minute/cancel */
+#define MODE_CONSOLE          (u8)(MODE_STOPWATCH + 2 * TIMERS_ENABLED)   /* the clock, with the TICK and PM LED pins used by the UART console */
+#define MODE_LAST             (u8)(MODE_CONSOLE - 1 + CONSOLE_ENABLED)
+#define MODE_IS_ALARM(mode)   ((mode) != MODE_CLOCK && (mode) < MODE_DATE)
+#define MODE_IS_DATE(mode)    (CALENDAR_ENABLED && ((mode) == MODE_DATE || (mode) == MODE_YEAR))
+#define MODE_IS_TIMER(mode)   (TIMERS_ENABLED && ((mode) == MODE_STOPWATCH || (mode) == MODE_COUNTDOWN))
+#define MODE_TIMES_OUT(mode)  ((mode) != MODE_CLOCK && (mode) < MODE_STOPWATCH)
+#define MODE_TIMEOUT_SECONDS  (u8)10   /* an alarm or the date goes back to the clock after this long without a press */
+#define YEAR_STEP_BIG         (u8)10   /* button 2 steps the year by a decade */
 
 
 /****************************************************************************************
@@ -118,20 +201,59 @@ typedef enum
 */
 
 
+#define TIMER1_REPEAT_START  0x0124
+/* Value for TA1CTL to start Timer1_A for the next auto-repeat:
+    <15-10> [000000] not used
+    <9-8> [01] ACLK Timer A clock source
+    <7-6> [00] Input divider /1
+    <5-4> [10] Continuous mode, TA1CCR0 times the repeat and TA1CCR1 samples for the minute button release
+    <3> [0] not used
+    <2> [1] Reset the timer module
+    <1> [0] No overflow interrupt, TA1CCR0 and TA1CCR1 interrupt instead
+    <0> [0] Clear the interrupt flag
+*/
+
+#define TIMER1_STOP  0x0100
+/* Value for TA1CTL to stop Timer1_A: ACLK source, stop mode */
+
+
 /************************ Function Declarations ****************************/
 void Clock_Initialize();  /*Starts the timer 500ms loop to run forever*/
-void Poll_Buttons();       /*Checks if buttons are pressed and makes ClockSM_Button_Press the next state if they are*/
+bool Poll_Buttons();       /*Checks for new button presses and makes ClockSM_Button_Press the next state if there is one*/
+u8 Buttons_Down();         /*Returns the pin masks of the buttons that are down*/
+void Button_New_Press(u8 u8New_Press);   /*Makes ClockSM_Button_Press the next state for a new press*/
+void Button_Fast_Start();  /*Starts (or extends) the fast 62.5ms sampling window for buttons 1 and 2*/
+bool Button_Fast_Sample(); /*Called from TimerAISR, returns TRUE if a new button press needs the main loop to wake*/
+bool Button_0_Pressed();   /*Called from Port2ISR on a button 0 edge, returns TRUE if the main loop needs to wake*/
+void Repeat_Next();        /*Arms Timer1_A for the next auto-repeat step of a held button*/
+void Time_Set_Latch();     /*Restarts TAR and the tick count when the minute button is released*/
+bool Button_Release_Sample();   /*Acts on the release of a held button, from Timer1A1ISR*/
+void Button_0_Tap();       /*Toggles AM/PM or the alarm being set*/
+void Alarm_Swap();         /*Exchanges the clock time and the alarm being set*/
+void Display_Refresh();    /*Shows the clock, the alarm being set or the date*/
+void Display_Show(u8 u8Hour, u8 u8Minute, u8 u8PM);   /*Shows any value in binary on the hour, minute and PM LEDs*/
+void Display_Frame(u8 u8Hour, u8 u8Minute, u8 u8PM, u8* au8Frame);   /*The LED bits of P1OUT, P2OUT and P3OUT for Display_Show*/
+void Next_Frame_Prepare();  /*The LEDs of the next minute for TimerAISR to show at the boundary*/
+void Date_Step(u8 u8Button);   /*Steps the date for a button press while the date is shown*/
+void Timer_Step(u8 u8Button);  /*Stopwatch and countdown controls for a button press*/
+void Display_Duration(u32 u32Counts);   /*Shows a stopwatch or countdown time as minutes and seconds*/
+void Time_Set(u8 u8Hour, u8 u8Minute, u8 u8Second);   /*Sets the time from a 24 hour time and restarts the second*/
+u8 Hour_24();              /*The hour of the clock time as 0 - 23*/
+void Console_Reply(u8 u8Command, u16 u16Index);   /*Queues the value a console command reads back*/
 void Time_Rollover();     /*adjusts the minute, hour and PM to stay in standard format e.g. 13:62PM -> 2:02AM*/
 void Update_Display();      /*Change the display LEDs (hours, Minutes and PM */
+#if !CLOCK_24_HOUR
 void Update_Display_Hours(); /*Change the display LEDS but just for hours */
 void Update_Display_AMPM();  /*Change the display LEDS but just for AMPM */
+#endif
 
 /****************************************************************************************
 State Machine Functions
 ****************************************************************************************/
 void ClockSM_Start();               /*Flash LED's displaying 12:00PM until button press occurs */
 void ClockSM_Tick();                /*Check the second counter, flash the Tick LED, Poll the buttons, sleep then branch accordingly */
-void ClockSM_Button_Press();        /*hour ++, Minute ++ or do nothing for Buttons 2-0 respectivly */
+void ClockSM_Button_Press();        /*hour ++, Minute ++ or AM/PM for Buttons 2-0 respectivly, auto-repeats buttons 2 and 1 */
 void ClockSM_LP_Sleep();            /*similar to Tick but only update the display once power is returned, ignor buttons*/
+void ClockSM_Console();             /*Runs the console command lines that have been received */
 
 #endif /* __BNCLK_HEADER */
@@ -0,0 +1,212 @@
+/**********************************************************************
+* Definitions for buzzer functions
+**********************************************************************/
+
+/************************ Revision History ****************************
+YYYY-MM-DD  Comments
+-------------------------------------------------------------------------------------------
+2026-10-19  File created
+
+************************************************************************/
+
+#include "io430.h"
+#include "typedef_MSP430.h"
+#include "buzzer.h"
+#include "bnclk-efwd-01.h"
+
+#if BUZZER_ENABLED
+
+/******************** Program Globals ************************/
+/* Global variable definitions intended for scope across multiple files */
+#if HOURLY_CHIME_ENABLED
+const NoteInformation GG_aMelodyChime[] = {{NOTE_E6, NOTE_QUARTER - NOTE_GAP},   //hourly chime
+                                           {NOTE_REST, NOTE_GAP},
+                                           {NOTE_C6, NOTE_QUARTER - NOTE_GAP},
+                                           {NOTE_REST, NOTE_GAP},
+                                           {NOTE_D6, NOTE_QUARTER - NOTE_GAP},
+                                           {NOTE_REST, NOTE_GAP},
+                                           {NOTE_G5, NOTE_HALF},
+                                           {NOTE_REST, NOTE_END}};
+#endif
+
+#if ALARMS_ENABLED
+const NoteInformation GG_aMelodyAlarm[] = {{BUZZER_TONE_ALARM, NOTE_SIXTEENTH},   //four beeps a second until dismissed
+                                           {NOTE_REST, NOTE_SIXTEENTH},
+                                           {BUZZER_TONE_ALARM, NOTE_SIXTEENTH},
+                                           {NOTE_REST, NOTE_SIXTEENTH},
+                                           {BUZZER_TONE_ALARM, NOTE_SIXTEENTH},
+                                           {NOTE_REST, NOTE_SIXTEENTH},
+                                           {BUZZER_TONE_ALARM, NOTE_SIXTEENTH},
+                                           {NOTE_REST, NOTE_SIXTEENTH + NOTE_HALF},
+                                           {NOTE_REPEAT, NOTE_END}};
+#endif
+
+
+/******************** Local Globals ************************/
+/* Global variable definitions intended only for the scope of this file */
+const NoteInformation* LG_pMelody_Start;           //first note of the melody playing
+const NoteInformation* LG_pMelody_Note;            //next note to play
+u16 LG_u16Melody_Wait = 0;                         //ACLK counts of the current note still to be scheduled on TACCR2
+u8 LG_u8Melody_Playing = false;                    //TACCR2 belongs to the melody, see Countdown_Tick for its other use
+
+/*------------------------------------------------------------------------------
+Function: Buzzer_On
+
+Description: Hands P3_3_BUZZER to USCI_B0 as UCB0CLK and starts the SPI clock from ACLK.
+USCITxISR refills UCB0TXBUF once every 8 clocks, the CPU leaves LPM3 for each refill but the main loop does not.
+ 
+Requires: USCI_B0 is not used for anything else
+
+Promises: A square wave of ACLK / u8Divider on P3_3_BUZZER until Buzzer_Off
+*/
+void Buzzer_On(u8 u8Divider)
+{
+  UCB0CTL1 = BUZZER_SPI_CTL1_OFF;
+  UCB0CTL0 = BUZZER_SPI_CTL0;
+  UCB0BR0 = u8Divider;
+  UCB0BR1 = 0;
+  P3SEL |= P3_3_BUZZER;
+  UCB0CTL1 = BUZZER_SPI_CTL1_ON;
+  IE2 |= UCB0TXIE;                //UCB0TXIFG is already set so USCITxISR starts the clock
+  
+} /* end Buzzer_On */
+
+/*------------------------------------------------------------------------------
+Function: Buzzer_Off
+
+Description: Puts USCI_B0 back in reset, which also clears UCB0TXIE, and returns P3_3_BUZZER to GPIO
+ 
+Requires: 
+
+Promises: P3_3_BUZZER is driven low
+*/
+void Buzzer_Off()
+{
+  UCB0CTL1 = BUZZER_SPI_CTL1_OFF;
+  P3SEL &= ~P3_3_BUZZER;
+  P3OUT &= ~P3_3_BUZZER;
+  
+} /* end Buzzer_Off */
+
+/*------------------------------------------------------------------------------
+Function: Melody_Play
+
+Description: Plays a note table in the background.  Each note is a tone from USCI_B0 (see Buzzer_On)
+and note boundaries are TACCR2 matches on the running Timer A.  The CPU runs at the start of each
+note and, while a note sounds, in USCITxISR for every byte of the tone (see buzzer.h), but the main
+loop only wakes for the melody when it ends.  TACCR2 is separate from the TAIFG tick so
+GG_u8Second_Counter and the minute rollover are not affected by a melody.
+ 
+Requires: 
+  - Timer A is running in up mode to TIME_250MS
+  - pMelody is ended by a NOTE_END duration
+
+Promises: The first note is playing, any melody that was playing is replaced
+*/
+void Melody_Play(const NoteInformation* pMelody)
+{
+  TACCTL2 = 0;
+  LG_u8Melody_Playing = true;
+  LG_pMelody_Start = pMelody;
+  LG_pMelody_Note = pMelody;
+  LG_u16Melody_Wait = 0;
+  TACCR2 = TAR;                   //MCLK and ACLK are the same clock so TAR can be read while running
+  Melody_Next();
+  if(LG_u8Melody_Playing)
+  {
+    TACCTL2 = CCIE;               //an empty table has already stopped
+  }
+  
+} /* end Melody_Play */
+
+/*------------------------------------------------------------------------------
+Function: Melody_Next
+
+Description: Starts the next note when the current one is over and moves TACCR2 on to the
+next boundary.  Timer A only counts to TACCR0 so a note longer than a lap takes one extra
+match per lap without moving TACCR2.  The lap is the current TACCR0 + 1, which Calibration_Tick
+makes a count longer or shorter for part of some minutes, so a boundary is never past the top of the count.
+ 
+Requires: TACCR2 is the time the current note ends
+
+Promises: TACCR2 is the next boundary and not above TACCR0, the buzzer is stopped at the end of the table
+*/
+void Melody_Next()
+{
+  u16 u16Next;
+  u16 u16Period = TACCR0 + 1;     //TIMERA_PERIOD, or a count more or less while Calibration_Tick trims
+  
+  if(LG_u16Melody_Wait == 0)
+  {
+    if(LG_pMelody_Note->u16Duration == NOTE_END)
+    {
+      if(LG_pMelody_Note->u8Divider != NOTE_REPEAT)
+      {
+        Melody_Stop();
+        return;
+      }
+      LG_pMelody_Note = LG_pMelody_Start;
+    }
+    
+    if(LG_pMelody_Note->u8Divider == NOTE_REST)
+    {
+      Buzzer_Off();
+    }
+    else
+    {
+      Buzzer_On(LG_pMelody_Note->u8Divider);
+    }
+    LG_u16Melody_Wait = LG_pMelody_Note->u16Duration;
+    LG_pMelody_Note++;
+  }
+  
+  if(LG_u16Melody_Wait >= u16Period)
+  {
+    LG_u16Melody_Wait -= u16Period;       //same TACCR2, one lap of Timer A later
+  }
+  else
+  {
+    u16Next = TACCR2 + LG_u16Melody_Wait;
+    if(u16Next >= u16Period)
+    {
+      u16Next -= u16Period;
+    }
+    TACCR2 = u16Next;
+    LG_u16Melody_Wait = 0;
+  }
+  
+} /* end Melody_Next */
+
+/*------------------------------------------------------------------------------
+Function: Melody_Stop
+
+Description: Stops the melody playing, if any
+ 
+Requires: 
+
+Promises: TACCR2 is off and the buzzer is off
+*/
+void Melody_Stop()
+{
+  TACCTL2 = 0;
+  LG_u8Melody_Playing = false;
+  Buzzer_Off();
+  
+} /* end Melody_Stop */
+
+/*------------------------------------------------------------------------------
+Function: Melody_Playing
+
+Description: Checks if a melody is playing
+ 
+Requires: 
+
+Promises: Returns TRUE from Melody_Play until the melody ends or Melody_Stop
+*/
+bool Melody_Playing()
+{
+  return LG_u8Melody_Playing;
+  
+} /* end Melody_Playing */
+
+#endif /* BUZZER_ENABLED */
@@ -0,0 +1,87 @@
+/**********************************************************************
+* Header file for buzzer functions
+**********************************************************************/
+
+/************************ Revision History ****************************
+YYYY-MM-DD  Comments
+-------------------------------------------------------------------------------------------
+2026-10-19  File created
+
+************************************************************************/
+
+#ifndef __BUZZER_HEADER
+#define __BUZZER_HEADER
+
+#include "typedef_MSP430.h"
+#include "bnclk-efwd-01.h"
+
+/******************************************************************************
+Type Definitions
+******************************************************************************/
+
+/* One step of a melody, tables of these are const so they stay in flash */
+typedef struct
+{
+  u8 u8Divider;        /* tone is ACLK / u8Divider, or NOTE_REST */
+  u16 u16Duration;     /* ACLK counts, 0 ends the table */
+}NoteInformation;
+
+/****************************************************************************************
+Constants
+****************************************************************************************/
+
+/* P3.3 has no timer output on the F2122 but it is UCB0CLK, so the tone is the USCI_B0 SPI clock.
+The tone is ACLK / divider and the USCI only needs a new byte every 8 clocks to keep it running.
+That byte is the one cost of the tone: the SPI clock stops without it, so the CPU leaves LPM3 for
+USCITxISR 32768 / (8 x divider) times a second while a note sounds, about 35 cycles each (an estimate,
+entry and reti included).  That is 256 wakes and about a quarter of the 32768Hz MCLK for the 2048Hz
+alarm tone and about 100 wakes and a tenth for NOTE_G5, so the tone is not a hardware one: the main
+loop stays in LPM3 but the CPU does not.  A higher tone costs more, 4096Hz would take half of MCLK */
+#define BUZZER_TONE_2KHZ     (u8)16    /* 2048Hz */
+#define BUZZER_TONE_ALARM    BUZZER_TONE_2KHZ   /* the alarm's beeps, no higher for the refill cost above */
+
+/* Note dividers, the nearest ACLK / divider to the musical note */
+#define NOTE_G5              (u8)42    /* 780Hz,  784Hz wanted */
+#define NOTE_C6              (u8)31    /* 1057Hz, 1047Hz wanted */
+#define NOTE_D6              (u8)28    /* 1170Hz, 1175Hz wanted */
+#define NOTE_E6              (u8)25    /* 1311Hz, 1319Hz wanted */
+#define NOTE_REST            (u8)0     /* buzzer off for the duration */
+#define NOTE_REPEAT          (u8)0xFF  /* with a 0 duration, plays the table again from the start */
+
+/* Note durations in ACLK counts */
+#define NOTE_GAP             (u16)655    /* 20ms so repeated notes are heard separately */
+#define NOTE_SIXTEENTH       (u16)2048   /* 62.5ms */
+#define NOTE_QUARTER         (u16)8192   /* 250ms */
+#define NOTE_HALF            (u16)16384  /* 500ms */
+#define NOTE_END             (u16)0
+
+#define BUZZER_SPI_CTL0      0x09
+/* Value for UCB0CTL0 to make UCB0CLK a free running clock:
+    <7> [0] Clock phase
+    <6> [0] Clock inactive low
+    <5> [0] LSB first
+    <4> [0] 8-bit data
+    <3> [1] Master mode
+    <2-1> [00] 3-pin SPI
+    <0> [1] Synchronous mode
+*/
+
+#define BUZZER_SPI_CTL1_OFF  0x41  /* UCB0CTL1: <7-6> [01] ACLK, <0> [1] USCI held in reset */
+#define BUZZER_SPI_CTL1_ON   0x40  /* UCB0CTL1: <7-6> [01] ACLK, <0> [0] USCI running */
+
+/************************ Function Declarations ****************************/
+
+#if BUZZER_ENABLED
+void Buzzer_On(u8 u8Divider);   /*Starts a tone of ACLK / u8Divider on P3_3_BUZZER*/
+void Buzzer_Off();              /*Stops the tone and drives P3_3_BUZZER low*/
+void Melody_Play(const NoteInformation* pMelody);   /*Starts playing a note table in the background*/
+void Melody_Next();             /*Called from TimerAISR on TACCR2 at each note boundary*/
+void Melody_Stop();             /*Stops the melody and the buzzer*/
+bool Melody_Playing();          /*Returns TRUE while a melody is playing*/
+#else
+#define Melody_Playing()     FALSE
+#define Melody_Next()
+#define Melody_Stop()
+#endif
+
+#endif /* __BUZZER_HEADER */
@@ -0,0 +1,264 @@
+/**********************************************************************
+* Definitions for calendar functions
+**********************************************************************/
+
+/************************ Revision History ****************************
+YYYY-MM-DD  Comments
+-------------------------------------------------------------------------------------------
+2026-10-19  File created
+
+************************************************************************/
+
+#include "io430.h"
+#include "typedef_MSP430.h"
+#include "calendar.h"
+#include "bnclk-efwd-01.h"
+
+#if CALENDAR_ENABLED
+
+/******************** Local Globals ************************/
+/* Global variable definitions intended only for the scope of this file */
+CalendarInformation LG_Calendar = {1, 1, 26, 20, 4, false};   //Thursday 1 January 2026
+
+const u8 LG_au8Days_In_Month[MONTHS_PER_YEAR] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+
+/* Sakamoto's month offsets for the day of the week */
+const u8 LG_au8Weekday_Offset[MONTHS_PER_YEAR] = {0, 3, 2, 5, 0, 3, 5, 1, 4, 6, 2, 4};
+
+/******************** Function Definitions ************************/
+
+/*------------------------------------------------------------------------------
+Function: Calendar_Get
+
+Description: Gives access to the date for the display
+ 
+Requires: 
+
+Promises: Returns a pointer to the date
+*/
+CalendarInformation* Calendar_Get()
+{
+  return &LG_Calendar;
+  
+} /* end Calendar_Get */
+
+/*------------------------------------------------------------------------------
+Function: Days_In_Month
+
+Description: Length of the current month, February from the stored leap year flag
+ 
+Requires: 
+
+Promises: Returns 28 - 31
+*/
+u8 Days_In_Month()
+{
+  if(LG_Calendar.u8Month == FEBRUARY && LG_Calendar.u8Leap_Year)
+  {
+    return 29;
+  }
+  return LG_au8Days_In_Month[LG_Calendar.u8Month - 1];
+  
+} /* end Days_In_Month */
+
+/*------------------------------------------------------------------------------
+Function: Leap_Year_Update
+
+Description: Works out if the current year is a leap year.  The year is kept as a year of the
+century and a century so the Gregorian rule needs only masks, there is no hardware divider.
+ 
+Requires: 
+
+Promises: u8Leap_Year is set for every 4th year, except centuries that are not a multiple of 400
+*/
+void Leap_Year_Update()
+{
+  if(LG_Calendar.u8Year == 0)
+  {
+    LG_Calendar.u8Leap_Year = (LG_Calendar.u8Century & 0x03) == 0;
+  }
+  else
+  {
+    LG_Calendar.u8Leap_Year = (LG_Calendar.u8Year & 0x03) == 0;
+  }
+  
+} /* end Leap_Year_Update */
+
+/*------------------------------------------------------------------------------
+Function: Weekday_Update
+
+Description: Works out the day of the week from scratch with Sakamoto's method.  This uses
+divisions so it is only used when the date is set, Calendar_Midnight just counts the weekday on.
+ 
+Requires: 
+
+Promises: u8Weekday matches the date
+*/
+void Weekday_Update()
+{
+  u16 u16Year = (u16)LG_Calendar.u8Century * YEARS_PER_CENTURY + LG_Calendar.u8Year;
+  u8 u8Weekday;
+  
+  if(LG_Calendar.u8Month <= FEBRUARY)
+  {
+    u16Year--;
+  }
+  u8Weekday = (u16Year + u16Year / 4 - u16Year / 100 + u16Year / 400 + 
+               LG_au8Weekday_Offset[LG_Calendar.u8Month - 1] + LG_Calendar.u8Day) % DAYS_PER_WEEK;
+  if(u8Weekday == 0)
+  {
+    u8Weekday = DAYS_PER_WEEK;    //Sakamoto counts from Sunday = 0
+  }
+  LG_Calendar.u8Weekday = u8Weekday;
+  
+} /* end Weekday_Update */
+
+/*------------------------------------------------------------------------------
+Function: Calendar_Midnight
+
+Description: Advances the date by one day at the midnight rollover.  Only counts and compares are
+used so the cost is bounded: the longest path is New Year's Eve of a century.
+ 
+Requires: Called once when the clock rolls over to 12:00AM
+
+Promises: The day, weekday, month, year and leap year flag are the next day's
+*/
+void Calendar_Midnight()
+{
+  LG_Calendar.u8Weekday++;
+  if(LG_Calendar.u8Weekday > DAYS_PER_WEEK)
+  {
+    LG_Calendar.u8Weekday = 1;
+  }
+  
+  LG_Calendar.u8Day++;
+  if(LG_Calendar.u8Day <= Days_In_Month())
+  {
+    return;
+  }
+  
+  LG_Calendar.u8Day = 1;
+  LG_Calendar.u8Month++;
+  if(LG_Calendar.u8Month <= MONTHS_PER_YEAR)
+  {
+    return;
+  }
+  
+  LG_Calendar.u8Month = 1;
+  LG_Calendar.u8Year++;
+  if(LG_Calendar.u8Year >= YEARS_PER_CENTURY)
+  {
+    LG_Calendar.u8Year = 0;
+    LG_Calendar.u8Century++;
+  }
+  Leap_Year_Update();
+  
+} /* end Calendar_Midnight */
+
+/*------------------------------------------------------------------------------
+Function: Calendar_Step_Day
+
+Description: Date setting, moves to the next day of the same month
+ 
+Requires: 
+
+Promises: The day wraps to the 1st after the end of the month, the weekday is recalculated
+*/
+void Calendar_Step_Day()
+{
+  LG_Calendar.u8Day++;
+  if(LG_Calendar.u8Day > Days_In_Month())
+  {
+    LG_Calendar.u8Day = 1;
+  }
+  Weekday_Update();
+  
+} /* end Calendar_Step_Day */
+
+/*------------------------------------------------------------------------------
+Function: Calendar_Step_Month
+
+Description: Date setting, moves to the next month of the same year
+ 
+Requires: 
+
+Promises: The month wraps to January after December, a day past the end of the new month
+is moved back to its last day, the weekday is recalculated
+*/
+void Calendar_Step_Month()
+{
+  LG_Calendar.u8Month++;
+  if(LG_Calendar.u8Month > MONTHS_PER_YEAR)
+  {
+    LG_Calendar.u8Month = 1;
+  }
+  if(LG_Calendar.u8Day > Days_In_Month())
+  {
+    LG_Calendar.u8Day = Days_In_Month();
+  }
+  Weekday_Update();
+  
+} /* end Calendar_Step_Month */
+
+/*------------------------------------------------------------------------------
+Function: Calendar_Step_Year
+
+Description: Date setting, moves the year forward within the same century
+ 
+Requires: u8Years < YEARS_PER_CENTURY
+
+Promises: The year wraps to 0 after 99, the 29th of February becomes the 28th in a
+common year, the leap year flag and weekday are recalculated
+*/
+void Calendar_Step_Year(u8 u8Years)
+{
+  LG_Calendar.u8Year += u8Years;
+  if(LG_Calendar.u8Year >= YEARS_PER_CENTURY)
+  {
+    LG_Calendar.u8Year -= YEARS_PER_CENTURY;
+  }
+  Leap_Year_Update();
+  if(LG_Calendar.u8Day > Days_In_Month())
+  {
+    LG_Calendar.u8Day = Days_In_Month();
+  }
+  Weekday_Update();
+  
+} /* end Calendar_Step_Year */
+
+/*------------------------------------------------------------------------------
+Function: Calendar_Set
+
+Description: Sets the whole date at once, for the console
+ 
+Requires: 
+
+Promises: Returns TRUE with the date set and the leap year flag and weekday recalculated,
+or FALSE with the date unchanged if there is no such day or the year is not CALENDAR_YEAR_FIRST
+to CALENDAR_YEAR_LAST.  Year 0 would take Weekday_Update's year below 0 in January and February
+*/
+bool Calendar_Set(u16 u16Year, u16 u16Month, u16 u16Day)
+{
+  CalendarInformation Old_Calendar = LG_Calendar;
+  
+  if(u16Year < CALENDAR_YEAR_FIRST || u16Year > CALENDAR_YEAR_LAST ||
+     u16Month == 0 || u16Month > MONTHS_PER_YEAR || u16Day == 0)
+  {
+    return FALSE;
+  }
+  LG_Calendar.u8Century = (u8)(u16Year / YEARS_PER_CENTURY);
+  LG_Calendar.u8Year = (u8)(u16Year % YEARS_PER_CENTURY);
+  LG_Calendar.u8Month = (u8)u16Month;
+  Leap_Year_Update();
+  if(u16Day > Days_In_Month())
+  {
+    LG_Calendar = Old_Calendar;
+    return FALSE;
+  }
+  LG_Calendar.u8Day = (u8)u16Day;
+  Weekday_Update();
+  return TRUE;
+  
+} /* end Calendar_Set */
+
+#endif /* CALENDAR_ENABLED */
@@ -0,0 +1,59 @@
+/**********************************************************************
+* Header file for calendar functions
+**********************************************************************/
+
+/************************ Revision History ****************************
+YYYY-MM-DD  Comments
+-------------------------------------------------------------------------------------------
+2026-10-19  File created
+
+************************************************************************/
+
+#ifndef __CALENDAR_HEADER
+#define __CALENDAR_HEADER
+
+#include "typedef_MSP430.h"
+#include "bnclk-efwd-01.h"
+
+/******************************************************************************
+Type Definitions
+******************************************************************************/
+
+typedef struct
+{
+  u8 u8Day;            /* 1 - 31 */
+  u8 u8Month;          /* 1 - 12 */
+  u8 u8Year;           /* 0 - 99, year of the century */
+  u8 u8Century;        /* 20 for 20xx */
+  u8 u8Weekday;        /* 1 Monday - 7 Sunday */
+  u8 u8Leap_Year;      /* true if u8Year has a 29th of February */
+}CalendarInformation;
+
+/****************************************************************************************
+Constants
+****************************************************************************************/
+
+#define MONTHS_PER_YEAR     (u8)12
+#define DAYS_PER_WEEK       (u8)7
+#define YEARS_PER_CENTURY   (u8)100
+#define FEBRUARY            (u8)2
+#define CALENDAR_YEAR_FIRST (u16)2000   /* Calendar_Set range, u8Century holds it and Weekday_Update's sums fit a u16 */
+#define CALENDAR_YEAR_LAST  (u16)2199
+
+/************************ Function Declarations ****************************/
+
+#if CALENDAR_ENABLED
+CalendarInformation* Calendar_Get();  /*The current date, read only, use the step or set functions to change it*/
+u8 Days_In_Month();                   /*Length of the current month*/
+void Leap_Year_Update();              /*Sets u8Leap_Year for the current year*/
+void Weekday_Update();                /*Recalculates u8Weekday after the date is set*/
+void Calendar_Midnight();             /*Advances the date by one day*/
+void Calendar_Step_Day();             /*Date setting: next day, wraps within the month*/
+void Calendar_Step_Month();           /*Date setting: next month, wraps within the year*/
+void Calendar_Step_Year(u8 u8Years);  /*Date setting: forward u8Years, wraps within the century*/
+bool Calendar_Set(u16 u16Year, u16 u16Month, u16 u16Day);   /*Sets the whole date, FALSE if it is not a real date in range*/
+#else
+#define Calendar_Midnight()
+#endif
+
+#endif /* __CALENDAR_HEADER */
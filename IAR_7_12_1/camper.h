@@ -0,0 +1,61 @@
+/**********************************************************************
+* Header file for the code the campers write
+
+The simpler names the campers use for the time and the LEDs, for bnclk-efwd-01.c and for a
+camper's Time_Rollover, Update_Display, LedOn and LedOff in a file of their own.  A file that
+includes this is all a submission needs to be graded by tools/camper_grade.py, which links it
+with the firmware built with CAMPER_SUBMISSION 1.
+**********************************************************************/
+
+/************************ Revision History ****************************
+YYYY-MM-DD  Comments
+-------------------------------------------------------------------------------------------
+2026-10-19  File created, the names moved here from bnclk-efwd-01.c
+
+************************************************************************/
+
+#ifndef __CAMPER_HEADER
+#define __CAMPER_HEADER
+
+#include "io430.h"
+#include "typedef_MSP430.h"
+#include "bnclk-efwd-01.h"
+#include "leds.h"
+
+/******************** External Globals ************************/
+extern u8 LG_u8Minute_Counter;                     /* From bnclk-efwd-01.c */
+extern u8 LG_u8Hour_Counter;                       /* From bnclk-efwd-01.c */
+extern LedInformation LG_aLedInfoHourLeds[];       /* From bnclk-efwd-01.c */
+extern LedInformation LG_aLedInfoMinuteLeds[];     /* From bnclk-efwd-01.c */
+#if !CLOCK_24_HOUR
+extern u8 LG_u8PM;                                 /* From bnclk-efwd-01.c */
+extern LedInformation LG_LedInfoPMLed;             /* From bnclk-efwd-01.c */
+#endif
+
+/****************************************************************************************
+Constants
+****************************************************************************************/
+
+//This is so that the campers will have a simpler names to use
+#define hourCounter LG_u8Hour_Counter
+#define hourLeds LG_aLedInfoHourLeds
+#define HOUR_LED_ZERO hourLeds[0]
+#define HOUR_LED_ONE hourLeds[1]
+#define HOUR_LED_TWO hourLeds[2]
+#define HOUR_LED_THREE hourLeds[3]
+
+#define minuteCounter LG_u8Minute_Counter
+#define minuteLeds LG_aLedInfoMinuteLeds
+#define MINUTE_LED_ZERO minuteLeds[0]
+#define MINUTE_LED_ONE minuteLeds[1]
+#define MINUTE_LED_TWO minuteLeds[2]
+#define MINUTE_LED_THREE minuteLeds[3]
+#define MINUTE_LED_FOUR minuteLeds[4]
+#define MINUTE_LED_FIVE minuteLeds[5]
+
+#if !CLOCK_24_HOUR
+#define PM_LED LG_LedInfoPMLed
+#define PM LG_u8PM
+#endif
+
+#endif /* __CAMPER_HEADER */
@@ -0,0 +1,430 @@
+/**********************************************************************
+* Definitions for the UART console functions
+**********************************************************************/
+
+/************************ Revision History ****************************
+YYYY-MM-DD  Comments
+-------------------------------------------------------------------------------------------
+2026-10-19  File created
+
+************************************************************************/
+
+#include "io430.h"
+#include "typedef_MSP430.h"
+#include "console.h"
+#include "bnclk-efwd-01.h"
+
+/******************** External Globals ************************/
+/* Globally available variables from other files as indicated */
+extern fnCode_type GG_fpCLOCKSM;                   /* From bnclk-efwd-01.c */
+extern int GG_u8Second_Counter;                    /* From bnclk-efwd-01.c */
+
+/******************** Program Globals ************************/
+/* Global variable definitions intended for scope across multiple files */
+s16 GG_s16Calibration = 0;                         //ACLK counts per minute the crystal runs fast, set with the K command
+
+/******************** Local Globals ************************/
+/* Global variable definitions intended only for the scope of this file */
+u8 LG_au8Console_Rx[CONSOLE_RX_SIZE];              //received bytes, written by USCIRxISR
+volatile u8 LG_u8Console_Rx_Head = 0;              //next byte USCIRxISR writes
+u8 LG_u8Console_Rx_Tail = 0;                       //next byte Console_Read_Line reads
+volatile u8 LG_u8Console_Lines_In = 0;             //line ends received, only USCIRxISR changes it
+u8 LG_u8Console_Rx_Line = 0;                       //where the line USCIRxISR is receiving starts
+u8 LG_u8Console_Rx_Discard = false;                //a line too long for the ring is being dropped up to its line end
+u8 LG_u8Console_Lines_Out = 0;                     //line ends read, only Console_Read_Line changes it
+u8 LG_au8Console_Tx[CONSOLE_TX_SIZE];              //bytes waiting to be sent
+u8 LG_u8Console_Tx_Head = 0;                       //next byte Console_Put writes
+volatile u8 LG_u8Console_Tx_Tail = 0;              //next byte USCITxISR sends
+volatile u16 LG_u16Console_Lost = 0;               //bytes dropped because a ring was full
+u8 LG_u8Trim_Ticks = 0;                            //ticks left with TACCR0 trimmed this minute
+
+/******************** Function Definitions ************************/
+
+/*------------------------------------------------------------------------------
+Function: Console_On
+
+Description: Hands P3.4 and P3.5 to USCI_A0 and starts the UART from ACLK.  ACLK keeps running in
+LPM3 so a start bit is received with the processor asleep and USCIRxISR wakes it only for a whole line.
+The TICK and PM LEDs are dark while the console is on.
+ 
+Requires: Nothing drives P3.5 until this is called, it is the PM LED output until then
+
+Promises: Bytes are received into the ring, nothing is sent until Console_Put
+*/
+void Console_On()
+{
+  UCA0CTL1 = CONSOLE_CTL1_OFF;
+  UCA0CTL0 = 0;                   //8N1 UART, LSB first
+  UCA0BR0 = CONSOLE_BR0;
+  UCA0BR1 = 0;
+  UCA0MCTL = CONSOLE_MCTL;
+  P3DIR &= ~P3_5_POMI_PM_IND;
+  P3SEL |= CONSOLE_PINS;
+  UCA0CTL1 = CONSOLE_CTL1_ON;
+  IE2 |= UCA0RXIE;
+  
+} /* end Console_On */
+
+/*------------------------------------------------------------------------------
+Function: Console_Off
+
+Description: Puts USCI_A0 back in reset, which also clears UCA0RXIE and UCA0TXIE, and returns the pins to the LEDs
+ 
+Requires: 
+
+Promises: Anything not yet sent or read is dropped
+*/
+void Console_Off()
+{
+  UCA0CTL1 = CONSOLE_CTL1_OFF;
+  P3SEL &= ~CONSOLE_PINS;
+  P3DIR |= P3_5_POMI_PM_IND;
+  LG_u8Console_Rx_Tail = LG_u8Console_Rx_Head;
+  LG_u8Console_Rx_Line = LG_u8Console_Rx_Head;
+  LG_u8Console_Rx_Discard = false;
+  LG_u8Console_Lines_Out = LG_u8Console_Lines_In;
+  LG_u8Console_Tx_Head = LG_u8Console_Tx_Tail;
+  
+} /* end Console_Off */
+
+/*------------------------------------------------------------------------------
+Function: Console_Rx
+
+Description: Stores a received byte.  A carriage return or line feed ends a command line, which
+ClockSM_Console handles the next time the main loop is awake.  A line that does not fit in the ring
+(noise, a paste, the wrong baud rate) is dropped whole, up to and including its line end, so the
+lines before it are still answered and the next one is received again.
+ 
+Requires: Only called from interrupt context
+
+Promises: 
+  - The byte is stored, or the line it is part of is dropped and its bytes counted as lost
+  - Returns TRUE and makes ClockSM_Console the next state for a line end, unless the main loop
+    is handling a button or power is lost.  ClockSM_Tick picks the line up after a button
+*/
+bool Console_Rx(u8 u8Byte)
+{
+  u8 u8Next = (LG_u8Console_Rx_Head + 1) & CONSOLE_RX_MASK;
+  bool bLine_End = (u8Byte == '\r' || u8Byte == '\n');
+  
+  if(LG_u8Console_Rx_Discard)
+  {
+    LG_u8Console_Rx_Discard = !bLine_End;
+    LG_u16Console_Lost++;
+    return FALSE;
+  }
+  if(u8Next == LG_u8Console_Rx_Tail)
+  {
+    /*Take the partial line back out, the whole lines before it stay*/
+    LG_u16Console_Lost += ((LG_u8Console_Rx_Head - LG_u8Console_Rx_Line) & CONSOLE_RX_MASK) + 1;
+    LG_u8Console_Rx_Head = LG_u8Console_Rx_Line;
+    LG_u8Console_Rx_Discard = !bLine_End;
+    return FALSE;
+  }
+  LG_au8Console_Rx[LG_u8Console_Rx_Head] = u8Byte;
+  LG_u8Console_Rx_Head = u8Next;
+  
+  if(bLine_End)
+  {
+    LG_u8Console_Rx_Line = u8Next;
+    LG_u8Console_Lines_In++;
+    if(GG_fpCLOCKSM == ClockSM_Tick)
+    {
+      GG_fpCLOCKSM = ClockSM_Console;
+      return TRUE;
+    }
+  }
+  return FALSE;
+  
+} /* end Console_Rx */
+
+/*------------------------------------------------------------------------------
+Function: Console_Tx_Next
+
+Description: Sends the next queued byte
+ 
+Requires: Only called from interrupt context with UCA0TXIFG set
+
+Promises: UCA0TXIE is cleared once the ring is empty so the ISR stops until Console_Put
+*/
+void Console_Tx_Next()
+{
+  if(LG_u8Console_Tx_Tail == LG_u8Console_Tx_Head)
+  {
+    IE2 &= ~UCA0TXIE;
+    return;
+  }
+  UCA0TXBUF = LG_au8Console_Tx[LG_u8Console_Tx_Tail];
+  LG_u8Console_Tx_Tail = (LG_u8Console_Tx_Tail + 1) & CONSOLE_TX_MASK;
+  
+} /* end Console_Tx_Next */
+
+/*------------------------------------------------------------------------------
+Function: Console_Read_Line
+
+Description: Takes the next command line out of the receive ring.  Empty lines, such as the
+line feed of a CR LF pair, are skipped.
+ 
+Requires: pu8Line has room for CONSOLE_LINE_SIZE bytes
+
+Promises: Returns TRUE with the line in pu8Line ending in a 0, without the line end.  Characters
+past CONSOLE_LINE_SIZE - 1 are dropped.  Returns FALSE when no whole line is waiting
+*/
+bool Console_Read_Line(u8* pu8Line)
+{
+  u8 u8Byte;
+  u8 u8Length;
+  
+  while(LG_u8Console_Lines_Out != LG_u8Console_Lines_In)
+  {
+    u8Length = 0;
+    do
+    {
+      u8Byte = LG_au8Console_Rx[LG_u8Console_Rx_Tail];
+      LG_u8Console_Rx_Tail = (LG_u8Console_Rx_Tail + 1) & CONSOLE_RX_MASK;
+      if(u8Length < CONSOLE_LINE_SIZE - 1 && u8Byte != '\r' && u8Byte != '\n')
+      {
+        pu8Line[u8Length++] = u8Byte;
+      }
+    } while(u8Byte != '\r' && u8Byte != '\n');
+    LG_u8Console_Lines_Out++;
+    
+    if(u8Length != 0)
+    {
+      pu8Line[u8Length] = 0;
+      return TRUE;
+    }
+  }
+  return FALSE;
+  
+} /* end Console_Read_Line */
+
+/*------------------------------------------------------------------------------
+Function: Console_Pending
+
+Description: Checks for received command lines that have not been read yet
+ 
+Requires: 
+
+Promises: Returns TRUE if ClockSM_Console has lines to handle
+*/
+bool Console_Pending()
+{
+  return (bool)(LG_u8Console_Lines_Out != LG_u8Console_Lines_In);
+  
+} /* end Console_Pending */
+
+/*------------------------------------------------------------------------------
+Function: Console_Numbers
+
+Description: Reads the numbers in a command line, anything that is not a digit separates them
+so "12:05:30" and "2026-10-19" are both three numbers.  A '-' right before a number makes it negative
+unless it follows a digit, where it is a separator.
+ 
+Requires: pu8Text ends in a 0, pu16Value has room for CONSOLE_VALUES_MAX values
+
+Promises: Returns how many numbers were read, a negative number is stored as its 16 bit two's complement.
+A line with more than CONSOLE_VALUES_MAX numbers returns CONSOLE_VALUES_MAX + 1 so it can be rejected
+*/
+u8 Console_Numbers(u8* pu8Text, u16* pu16Value)
+{
+  u8 u8Count = 0;
+  u8 u8Negative = false;
+  u8 u8Digit_Before = false;
+  u16 u16Value;
+  
+  while(*pu8Text)
+  {
+    if(*pu8Text < '0' || *pu8Text > '9')
+    {
+      u8Negative = (*pu8Text == '-' && !u8Digit_Before);
+      u8Digit_Before = false;
+      pu8Text++;
+      continue;
+    }
+    if(u8Count == CONSOLE_VALUES_MAX)
+    {
+      return CONSOLE_VALUES_MAX + 1;
+    }
+    u16Value = 0;
+    while(*pu8Text >= '0' && *pu8Text <= '9')
+    {
+      u16Value = (u16Value << 3) + (u16Value << 1) + (*pu8Text - '0');   //no hardware multiplier
+      pu8Text++;
+    }
+    if(u8Negative)
+    {
+      u16Value = -u16Value;
+    }
+    pu16Value[u8Count++] = u16Value;
+    u8Digit_Before = true;
+  }
+  return u8Count;
+  
+} /* end Console_Numbers */
+
+/*------------------------------------------------------------------------------
+Function: Console_Put
+
+Description: Queues a byte for USCITxISR to send.  Nothing waits for the UART, a full ring drops the byte.
+ 
+Requires: Console_On has been called
+
+Promises: The byte is sent in order after the ones before it, or counted as lost
+*/
+void Console_Put(u8 u8Byte)
+{
+  u8 u8Next = (LG_u8Console_Tx_Head + 1) & CONSOLE_TX_MASK;
+  
+  if(u8Next == LG_u8Console_Tx_Tail)
+  {
+    LG_u16Console_Lost++;
+    return;
+  }
+  LG_au8Console_Tx[LG_u8Console_Tx_Head] = u8Byte;
+  LG_u8Console_Tx_Head = u8Next;
+  IE2 |= UCA0TXIE;                //UCA0TXIFG is set while the UART is idle so this starts sending
+  
+} /* end Console_Put */
+
+/*------------------------------------------------------------------------------
+Function: Console_Put_String
+
+Description: Queues a string for USCITxISR to send
+ 
+Requires: pcText ends in a 0
+
+Promises: See Console_Put
+*/
+void Console_Put_String(const char* pcText)
+{
+  while(*pcText)
+  {
+    Console_Put(*pcText++);
+  }
+  
+} /* end Console_Put_String */
+
+/*------------------------------------------------------------------------------
+Function: Console_Put_Number
+
+Description: Queues a number in decimal with leading zeros up to u8Digits
+ 
+Requires: u8Digits <= 5
+
+Promises: See Console_Put
+*/
+void Console_Put_Number(u32 u32Value, u8 u8Digits)
+{
+  u8 au8Digit[10];
+  u8 u8Count = 0;
+  
+  do
+  {
+    au8Digit[u8Count++] = '0' + u32Value % 10;
+    u32Value /= 10;
+  } while(u32Value != 0);
+  
+  while(u8Digits > u8Count)
+  {
+    Console_Put('0');
+    u8Digits--;
+  }
+  while(u8Count)
+  {
+    Console_Put(au8Digit[--u8Count]);
+  }
+  
+} /* end Console_Put_Number */
+
+/*------------------------------------------------------------------------------
+Function: Console_Put_Hex
+
+Description: Queues a byte as two hex digits
+ 
+Requires: 
+
+Promises: See Console_Put
+*/
+void Console_Put_Hex(u8 u8Byte)
+{
+  u8 u8Digit;
+  
+  u8Digit = u8Byte >> 4;
+  Console_Put(u8Digit < 10 ? '0' + u8Digit : 'A' - 10 + u8Digit);
+  u8Digit = u8Byte & 0x0F;
+  Console_Put(u8Digit < 10 ? '0' + u8Digit : 'A' - 10 + u8Digit);
+  
+} /* end Console_Put_Hex */
+
+/*------------------------------------------------------------------------------
+Function: Console_Room
+
+Description: Space left in the transmit ring
+ 
+Requires: 
+
+Promises: Returns how many bytes Console_Put can queue now without dropping any
+*/
+u8 Console_Room()
+{
+  return (LG_u8Console_Tx_Tail - LG_u8Console_Tx_Head - 1) & CONSOLE_TX_MASK;
+  
+} /* end Console_Room */
+
+/*------------------------------------------------------------------------------
+Function: Console_Lost
+
+Description: Bytes dropped because the receive or transmit ring was full
+ 
+Requires: 
+
+Promises: Returns the count, it wraps at 65535
+*/
+u16 Console_Lost()
+{
+  return LG_u16Console_Lost;
+  
+} /* end Console_Lost */
+
+/*------------------------------------------------------------------------------
+Function: Calibration_Tick
+
+Description: Digital trim of the crystal.  At the start of each minute TACCR0 is made one count longer
+(or shorter) for |GG_s16Calibration| ticks, so the clock loses (or gains) that many ACLK counts per minute.
+One count per minute is about 0.5ppm.
+ 
+Requires: Only called from interrupt context, right after GG_u8Second_Counter is incremented
+
+Promises: 
+  - TACCR0 is back to TIME_250MS after the trimmed ticks, well within the minute
+  - TACCR2 is not above a shortened TACCR0, where it would never match
+*/
+void Calibration_Tick()
+{
+  if(LG_u8Trim_Ticks)
+  {
+    if(--LG_u8Trim_Ticks == 0)
+    {
+      TACCR0 = TIME_250MS;
+    }
+  }
+  else if(GG_u8Second_Counter == 240 && GG_s16Calibration != 0)
+  {
+    if(GG_s16Calibration > 0)
+    {
+      TACCR0 = TIME_250MS + 1;
+      LG_u8Trim_Ticks = (u8)GG_s16Calibration;
+    }
+    else
+    {
+      TACCR0 = TIME_250MS - 1;
+      LG_u8Trim_Ticks = (u8)-GG_s16Calibration;
+      if(TACCR2 > TACCR0)
+      {
+        TACCR2 = TACCR0;          //a note boundary or countdown end on the count just cut off, one count early
+      }
+    }
+  }
+  
+} /* end Calibration_Tick */
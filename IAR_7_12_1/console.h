@@ -0,0 +1,56 @@
+/**********************************************************************
+* Header file for the UART console functions
+**********************************************************************/
+
+/************************ Revision History ****************************
+YYYY-MM-DD  Comments
+-------------------------------------------------------------------------------------------
+2026-10-19  File created
+
+************************************************************************/
+
+#ifndef __CONSOLE_HEADER
+#define __CONSOLE_HEADER
+
+#include "typedef_MSP430.h"
+
+/****************************************************************************************
+Constants
+****************************************************************************************/
+
+/* USCI_A0 UART, 9600 baud 8N1 from the 32768Hz ACLK so it keeps running in LPM3.
+UCA0TXD and UCA0RXD are P3.4 and P3.5, the PIMO/POMI pins shared with the TICK and PM LEDs */
+#define CONSOLE_PINS         (u8)(P3_4_PIMO_TICK | P3_5_POMI_PM_IND)
+#define CONSOLE_CTL1_OFF     (u8)0x41  /* UCA0CTL1: <7-6> [01] ACLK, <0> [1] USCI held in reset */
+#define CONSOLE_CTL1_ON      (u8)0x40  /* UCA0CTL1: <7-6> [01] ACLK, <0> [0] USCI running */
+#define CONSOLE_BR0          (u8)3     /* 32768Hz / 9600 = 3.41 */
+#define CONSOLE_MCTL         (u8)0x06  /* UCA0MCTL: <3-1> [011] UCBRSx = round(0.41 * 8), <0> [0] no oversampling */
+
+/* Ring sizes are powers of 2 so the indexes wrap with a mask */
+#define CONSOLE_RX_SIZE      (u8)16
+#define CONSOLE_RX_MASK      (u8)(CONSOLE_RX_SIZE - 1)
+#define CONSOLE_TX_SIZE      (u8)32
+#define CONSOLE_TX_MASK      (u8)(CONSOLE_TX_SIZE - 1)
+#define CONSOLE_LINE_SIZE    (u8)16    /* longest command line kept, the rest of a longer line is dropped */
+#define CONSOLE_VALUES_MAX   (u8)3     /* numbers read from one command line */
+
+#define CALIBRATION_MAX      (s16)127  /* ACLK counts per minute, about 65ppm */
+
+/************************ Function Declarations ****************************/
+
+void Console_On();                 /*Gives P3.4 and P3.5 to the UART and starts receiving*/
+void Console_Off();                /*Gives P3.4 and P3.5 back to the TICK and PM LEDs*/
+bool Console_Rx(u8 u8Byte);        /*Called from USCIRxISR, returns TRUE if a command line needs the main loop to wake*/
+void Console_Tx_Next();            /*Called from USCITxISR when the UART can take the next byte*/
+bool Console_Pending();            /*TRUE if a command line is waiting for ClockSM_Console*/
+bool Console_Read_Line(u8* pu8Line);   /*Copies the next received command line, FALSE if there is none*/
+u8 Console_Numbers(u8* pu8Text, u16* pu16Value);   /*Reads up to CONSOLE_VALUES_MAX numbers from a command line*/
+void Console_Put(u8 u8Byte);       /*Queues a byte to send, dropped if the transmit ring is full*/
+void Console_Put_String(const char* pcText);   /*Queues a string to send*/
+void Console_Put_Number(u32 u32Value, u8 u8Digits);   /*Queues a number in decimal, at least u8Digits long*/
+void Console_Put_Hex(u8 u8Byte);   /*Queues a byte as two hex digits*/
+u8 Console_Room();                 /*Bytes that can be queued without dropping any*/
+u16 Console_Lost();                /*Bytes dropped because a ring was full*/
+void Calibration_Tick();           /*Called from TimerAISR every tick, trims the clock once a minute*/
+
+#endif /* __CONSOLE_HEADER */
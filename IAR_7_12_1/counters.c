@@ -0,0 +1,70 @@
+/**********************************************************************
+* Definitions for the operational counters
+
+The counters tell from a unit in the field whether it has been on battery, had its buttons
+bouncing or pressed constantly, or been reset.  Each is one increment in code that already runs,
+and they are read with the console S command or a debugger (GG_au32Counter).
+**********************************************************************/
+
+/************************ Revision History ****************************
+YYYY-MM-DD  Comments
+-------------------------------------------------------------------------------------------
+2026-10-19  File created
+
+************************************************************************/
+
+#include "io430.h"
+#include "typedef_MSP430.h"
+#include "counters.h"
+
+/******************** Program Globals ************************/
+/* Global variable definitions intended for scope across multiple files.
+The counters are not cleared by cstartup so they carry on through a warm reset */
+__no_init u32 GG_au32Counter[COUNTERS];            //see counters.h for each one
+
+/******************** Local Globals ************************/
+/* Global variable definitions intended only for the scope of this file */
+__no_init u16 LG_u16Counters_Magic;                //COUNTERS_MAGIC once the counters have been cleared
+
+/******************** Function Definitions ************************/
+
+/*------------------------------------------------------------------------------
+Function: Counters_Initialize
+
+Description: Clears the counters after power up, or keeps them after a warm reset, and counts the reset
+ 
+Requires: 
+  - Called once from main before interrupts are enabled
+  - u8Reset_Cause is the IFG1 reset flags, read before anything clears them
+
+Promises: One reset counter goes up for each flag in u8Reset_Cause
+*/
+void Counters_Initialize(u8 u8Reset_Cause)
+{
+  if(LG_u16Counters_Magic != COUNTERS_MAGIC)
+  {
+    for(u8 i = 0; i < COUNTERS; i++)
+    {
+      GG_au32Counter[i] = 0;
+    }
+    LG_u16Counters_Magic = COUNTERS_MAGIC;
+  }
+  
+  if(u8Reset_Cause & WDTIFG)
+  {
+    COUNT(COUNTER_RESET_WDT);
+  }
+  if(u8Reset_Cause & PORIFG)
+  {
+    COUNT(COUNTER_RESET_POR);
+  }
+  if(u8Reset_Cause & RSTIFG)
+  {
+    COUNT(COUNTER_RESET_PIN);
+  }
+  if(u8Reset_Cause & NMIIFG)
+  {
+    COUNT(COUNTER_RESET_NMI);
+  }
+  
+} /* end Counters_Initialize */
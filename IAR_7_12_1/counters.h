@@ -0,0 +1,44 @@
+/**********************************************************************
+* Header file for the operational counters
+**********************************************************************/
+
+/************************ Revision History ****************************
+YYYY-MM-DD  Comments
+-------------------------------------------------------------------------------------------
+2026-10-19  File created
+
+************************************************************************/
+
+#ifndef __COUNTERS_HEADER
+#define __COUNTERS_HEADER
+
+#include "typedef_MSP430.h"
+
+/****************************************************************************************
+Constants
+****************************************************************************************/
+
+/* Counters, index into GG_au32Counter */
+#define COUNTER_WAKES          (u8)0     /* main loop dispatches of GG_fpCLOCKSM */
+#define COUNTER_WORK_WAKES     (u8)1     /* wakes that handled a button, a console line or a minute rollover */
+#define COUNTER_MINUTES        (u8)2     /* minute rollovers, on mains and on battery */
+#define COUNTER_BUTTONS        (u8)3     /* new presses of any button */
+#define COUNTER_POWER_LOSSES   (u8)4     /* falling edges of LOST_POWER_IND */
+#define COUNTER_BATTERY_TICKS  (u8)5     /* 250ms ticks spent in ClockSM_LP_Sleep */
+#define COUNTER_RESET_WDT      (u8)6     /* resets by cause, from the IFG1 flags at start up */
+#define COUNTER_RESET_POR      (u8)7
+#define COUNTER_RESET_PIN      (u8)8
+#define COUNTER_RESET_NMI      (u8)9
+#define COUNTERS               (u8)10
+
+#define RESET_CAUSE_FLAGS      (u8)(WDTIFG | PORIFG | RSTIFG | NMIIFG)   /* IFG1 flags that say why the last reset was */
+#define COUNTERS_MAGIC         (u16)0xC0B7   /* marks the no init counters as valid after a reset */
+
+/* One increment, safe with interrupts on: the compiler adds to the counter in memory */
+#define COUNT(counter)         (GG_au32Counter[counter]++)
+
+/************************ Function Declarations ****************************/
+
+void Counters_Initialize(u8 u8Reset_Cause);   /*Keeps the counters from before a warm reset if they are intact and counts the reset*/
+
+#endif /* __COUNTERS_HEADER */
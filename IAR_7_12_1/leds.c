@@ -6,26 +6,30 @@
 YYYY-MM-DD  Comments
 -------------------------------------------------------------------------------------------
 2019-06-04  File created
+2026-10-19  LedOn and LedOff are left out when CAMPER_SUBMISSION
 
 ************************************************************************/
 
 #include "leds.h"
 #include "io430f2122.h"
 #include "typedef_MSP430.h"
+#include "bnclk-efwd-01.h"
 
+#if !CAMPER_SUBMISSION
 void LedOn(LedInformation LEDInfo)
 {
-  *(LEDInfo.u16pPortAddress) |= LEDInfo.u8LEDIdentifier;
+  *(LEDInfo.u8pPortAddress) |= LEDInfo.u8LEDIdentifier;
 }
 
 void LedOff(LedInformation LEDInfo)
 {
-  *(LEDInfo.u16pPortAddress) &= ~LEDInfo.u8LEDIdentifier;
+  *(LEDInfo.u8pPortAddress) &= ~LEDInfo.u8LEDIdentifier;
 }
+#endif
 
 bool isLedOn(LedInformation LEDInfo)
 {
-  return (((*(LEDInfo.u16pPortAddress)) & LEDInfo.u8LEDIdentifier) == LEDInfo.u8LEDIdentifier);
+  return (((*(LEDInfo.u8pPortAddress)) & LEDInfo.u8LEDIdentifier) == LEDInfo.u8LEDIdentifier);
 }
 bool isLedOff(LedInformation LEDInfo)
 {
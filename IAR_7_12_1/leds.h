@@ -6,6 +6,7 @@
 YYYY-MM-DD  Comments
 -------------------------------------------------------------------------------------------
 2019-06-04  File created
+2026-10-19  The port is a byte pointer to PxOUT
 
 ************************************************************************/
 
@@ -20,7 +21,7 @@ Type Definitions
 
 typedef struct
 {
-  u16* u16pPortAddress;
+  volatile u8* u8pPortAddress;     //PxOUT of the LED, a byte register, see the tables in bnclk-efwd-01.c
   u8 u8LEDIdentifier;
 }LedInformation;
 
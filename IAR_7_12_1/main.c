@@ -8,8 +8,9 @@ The current time can be set by the use of the buttons.
 In the event of power loss the device will stop powering the display but the backup
 battery will keep the current time until power is restored
 
-Future additions will likely include an alarm with the ability to set, snooze and turn off
-said alarm
+Two alarms can be set, turned on or off, snoozed and dismissed with the same buttons,
+and the date can be shown and set.  The time, date and crystal calibration can also be
+set over a UART console
 **********************************************************************/
 
 
@@ -25,8 +26,14 @@ YYYY-MM-DD  Checksum  Comments
 #include "io430.h"
 #include "typedef_MSP430.h"
 #include "intrinsics.h"
-#include "main.h"
 #include "bnclk-efwd-01.h"
+#include "main.h"
+#include "buzzer.h"
+#include "stopwatch.h"
+#include "console.h"
+#include "telemetry.h"
+#include "profile.h"
+#include "counters.h"
 
 
 /************************ External Program Globals ****************************/
@@ -34,6 +41,20 @@ YYYY-MM-DD  Checksum  Comments
 extern fnCode_type GG_fpCLOCKSM;                 /* From bnclk-efwd-01.c */
 
 extern int GG_u8Second_Counter;            /* From bnclk-efwd-01.c */
+extern volatile u8 GG_u8Wake_Countdown;    /* From bnclk-efwd-01.c */
+extern volatile u8 GG_u8Button_Fast_Ticks; /* From bnclk-efwd-01.c */
+extern volatile u16 GG_u16Tick_Count;      /* From bnclk-efwd-01.c */
+#if NEXT_FRAME_ENABLED
+extern u8 GG_au8Next_Frame[];              /* From bnclk-efwd-01.c */
+extern volatile u8 GG_u8Next_Frame_Ready;  /* From bnclk-efwd-01.c */
+#endif
+extern u32 GG_au32Counter[];               /* From counters.c */
+#if TELEMETRY_ENABLED
+extern u8 GG_au8Telemetry[];               /* From telemetry.c */
+extern u8 GG_u8Telemetry_Head;             /* From telemetry.c */
+extern u8 GG_u8Telemetry_Tail;             /* From telemetry.c */
+extern u16 GG_u16Telemetry_Last;           /* From telemetry.c */
+#endif
 
 
 /************************ Program Globals ****************************/
@@ -45,28 +66,62 @@ extern int GG_u8Second_Counter;            /* From bnclk-efwd-01.c */
 
 int main(void)
 {
+  u8 u8Reset_Cause = IFG1 & RESET_CAUSE_FLAGS;
 
   /* Enter the state machine where the program will remain unless power cycled */
 
+  IFG1 &= ~u8Reset_Cause;           //so the next reset only shows its own cause
+  Counters_Initialize(u8Reset_Cause);
+  Telemetry_Initialize(u8Reset_Cause);   //before any interrupt can log an event
   Clock_Initialize();               //initialize the ports, enable interupts and start the clock
+  Profile_Initialize();             //after Timer A is started, it is the profiler's clock
   GG_fpCLOCKSM = ClockSM_Start;
 
   while(1)
   {
     //the state machine starts in the start function then upon button press
     //enters the tick function and stays there unless power is lost
+    COUNT(COUNTER_WAKES);
+#if NEXT_FRAME_ENABLED
+    GG_u8Next_Frame_Ready = false;  //whatever woke it may change the time or the display, ClockSM_Tick makes a new frame
+#endif
+    Profile_Begin(PROFILE_SITE_STATE);
 	  GG_fpCLOCKSM();
+    Profile_End(PROFILE_SITE_STATE);   //already ended if the state went to sleep
   } 
 } /* end main */
 
 
 /************************ Interrupt Service Routines ****************************/
+#if defined(__GNUC__) && defined(__MSP430__)
+void __attribute__((interrupt(PORT2_VECTOR))) Port2ISR(void)
+#else
 #pragma vector = PORT2_VECTOR
 __interrupt void Port2ISR(void)
-/* Handles interupt caused by loss of power returning to LP_Sleep state with all outputs off */
+#endif
+/* Handles interupt caused by loss of power returning to LP_Sleep state with all outputs off
+and the falling edge of button 0 which wakes the main loop straight into ClockSM_Button_Press */
 {
-  GG_fpCLOCKSM = ClockSM_LP_Sleep;
+  Profile_Begin(PROFILE_SITE_PORT2);
+  if(P2IFG & P2_5_LOST_POWER_IND)
+  {
+    GG_fpCLOCKSM = ClockSM_LP_Sleep;
+    GG_u8Wake_Countdown = 1;      //LP_Sleep runs at the next tick like it did before ticks were skipped
+#if NEXT_FRAME_ENABLED
+    GG_u8Next_Frame_Ready = false;  //the LEDs stay as they are on battery
+#endif
+    TELEMETRY_LOG_ISR(EVENT_POWER_LOST);
+    COUNT(COUNTER_POWER_LOSSES);
+  }
+  else if(P2IFG & P2_1_BUTTON_0)
+  {
+    if(Button_0_Pressed())
+    {
+      __bic_SR_register_on_exit(LPM3_bits);
+    }
+  }
   P2IFG=0x00;
+  Profile_End(PROFILE_SITE_PORT2);
 //  P1OUT=Port1_LP_Sleep;
 //  P2OUT=Port2_LP_Sleep;
 //  P3OUT=Port3_LP_Sleep;
@@ -75,14 +130,175 @@ __interrupt void Port2ISR(void)
 
 
 /*----------------------------------------------------------------------------*/
+#if defined(__GNUC__) && defined(__MSP430__)
+void __attribute__((interrupt(TIMER0_A1_VECTOR))) TimerAISR(void)
+#else
 #pragma vector = TIMER0_A1_VECTOR
 __interrupt void TimerAISR(void)
+#endif
+{
+  Profile_Begin(PROFILE_SITE_TIMERA);
+  switch(__even_in_range(TAIV, TAIV_TAIFG))  //reading TAIV clears the flag being handled
+  {
+    case TAIV_TACCR1:
+      /* 62.5ms button sub-tick, only enabled during the fast sampling window */
+      TACCR1 += TIME_62MS;
+      if(TACCR1 > TIME_250MS)
+      {
+        TACCR1 = TIME_62MS;
+      }
+      if(Button_Fast_Sample())
+      {
+        __bic_SR_register_on_exit(LPM3_bits);
+      }
+      break;
+      
+    case TAIV_TACCR2:
+      /* Note boundary of the melody playing, the tone itself runs from USCI_B0, or the exact end of the countdown */
+      if(Melody_Playing())
+      {
+        Melody_Next();
+      }
+      else if(Countdown_Expired())
+      {
+        __bic_SR_register_on_exit(LPM3_bits);
+      }
+      break;
+      
+    case TAIV_TAIFG:
+      GG_u8Second_Counter++;
+#if NEXT_FRAME_ENABLED
+      /* The minute boundary, the LEDs of the new minute from Next_Frame_Prepare before anything else */
+      if(GG_u8Next_Frame_Ready && GG_u8Second_Counter == 240)
+      {
+        P1OUT = (P1OUT & Port1_Clear_Mask) | GG_au8Next_Frame[0];
+        P2OUT = (P2OUT & Port2_Clear_Mask) | GG_au8Next_Frame[1];
+        P3OUT = (P3OUT & Port3_Clear_Mask) | GG_au8Next_Frame[2];
+        GG_u8Next_Frame_Ready = false;
+      }
+#endif
+      GG_u16Tick_Count++;
+#if CONSOLE_ENABLED
+      Calibration_Tick();
+#endif
+      if(Countdown_Tick())
+      {
+        GG_u8Wake_Countdown = 0;
+      }
+      if(GG_u8Button_Fast_Ticks && --GG_u8Button_Fast_Ticks == 0)
+      {
+        TACCTL1 = 0;            //window over, back to sampling on the ticks only
+      }
+      /* Buttons 1 and 2 on every tick, the main loop is only woken for a new press */
+      if(Button_Fast_Sample())
+      {
+        GG_u8Wake_Countdown = 0;
+      }
+      
+      /* Only wake the main loop on the ticks it asked for. A countdown that was already 0
+      (set and then run out before the main loop got back to sleep) still wakes on this tick */
+      if(GG_u8Wake_Countdown <= 1)
+      {
+        GG_u8Wake_Countdown = 0;
+        __bic_SR_register_on_exit(LPM3_bits);
+      }
+      else
+      {
+        GG_u8Wake_Countdown--;
+      }
+      break;
+      
+    default:
+      break;
+  }
+  Profile_End(PROFILE_SITE_TIMERA);
+  
+} // end quarter second tick ISR
+
+
+/*----------------------------------------------------------------------------*/
+#if defined(__GNUC__) && defined(__MSP430__)
+void __attribute__((interrupt(TIMER1_A0_VECTOR))) Timer1AISR(void)
+#else
+#pragma vector = TIMER1_A0_VECTOR
+__interrupt void Timer1AISR(void)
+#endif
+{
+  TA1CTL = TIMER1_STOP;           //one shot, ClockSM_Button_Press arms the next repeat
+  if(GG_fpCLOCKSM != ClockSM_LP_Sleep)
+  {
+    GG_fpCLOCKSM = ClockSM_Button_Press;
+    __bic_SR_register_on_exit(LPM3_bits);
+  }
+  
+} // end auto-repeat ISR
+
+
+/*----------------------------------------------------------------------------*/
+#if defined(__GNUC__) && defined(__MSP430__)
+void __attribute__((interrupt(TIMER1_A1_VECTOR))) Timer1A1ISR(void)
+#else
+#pragma vector = TIMER1_A1_VECTOR
+__interrupt void Timer1A1ISR(void)
+#endif
+{
+  switch(__even_in_range(TA1IV, TAIV_TAIFG))  //reading TA1IV clears the flag being handled
+  {
+    case TAIV_TACCR1:
+      /* Release sampling, only enabled while a button is held */
+      if(Button_Release_Sample())
+      {
+        __bic_SR_register_on_exit(LPM3_bits);
+      }
+      break;
+      
+    default:
+      break;
+  }
+  
+} // end button release ISR
+
+
+#if BUZZER_ENABLED || CONSOLE_ENABLED
+/*----------------------------------------------------------------------------*/
+#if defined(__GNUC__) && defined(__MSP430__)
+void __attribute__((interrupt(USCIAB0TX_VECTOR))) USCITxISR(void)
+#else
+#pragma vector = USCIAB0TX_VECTOR
+__interrupt void USCITxISR(void)
+#endif
 {
-  asm("BIC #0x00D0,0(SP)"); //this is a bit clear at 0(SP) of what appears to be all the bits? 
-  GG_u8Second_Counter++;
-  TACTL = TIMERA_INT_CLEAR_FLAG;
-  // can I just write 'LPM0_EXIT;' as defined in io430x21x2?
-//  LPM3_EXIT;
+#if BUZZER_ENABLED
+  if(IE2 & IFG2 & UCB0TXIFG)      //UCB0TXIFG is also set while USCI_B0 is held in reset, only act while a tone plays
+  {
+    UCB0TXBUF = 0;                //the data is never used, only UCB0CLK on P3.3 is
+  }
+#endif
+#if CONSOLE_ENABLED
+  if(IE2 & IFG2 & UCA0TXIFG)      //UCA0TXIFG is set whenever the UART is idle, only act while there is something to send
+  {
+    Console_Tx_Next();
+  }
+#endif
+  
+} // end buzzer tone and console transmit ISR
+#endif
+
+
+#if CONSOLE_ENABLED
+/*----------------------------------------------------------------------------*/
+#if defined(__GNUC__) && defined(__MSP430__)
+void __attribute__((interrupt(USCIAB0RX_VECTOR))) USCIRxISR(void)
+#else
+#pragma vector = USCIAB0RX_VECTOR
+__interrupt void USCIRxISR(void)
+#endif
+{
+  if(Console_Rx(UCA0RXBUF))       //reading UCA0RXBUF clears UCA0RXIFG
+  {
+    __bic_SR_register_on_exit(LPM3_bits);
+  }
   
-} // end half second tick ISR
+} // end console receive ISR
+#endif
 
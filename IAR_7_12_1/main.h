@@ -40,10 +40,9 @@ Returns with the processor awake.
 #pragma vector = PORT2_VECTOR
 __interrupt void Port2ISR(void);
 /*
-Handles waking up from low power mode via motion.
-This triggers a reset of the sleep interval to SHORT_SLEEP_TIME and sets the sleep
-counter to ensure the current sleep loop is exitted on return.
-Returns with the processor awake.
+Handles the LOST_POWER_IND falling edge by switching the state machine to ClockSM_LP_Sleep.
+Handles the BUTTON_0 falling edge by switching the state machine to ClockSM_Button_Press.
+Returns with the processor awake only for a button press.
 */
 
 
@@ -51,9 +50,53 @@ Returns with the processor awake.
 __interrupt void TimerAISR(void);
 /*
 Handles waking up from low power mode via TimerA.
-Increments GG_u8Second_Counter
-Returns with the processor awake.
+TAIFG: Increments GG_u8Second_Counter and GG_u16Tick_Count, returns with the processor awake once
+GG_u8Wake_Countdown runs out, the countdown has run out (see Countdown_Tick) or button 1 or 2 has
+a new press, they are sampled on every tick.
+TACCR1: 62.5ms sub-tick used to sample buttons 1 and 2 after button activity,
+returns with the processor awake for a new press.
+TACCR2: Note boundary of a melody, see Melody_Next.  Returns without waking the processor.
+When no melody is playing it is the exact end of the countdown and returns with the processor awake.
+*/
+
+
+#pragma vector = TIMER1_A0_VECTOR
+__interrupt void Timer1AISR(void);
+/*
+Auto-repeat timer for a held button, armed by ClockSM_Button_Press.
+Stops Timer1_A and makes ClockSM_Button_Press the next state.
+Returns with the processor awake unless power is lost.
+*/
+
+
+#pragma vector = TIMER1_A1_VECTOR
+__interrupt void Timer1A1ISR(void);
+/*
+TA1CCR1 samples the held button every TIME_SET_SAMPLE, see Button_Release_Sample.
+Returns with the processor awake only when button 0 is released.
+*/
+
+
+#if BUZZER_ENABLED || CONSOLE_ENABLED
+#pragma vector = USCIAB0TX_VECTOR
+__interrupt void USCITxISR(void);
+/*
+Keeps the buzzer tone going while a note plays, the tone is the UCB0CLK
+SPI clock so a byte is loaded every time the transmit buffer empties.
+Also sends the next console byte while there are bytes queued, see Console_Tx_Next.
+Returns without waking the processor.
+*/
+#endif
+
+
+#if CONSOLE_ENABLED
+#pragma vector = USCIAB0RX_VECTOR
+__interrupt void USCIRxISR(void);
+/*
+Stores a byte received by the UART console, see Console_Rx.
+Returns with the processor awake only when a whole command line is in.
 */
+#endif
 
 
 #if 0
@@ -0,0 +1,145 @@
+/**********************************************************************
+* Definitions for the cycle profiler functions
+
+MCLK, SMCLK and ACLK all run from the 32768Hz crystal (see cstartup.s43) and Timer A counts ACLK,
+so one TAR count is one CPU cycle.  A sample is the TAR difference between Profile_Begin and
+Profile_End, with one wrap at TACCR0 allowed, so samples longer than a 250ms tick are wrong.
+Interrupts that run inside a main loop sample are counted in it, ISRs are not nested.
+The table can be read with a debugger (GG_aProfile) or with the console P command.
+**********************************************************************/
+
+/************************ Revision History ****************************
+YYYY-MM-DD  Comments
+-------------------------------------------------------------------------------------------
+2026-10-19  File created
+
+************************************************************************/
+
+#include "io430.h"
+#include "typedef_MSP430.h"
+#include "profile.h"
+
+#if PROFILE_ENABLED
+
+/******************** Program Globals ************************/
+/* Global variable definitions intended for scope across multiple files */
+ProfileInformation GG_aProfile[PROFILE_SITES];     //cycles per profiled site
+
+/******************** Local Globals ************************/
+/* Global variable definitions intended only for the scope of this file */
+u16 LG_au16Profile_Start[PROFILE_SITES];           //TAR at Profile_Begin, PROFILE_IDLE when no sample is running
+
+/******************** Function Definitions ************************/
+
+/*------------------------------------------------------------------------------
+Function: Profile_Initialize
+
+Description: Clears the table, then times an empty Profile_Begin / Profile_End pair into
+PROFILE_SITE_OVERHEAD.  That is what the profiler adds to every other sample, subtract its
+minimum from theirs.
+ 
+Requires: Timer A is running (called after Clock_Initialize)
+
+Promises: Every site is empty except PROFILE_SITE_OVERHEAD
+*/
+void Profile_Initialize()
+{
+  for(u8 i = 0; i < PROFILE_SITES; i++)
+  {
+    GG_aProfile[i].u16Min = 0xFFFF;
+    GG_aProfile[i].u16Max = 0;
+    GG_aProfile[i].u16Count = 0;
+    GG_aProfile[i].u32Total = 0;
+    LG_au16Profile_Start[i] = PROFILE_IDLE;
+  }
+  
+  for(u8 i = 0; i < PROFILE_OVERHEAD_RUNS; i++)
+  {
+    Profile_Begin(PROFILE_SITE_OVERHEAD);
+    Profile_End(PROFILE_SITE_OVERHEAD);
+  }
+  
+} /* end Profile_Initialize */
+
+/*------------------------------------------------------------------------------
+Function: Profile_Begin
+
+Description: Starts a sample
+ 
+Requires: u8Site < PROFILE_SITES, a site is only sampled from one place at a time
+
+Promises: The start of the sample is the current TAR
+*/
+void Profile_Begin(u8 u8Site)
+{
+  LG_au16Profile_Start[u8Site] = TAR;
+  
+} /* end Profile_Begin */
+
+/*------------------------------------------------------------------------------
+Function: Profile_End
+
+Description: Ends a sample and adds it to the table
+ 
+Requires: u8Site < PROFILE_SITES
+
+Promises: 
+  - If a sample of u8Site is running its cycles are added to GG_aProfile[u8Site], otherwise nothing changes.
+    The main loop ends a state's sample before it sleeps so this is safe to call twice.
+  - No sample of u8Site is running
+*/
+void Profile_End(u8 u8Site)
+{
+  u16 u16Now = TAR;
+  u16 u16Start = LG_au16Profile_Start[u8Site];
+  u16 u16Cycles;
+  ProfileInformation* pSite = &GG_aProfile[u8Site];
+  
+  if(u16Start == PROFILE_IDLE)
+  {
+    return;
+  }
+  LG_au16Profile_Start[u8Site] = PROFILE_IDLE;
+  
+  u16Cycles = u16Now - u16Start;
+  if(u16Now < u16Start)
+  {
+    u16Cycles += TACCR0 + 1;      //TAR went through 0 during the sample
+  }
+  
+  if(pSite->u16Count == 0xFFFF)
+  {
+    return;                       //full, the average would go wrong
+  }
+  pSite->u16Count++;
+  pSite->u32Total += u16Cycles;
+  if(u16Cycles < pSite->u16Min)
+  {
+    pSite->u16Min = u16Cycles;
+  }
+  if(u16Cycles > pSite->u16Max)
+  {
+    pSite->u16Max = u16Cycles;
+  }
+  
+} /* end Profile_End */
+
+/*------------------------------------------------------------------------------
+Function: Profile_Cancel
+
+Description: Drops the samples that are running, their start is meaningless once TAR is cleared
+ 
+Requires: 
+
+Promises: No sample is running
+*/
+void Profile_Cancel()
+{
+  for(u8 i = 0; i < PROFILE_SITES; i++)
+  {
+    LG_au16Profile_Start[i] = PROFILE_IDLE;
+  }
+  
+} /* end Profile_Cancel */
+
+#endif /* PROFILE_ENABLED */
@@ -0,0 +1,59 @@
+/**********************************************************************
+* Header file for the cycle profiler functions
+**********************************************************************/
+
+/************************ Revision History ****************************
+YYYY-MM-DD  Comments
+-------------------------------------------------------------------------------------------
+2026-10-19  File created
+
+************************************************************************/
+
+#ifndef __PROFILE_HEADER
+#define __PROFILE_HEADER
+
+#include "typedef_MSP430.h"
+#include "bnclk-efwd-01.h"
+
+/****************************************************************************************
+Type Definitions
+****************************************************************************************/
+
+typedef struct
+{
+  u16 u16Min;          /* cycles, 0xFFFF until the first sample */
+  u16 u16Max;
+  u16 u16Count;        /* samples, stops at 0xFFFF */
+  u32 u32Total;        /* cycles over all the counted samples */
+}ProfileInformation;
+
+/****************************************************************************************
+Constants
+****************************************************************************************/
+
+/* Profiled code, index into GG_aProfile */
+#define PROFILE_SITE_STATE     (u8)0     /* GG_fpCLOCKSM() from the dispatch to the state going to sleep */
+#define PROFILE_SITE_TIMERA    (u8)1     /* TimerAISR, every TAIV source */
+#define PROFILE_SITE_PORT2     (u8)2     /* Port2ISR */
+#define PROFILE_SITE_DISPLAY   (u8)3     /* Update_Display */
+#define PROFILE_SITE_OVERHEAD  (u8)4     /* an empty Profile_Begin / Profile_End pair, measured by Profile_Initialize */
+#define PROFILE_SITES          (u8)5
+
+#define PROFILE_IDLE           (u16)0xFFFF   /* start of a site with no sample running, TAR never gets this high */
+#define PROFILE_OVERHEAD_RUNS  (u8)8
+
+/************************ Function Declarations ****************************/
+
+#if PROFILE_ENABLED
+void Profile_Initialize();         /*Clears the table and measures the profiler's own overhead*/
+void Profile_Begin(u8 u8Site);     /*Starts a sample of u8Site*/
+void Profile_End(u8 u8Site);       /*Ends the sample of u8Site and adds it to the table*/
+void Profile_Cancel();             /*Drops the running samples, called when TAR is cleared*/
+#else
+#define Profile_Initialize()
+#define Profile_Begin(site)
+#define Profile_End(site)
+#define Profile_Cancel()
+#endif
+
+#endif /* __PROFILE_HEADER */
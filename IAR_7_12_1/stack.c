@@ -0,0 +1,62 @@
+/**********************************************************************
+* Definitions for the stack high water mark
+
+CSTACK shares the 512 bytes of RAM with the variables.  cstartup.s43 fills it with STACK_PAINT
+before anything runs, and the deepest point the stack has reached is the lowest word that no longer
+holds the paint.  Read it with the console W command after exercising every feature, including
+the melody, the console and button auto-repeat, and compare it with tools/stack_depth.py.
+**********************************************************************/
+
+/************************ Revision History ****************************
+YYYY-MM-DD  Comments
+-------------------------------------------------------------------------------------------
+2026-10-19  File created
+
+************************************************************************/
+
+#include "io430.h"
+#include "typedef_MSP430.h"
+#include "intrinsics.h"
+#include "stack.h"
+
+#pragma segment="CSTACK"
+
+/******************** Function Definitions ************************/
+
+/*------------------------------------------------------------------------------
+Function: Stack_Used
+
+Description: Finds the deepest point the stack has reached since reset
+ 
+Requires: cstartup.s43 painted CSTACK
+
+Promises: Returns the bytes of CSTACK that have been written.  Stack_Size() means the stack
+reached the bottom of CSTACK and may have gone past it into the variables.
+*/
+u16 Stack_Used()
+{
+  u16* pu16Word = (u16*)__segment_begin("CSTACK");
+  u16* pu16End = (u16*)__segment_end("CSTACK");
+  
+  while(pu16Word < pu16End && *pu16Word == STACK_PAINT)
+  {
+    pu16Word++;
+  }
+  return (u16)((u8*)pu16End - (u8*)pu16Word);
+  
+} /* end Stack_Used */
+
+/*------------------------------------------------------------------------------
+Function: Stack_Size
+
+Description: Size of CSTACK from the linker
+ 
+Requires: 
+
+Promises: Returns the size in bytes
+*/
+u16 Stack_Size()
+{
+  return (u16)((u8*)__segment_end("CSTACK") - (u8*)__segment_begin("CSTACK"));
+  
+} /* end Stack_Size */
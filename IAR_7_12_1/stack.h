@@ -0,0 +1,28 @@
+/**********************************************************************
+* Header file for the stack high water mark
+**********************************************************************/
+
+/************************ Revision History ****************************
+YYYY-MM-DD  Comments
+-------------------------------------------------------------------------------------------
+2026-10-19  File created
+
+************************************************************************/
+
+#ifndef __STACK_HEADER
+#define __STACK_HEADER
+
+#include "typedef_MSP430.h"
+
+/****************************************************************************************
+Constants
+****************************************************************************************/
+
+#define STACK_PAINT            (u16)0x5AA5   /* cstartup.s43 fills CSTACK with this, the two must match */
+
+/************************ Function Declarations ****************************/
+
+u16 Stack_Used();          /*Deepest the stack has been since reset, in bytes*/
+u16 Stack_Size();          /*Bytes the linker gave CSTACK*/
+
+#endif /* __STACK_HEADER */
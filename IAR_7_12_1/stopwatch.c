@@ -0,0 +1,323 @@
+/**********************************************************************
+* Definitions for stopwatch and countdown timer functions
+**********************************************************************/
+
+/************************ Revision History ****************************
+YYYY-MM-DD  Comments
+-------------------------------------------------------------------------------------------
+2026-10-19  File created
+
+************************************************************************/
+
+#include "io430.h"
+#include "typedef_MSP430.h"
+#include "intrinsics.h"
+#include "stopwatch.h"
+#include "buzzer.h"
+#include "bnclk-efwd-01.h"
+
+#if TIMERS_ENABLED
+
+/******************** External Globals ************************/
+/* Globally available variables from other files as indicated */
+extern volatile u16 GG_u16Tick_Count;              /* From bnclk-efwd-01.c */
+
+/******************** Program Globals ************************/
+/* Global variable definitions intended for scope across multiple files */
+volatile u8 GG_u8Countdown_Done = false;           //set by TimerAISR when the countdown runs out, cleared by ClockSM_Tick
+
+/******************** Local Globals ************************/
+/* Global variable definitions intended only for the scope of this file */
+u32 LG_u32Stopwatch_Start = 0;                     //timestamp the stopwatch would have started at to show its time now
+u32 LG_u32Stopwatch_Stopped = 0;                   //elapsed counts while stopped
+u32 LG_u32Lap = 0;                                 //elapsed counts when lap was pressed
+u8 LG_u8Stopwatch_Running = false;
+u8 LG_u8Lap_Shown = false;                         //the display is frozen on LG_u32Lap
+
+u32 LG_u32Countdown_End = 0;                       //timestamp the countdown runs out at
+u32 LG_u32Countdown_Left = 0;                      //counts left while stopped
+volatile u8 LG_u8Countdown_Running = false;
+
+/******************** Function Definitions ************************/
+
+/*------------------------------------------------------------------------------
+Function: Timestamp_Now
+
+Description: Reads Timer A and the tick count together as one count of ACLK, 1/32768s resolution.
+Nothing extra runs while the stopwatch or countdown is going, the time is read only when it is needed.
+ 
+Requires: 
+  - Called from the main loop with interrupts enabled
+  - MCLK and ACLK are the same clock so TAR can be read while it runs
+  - Time_Set_Latch restarts TAR, a running stopwatch loses or gains up to 250ms when the time is set
+
+Promises: Returns the timestamp, if the tick interrupt is pending it is counted
+*/
+u32 Timestamp_Now()
+{
+  u16 u16Ticks;
+  u16 u16Count;
+  
+  __disable_interrupt();
+  u16Count = TAR;
+  u16Ticks = GG_u16Tick_Count;
+  if((TACTL & TAIFG) && u16Count < TIME_62MS)
+  {
+    u16Ticks++;                   //TAR wrapped but TimerAISR has not run yet
+  }
+  __enable_interrupt();
+  
+  return (((u32)u16Ticks << TIMESTAMP_TICK_SHIFT) + u16Count) & TIMESTAMP_MASK;
+  
+} /* end Timestamp_Now */
+
+/*------------------------------------------------------------------------------
+Function: Stopwatch_Start_Stop
+
+Description: Starts the stopwatch from the time it is showing, or stops it
+ 
+Requires: 
+
+Promises: A stopped stopwatch holds its elapsed time exactly
+*/
+void Stopwatch_Start_Stop()
+{
+  u32 u32Now = Timestamp_Now();
+  
+  if(LG_u8Stopwatch_Running)
+  {
+    LG_u32Stopwatch_Stopped = (u32Now - LG_u32Stopwatch_Start) & TIMESTAMP_MASK;
+    LG_u8Stopwatch_Running = false;
+  }
+  else
+  {
+    LG_u32Stopwatch_Start = (u32Now - LG_u32Stopwatch_Stopped) & TIMESTAMP_MASK;
+    LG_u8Stopwatch_Running = true;
+  }
+  LG_u8Lap_Shown = false;
+  
+} /* end Stopwatch_Start_Stop */
+
+/*------------------------------------------------------------------------------
+Function: Stopwatch_Lap_Reset
+
+Description: While running, freezes the display on the time now (a lap) or goes back to the
+running time.  While stopped, resets the stopwatch to 0.
+ 
+Requires: 
+
+Promises: The stopwatch keeps running underneath a lap
+*/
+void Stopwatch_Lap_Reset()
+{
+  if(LG_u8Stopwatch_Running)
+  {
+    if(LG_u8Lap_Shown)
+    {
+      LG_u8Lap_Shown = false;
+    }
+    else
+    {
+      LG_u32Lap = (Timestamp_Now() - LG_u32Stopwatch_Start) & TIMESTAMP_MASK;
+      LG_u8Lap_Shown = true;
+    }
+  }
+  else
+  {
+    LG_u32Stopwatch_Stopped = 0;
+    LG_u8Lap_Shown = false;
+  }
+  
+} /* end Stopwatch_Lap_Reset */
+
+/*------------------------------------------------------------------------------
+Function: Stopwatch_Shown
+
+Description: The time the stopwatch display should show
+ 
+Requires: 
+
+Promises: Returns the lap time, the running time or the stopped time in ACLK counts
+*/
+u32 Stopwatch_Shown()
+{
+  if(LG_u8Lap_Shown)
+  {
+    return LG_u32Lap;
+  }
+  if(LG_u8Stopwatch_Running)
+  {
+    return (Timestamp_Now() - LG_u32Stopwatch_Start) & TIMESTAMP_MASK;
+  }
+  return LG_u32Stopwatch_Stopped;
+  
+} /* end Stopwatch_Shown */
+
+/*------------------------------------------------------------------------------
+Function: Countdown_Disarm
+
+Description: Turns off the TACCR2 compare Countdown_Tick sets in the countdown's last tick, so a
+countdown cancelled or paused in that tick does not run out after all.  The melody keeps TACCR2
+if it has it, Countdown_Tick never arms it then.
+ 
+Requires: LG_u8Countdown_Running has just been cleared, called from the main loop
+
+Promises: TACCR2 is off unless the melody is playing
+*/
+void Countdown_Disarm()
+{
+  __disable_interrupt();
+  if(!Melody_Playing())
+  {
+    TACCTL2 = 0;
+  }
+  __enable_interrupt();
+  
+} /* end Countdown_Disarm */
+
+/*------------------------------------------------------------------------------
+Function: Countdown_Add_Minute
+
+Description: Countdown setting.  While stopped a minute is added, wrapping to 0 after
+COUNTDOWN_MAX_MINUTES.  While running the countdown is cancelled.
+ 
+Requires: 
+
+Promises: The countdown is stopped, TACCR2 is off if the countdown had it
+*/
+void Countdown_Add_Minute()
+{
+  if(LG_u8Countdown_Running)
+  {
+    LG_u8Countdown_Running = false;
+    LG_u32Countdown_Left = 0;
+    Countdown_Disarm();
+    return;
+  }
+  
+  LG_u32Countdown_Left += COUNTS_PER_MINUTE;
+  if(LG_u32Countdown_Left > COUNTDOWN_MAX_MINUTES * COUNTS_PER_MINUTE)
+  {
+    LG_u32Countdown_Left = 0;
+  }
+  
+} /* end Countdown_Add_Minute */
+
+/*------------------------------------------------------------------------------
+Function: Countdown_Start_Stop
+
+Description: Starts the countdown from the time left, or pauses it.  The end is a timestamp,
+Countdown_Tick compares its tick in TimerAISR and then TACCR2 is set for the exact count.
+ 
+Requires: 
+
+Promises: A paused countdown holds the time left exactly and TACCR2 is off if the countdown had it,
+a countdown at 0 does not start
+*/
+void Countdown_Start_Stop()
+{
+  if(LG_u8Countdown_Running)
+  {
+    LG_u8Countdown_Running = false;
+    LG_u32Countdown_Left = (LG_u32Countdown_End - Timestamp_Now()) & TIMESTAMP_MASK;
+    Countdown_Disarm();
+  }
+  else if(LG_u32Countdown_Left != 0)
+  {
+    LG_u32Countdown_End = (Timestamp_Now() + LG_u32Countdown_Left) & TIMESTAMP_MASK;
+    LG_u8Countdown_Running = true;
+  }
+  
+} /* end Countdown_Start_Stop */
+
+/*------------------------------------------------------------------------------
+Function: Countdown_Remaining
+
+Description: The time the countdown display should show
+ 
+Requires: 
+
+Promises: Returns the time left in ACLK counts, never more than was set
+*/
+u32 Countdown_Remaining()
+{
+  u32 u32Left;
+  
+  if(!LG_u8Countdown_Running)
+  {
+    return LG_u32Countdown_Left;
+  }
+  u32Left = (LG_u32Countdown_End - Timestamp_Now()) & TIMESTAMP_MASK;
+  if(u32Left > LG_u32Countdown_Left)
+  {
+    return 0;                     //the end has passed and TimerAISR is about to stop it
+  }
+  return u32Left;
+  
+} /* end Countdown_Remaining */
+
+/*------------------------------------------------------------------------------
+Function: Countdown_Tick
+
+Description: Runs from TimerAISR on every tick while the countdown runs.  In the tick the countdown
+ends in, TACCR2 is set so the single compare interrupt is at the exact count.  If the melody has TACCR2
+or the end is right at the tick the countdown ends here instead.
+ 
+Requires: Only called from interrupt context, GG_u16Tick_Count has just been incremented
+
+Promises: Returns TRUE when the countdown has run out and the main loop needs to signal it
+*/
+bool Countdown_Tick()
+{
+  u16 u16End_Tick;
+  u16 u16End_Count;
+  
+  if(!LG_u8Countdown_Running)
+  {
+    return FALSE;
+  }
+  
+  u16End_Tick = (u16)(LG_u32Countdown_End >> TIMESTAMP_TICK_SHIFT);
+  u16End_Count = (u16)LG_u32Countdown_End & TIMESTAMP_TAR_MASK;
+  if(u16End_Tick == GG_u16Tick_Count && u16End_Count >= COUNTDOWN_TAR_MIN && !Melody_Playing())
+  {
+    TACCR2 = u16End_Count;
+    TACCTL2 = CCIE;
+    return FALSE;
+  }
+  if((s16)(GG_u16Tick_Count - u16End_Tick) >= 0)
+  {
+    return Countdown_Expired();
+  }
+  return FALSE;
+  
+} /* end Countdown_Tick */
+
+/*------------------------------------------------------------------------------
+Function: Countdown_Expired
+
+Description: The countdown has run out
+ 
+Requires: Only called from interrupt context
+
+Promises: TACCR2 is off if the countdown had it, GG_u8Countdown_Done is set and TRUE is returned.
+A countdown that was cancelled or paused is left as it is and FALSE is returned.
+*/
+bool Countdown_Expired()
+{
+  if(!LG_u8Countdown_Running)
+  {
+    return FALSE;
+  }
+  if(!Melody_Playing())
+  {
+    TACCTL2 = 0;
+  }
+  LG_u8Countdown_Running = false;
+  LG_u32Countdown_Left = 0;
+  GG_u8Countdown_Done = true;
+  return TRUE;
+  
+} /* end Countdown_Expired */
+
+#endif /* TIMERS_ENABLED */
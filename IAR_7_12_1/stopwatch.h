@@ -0,0 +1,48 @@
+/**********************************************************************
+* Header file for stopwatch and countdown timer functions
+**********************************************************************/
+
+/************************ Revision History ****************************
+YYYY-MM-DD  Comments
+-------------------------------------------------------------------------------------------
+2026-10-19  File created
+
+************************************************************************/
+
+#ifndef __STOPWATCH_HEADER
+#define __STOPWATCH_HEADER
+
+#include "typedef_MSP430.h"
+#include "bnclk-efwd-01.h"
+
+/****************************************************************************************
+Constants
+****************************************************************************************/
+
+/* Timestamps are GG_u16Tick_Count and TAR together: <28-13> tick, <12-0> TAR, in ACLK counts */
+#define TIMESTAMP_TICK_SHIFT   13
+#define TIMESTAMP_MASK         (u32)0x1FFFFFFF   /* timestamps wrap after 2^29 counts, about 4.5 hours */
+#define TIMESTAMP_TAR_MASK     (u16)0x1FFF
+#define COUNTS_PER_SECOND_SHIFT 15               /* 32768 ACLK counts per second */
+#define COUNTS_PER_MINUTE      ((u32)60 << COUNTS_PER_SECOND_SHIFT)
+#define COUNTDOWN_MAX_MINUTES  (u8)31            /* the most the hour and PM LEDs can show */
+#define COUNTDOWN_TAR_MIN      (u16)64           /* expiries closer than this to a tick are handled by the tick */
+
+/************************ Function Declarations ****************************/
+
+#if TIMERS_ENABLED
+u32 Timestamp_Now();               /*Reads the running tick count and TAR as one ACLK count*/
+void Stopwatch_Start_Stop();       /*Starts or stops the stopwatch, a stopped stopwatch keeps its time*/
+void Stopwatch_Lap_Reset();        /*Freezes or unfreezes a lap time while running, resets while stopped*/
+u32 Stopwatch_Shown();             /*The elapsed or lap time to show, in ACLK counts*/
+void Countdown_Add_Minute();       /*Countdown setting: adds a minute while stopped, cancels while running*/
+void Countdown_Start_Stop();       /*Starts or pauses the countdown*/
+u32 Countdown_Remaining();         /*The time left, in ACLK counts*/
+bool Countdown_Tick();             /*Called from TimerAISR every tick, returns TRUE if the countdown expired*/
+bool Countdown_Expired();          /*Called from TimerAISR on TACCR2 when no melody is playing*/
+#else
+#define Countdown_Tick()     FALSE
+#define Countdown_Expired()  FALSE
+#endif
+
+#endif /* __STOPWATCH_HEADER */
@@ -0,0 +1,189 @@
+/**********************************************************************
+* Definitions for the telemetry event log functions
+**********************************************************************/
+
+/************************ Revision History ****************************
+YYYY-MM-DD  Comments
+-------------------------------------------------------------------------------------------
+2026-10-19  File created
+
+************************************************************************/
+
+#include "io430.h"
+#include "typedef_MSP430.h"
+#include "intrinsics.h"
+#include "telemetry.h"
+
+#if TELEMETRY_ENABLED
+
+/******************** External Globals ************************/
+/* Globally available variables from other files as indicated */
+extern volatile u16 GG_u16Tick_Count;              /* From bnclk-efwd-01.c */
+
+/******************** Program Globals ************************/
+/* Global variable definitions intended for scope across multiple files, TELEMETRY_LOG_ISR writes the ring.
+The log is not cleared by cstartup so it still holds the events before a warm reset */
+__no_init u8 GG_au8Telemetry[TELEMETRY_SIZE];      //the records, a ring
+__no_init u8 GG_u8Telemetry_Head;                  //next byte written
+__no_init u8 GG_u8Telemetry_Tail;                  //first byte of the oldest record
+__no_init u16 GG_u16Telemetry_Last;                //GG_u16Tick_Count at the last record
+
+/******************** Local Globals ************************/
+/* Global variable definitions intended only for the scope of this file */
+__no_init u16 LG_u16Telemetry_Magic;               //TELEMETRY_MAGIC once the log has been set up
+
+/******************** Function Definitions ************************/
+
+/*------------------------------------------------------------------------------
+Function: Telemetry_Initialize
+
+Description: Starts a new log after power up, or keeps the one from before a warm reset, and logs the reset
+ 
+Requires: 
+  - Called once from main before interrupts can log anything
+  - u8Reset_Cause is the IFG1 reset flags, read before anything clears them
+
+Promises: The first new record is EVENT_RESET with the reset flags
+*/
+void Telemetry_Initialize(u8 u8Reset_Cause)
+{
+  if(LG_u16Telemetry_Magic != TELEMETRY_MAGIC || GG_u8Telemetry_Head >= TELEMETRY_SIZE ||
+     GG_u8Telemetry_Tail >= TELEMETRY_SIZE)
+  {
+    GG_u8Telemetry_Head = 0;
+    GG_u8Telemetry_Tail = 0;
+    LG_u16Telemetry_Magic = TELEMETRY_MAGIC;
+  }
+  GG_u16Telemetry_Last = GG_u16Tick_Count;
+  Telemetry_Log(EVENT_RESET, u8Reset_Cause);
+  
+} /* end Telemetry_Initialize */
+
+/*------------------------------------------------------------------------------
+Function: Telemetry_Record_Length
+
+Description: Length of the record starting at a ring index, from its header
+ 
+Requires: u8Index is the first byte of a record
+
+Promises: Returns 1 - 4
+*/
+u8 Telemetry_Record_Length(u8 u8Index)
+{
+  u8 u8Header = GG_au8Telemetry[u8Index];
+  u8 u8Length = 1;
+  
+  if((u8Header & TELEMETRY_DELTA_LONG) == TELEMETRY_DELTA_LONG)
+  {
+    u8Length += 2;
+  }
+  if(EVENT_HAS_DATA(u8Header >> TELEMETRY_EVENT_SHIFT))
+  {
+    u8Length++;
+  }
+  return u8Length;
+  
+} /* end Telemetry_Record_Length */
+
+/*------------------------------------------------------------------------------
+Function: Telemetry_Log
+
+Description: Adds a record.  Nothing is logged on the tick itself, so the cost is only
+paid when something happens.
+ 
+Requires: Can be called from interrupts and the main loop, interrupts are held off while the ring changes
+
+Promises: The record is in the log, the oldest records are dropped to make room for it and one byte more,
+at most 5 of them, so TELEMETRY_LOG_ISR finds a free byte
+*/
+void Telemetry_Log(u8 u8Event, u8 u8Data)
+{
+  __istate_t istate = __get_interrupt_state();
+  u16 u16Delta;
+  u8 u8Length;
+  u8 u8Free;
+  u8 u8Oldest;
+  
+  __disable_interrupt();
+  u16Delta = GG_u16Tick_Count - GG_u16Telemetry_Last;
+  GG_u16Telemetry_Last = GG_u16Tick_Count;
+  if(u8Event == EVENT_RESET)
+  {
+    u16Delta = 0;
+  }
+  
+  u8Length = 1;
+  if(u16Delta >= TELEMETRY_DELTA_LONG)
+  {
+    u8Length += 2;
+  }
+  if(EVENT_HAS_DATA(u8Event))
+  {
+    u8Length++;
+  }
+  u8Free = (GG_u8Telemetry_Tail - GG_u8Telemetry_Head - 1) & TELEMETRY_MASK;
+  while(u8Free <= u8Length)
+  {
+    u8Oldest = Telemetry_Record_Length(GG_u8Telemetry_Tail);
+    u8Free += u8Oldest;
+    GG_u8Telemetry_Tail = (GG_u8Telemetry_Tail + u8Oldest) & TELEMETRY_MASK;
+  }
+  
+  if(u16Delta >= TELEMETRY_DELTA_LONG)
+  {
+    GG_au8Telemetry[GG_u8Telemetry_Head] = (u8Event << TELEMETRY_EVENT_SHIFT) | TELEMETRY_DELTA_LONG;
+    GG_u8Telemetry_Head = (GG_u8Telemetry_Head + 1) & TELEMETRY_MASK;
+    GG_au8Telemetry[GG_u8Telemetry_Head] = (u8)u16Delta;
+    GG_u8Telemetry_Head = (GG_u8Telemetry_Head + 1) & TELEMETRY_MASK;
+    GG_au8Telemetry[GG_u8Telemetry_Head] = (u8)(u16Delta >> 8);
+  }
+  else
+  {
+    GG_au8Telemetry[GG_u8Telemetry_Head] = (u8Event << TELEMETRY_EVENT_SHIFT) | (u8)u16Delta;
+  }
+  GG_u8Telemetry_Head = (GG_u8Telemetry_Head + 1) & TELEMETRY_MASK;
+  if(EVENT_HAS_DATA(u8Event))
+  {
+    GG_au8Telemetry[GG_u8Telemetry_Head] = u8Data;
+    GG_u8Telemetry_Head = (GG_u8Telemetry_Head + 1) & TELEMETRY_MASK;
+  }
+  __set_interrupt_state(istate);
+  
+} /* end Telemetry_Log */
+
+/*------------------------------------------------------------------------------
+Function: Telemetry_Drain
+
+Description: Moves records out of the log, oldest first, to be sent somewhere in one burst
+ 
+Requires: 
+  - Only called from the main loop with interrupts enabled
+  - pu8Buffer has room for u8Max bytes
+
+Promises: Returns the number of bytes copied, only whole records are copied and those are removed from the log
+*/
+u8 Telemetry_Drain(u8* pu8Buffer, u8 u8Max)
+{
+  u8 u8Count = 0;
+  u8 u8Length;
+  
+  __disable_interrupt();
+  while(GG_u8Telemetry_Tail != GG_u8Telemetry_Head)
+  {
+    u8Length = Telemetry_Record_Length(GG_u8Telemetry_Tail);
+    if(u8Count + u8Length > u8Max)
+    {
+      break;
+    }
+    while(u8Length--)
+    {
+      pu8Buffer[u8Count++] = GG_au8Telemetry[GG_u8Telemetry_Tail];
+      GG_u8Telemetry_Tail = (GG_u8Telemetry_Tail + 1) & TELEMETRY_MASK;
+    }
+  }
+  __enable_interrupt();
+  return u8Count;
+  
+} /* end Telemetry_Drain */
+
+#endif /* TELEMETRY_ENABLED */
@@ -0,0 +1,82 @@
+/**********************************************************************
+* Header file for the telemetry event log functions
+**********************************************************************/
+
+/************************ Revision History ****************************
+YYYY-MM-DD  Comments
+-------------------------------------------------------------------------------------------
+2026-10-19  File created
+
+************************************************************************/
+
+#ifndef __TELEMETRY_HEADER
+#define __TELEMETRY_HEADER
+
+#include "typedef_MSP430.h"
+#include "bnclk-efwd-01.h"
+
+/****************************************************************************************
+Constants
+****************************************************************************************/
+
+/* Record format, 1 to 4 bytes:
+    header <7-5> event, <4-0> Timer A ticks (250ms) since the previous record
+    if the header delta is TELEMETRY_DELTA_LONG the 16 bit delta follows, low byte first
+    EVENT_RESET and EVENT_HOUR then have one data byte
+The first record's delta is from a record that is no longer in the log */
+#define TELEMETRY_SIZE         (u8)64      /* RAM ring, a power of 2.  Globals use ~170 of the 512 bytes, the rest is the stack */
+#define TELEMETRY_MASK         (u8)(TELEMETRY_SIZE - 1)
+#define TELEMETRY_MAGIC        (u16)0xB1C7 /* marks the no init log as valid after a reset */
+#define TELEMETRY_EVENT_SHIFT  5
+#define TELEMETRY_DELTA_LONG   (u8)0x1F
+#define TELEMETRY_BURST        (u8)12      /* most log bytes sent per console E command */
+
+/* Events */
+#define EVENT_RESET            (u8)0       /* data: IFG1 reset flags, the tick count restarts so the delta is 0 */
+#define EVENT_POWER_LOST       (u8)1
+#define EVENT_POWER_BACK       (u8)2
+#define EVENT_BUTTON_0         (u8)3       /* a new press, releases are not logged */
+#define EVENT_BUTTON_1         (u8)4
+#define EVENT_BUTTON_2         (u8)5
+#define EVENT_HOUR             (u8)6       /* data: the new hour 0 - 23 */
+#define EVENT_TIME_SET         (u8)7       /* the minute button was released or the console set the time */
+#define EVENT_HAS_DATA(event)  ((event) == EVENT_RESET || (event) == EVENT_HOUR)
+
+/* Telemetry_Log for an event without data from an interrupt, where interrupts are already off.  The usual record,
+under TELEMETRY_DELTA_LONG ticks after the last, is one header byte in the byte Telemetry_Log keeps free and one
+masked increment of the head, inline.  Anything else goes to Telemetry_Log.  The file needs the GG_ telemetry
+globals and GG_u16Tick_Count in its External Globals */
+#if TELEMETRY_ENABLED
+#define TELEMETRY_LOG_ISR(event)                                                                        \
+  do                                                                                                    \
+  {                                                                                                     \
+    u16 u16Telemetry_Delta = GG_u16Tick_Count - GG_u16Telemetry_Last;                                   \
+    if(u16Telemetry_Delta < TELEMETRY_DELTA_LONG &&                                                     \
+       ((GG_u8Telemetry_Head + 1) & TELEMETRY_MASK) != GG_u8Telemetry_Tail)                             \
+    {                                                                                                   \
+      GG_au8Telemetry[GG_u8Telemetry_Head] = ((event) << TELEMETRY_EVENT_SHIFT) | (u8)u16Telemetry_Delta; \
+      GG_u8Telemetry_Head = (GG_u8Telemetry_Head + 1) & TELEMETRY_MASK;                                 \
+      GG_u16Telemetry_Last += u16Telemetry_Delta;                                                       \
+    }                                                                                                   \
+    else                                                                                                \
+    {                                                                                                   \
+      Telemetry_Log(event, 0);                                                                          \
+    }                                                                                                   \
+  } while(0)
+#else
+#define TELEMETRY_LOG_ISR(event)
+#endif
+
+/************************ Function Declarations ****************************/
+
+#if TELEMETRY_ENABLED
+void Telemetry_Initialize(u8 u8Reset_Cause);   /*Keeps the log from before a warm reset if it is intact and logs the reset*/
+u8 Telemetry_Record_Length(u8 u8Index);    /*Bytes in the record that starts at u8Index*/
+void Telemetry_Log(u8 u8Event, u8 u8Data); /*Adds a record, dropping the oldest ones if the log is full*/
+u8 Telemetry_Drain(u8* pu8Buffer, u8 u8Max);   /*Moves whole records, oldest first, out of the log*/
+#else
+#define Telemetry_Initialize(cause)
+#define Telemetry_Log(event, data)
+#endif
+
+#endif /* __TELEMETRY_HEADER */
@@ -0,0 +1,101 @@
+/**********************************************************************
+* TI's msp430.h for clang
+
+GCC/io430.h, GCC/intrinsics.h and GCC/cstartup.S include msp430.h from TI's support files.
+The LLVM build puts this directory first on the include path so they get the registers and
+bits of IAR_7_12_1/msp430x21x2.h instead, with the in430.h intrinsics clang does not have.
+Every register is an extern at its address, msp430f2122_symbols.ld made from this file gives
+the addresses like the one in TI's support files does.
+**********************************************************************/
+
+/************************ Revision History ****************************
+YYYY-MM-DD  Comments
+-------------------------------------------------------------------------------------------
+2026-10-19  File created
+
+************************************************************************/
+
+#ifndef __LLVM_MSP430_HEADER
+#define __LLVM_MSP430_HEADER
+
+/* msp430x21x2.h checks it is built for the F21x2 */
+#define __TID__                0x2B00
+
+#if defined(MSP430_SYMBOLS)
+/* The Makefile runs this file through the preprocessor for the register addresses */
+#define READ_ONLY_REGISTER
+#define DEFC(name, address)    name = address;
+#define DEFW(name, address)    name = address;
+#elif defined(__ASSEMBLER__)
+#define READ_ONLY_REGISTER
+#define DEFC(name, address)
+#define DEFW(name, address)
+#else
+#define READ_ONLY_REGISTER     const
+#define DEFC(name, address)    extern volatile unsigned char name;
+#define DEFW(name, address)    extern volatile unsigned short name;
+#endif
+
+/* READ_ONLY is const in C, only the registers have it */
+#define const                  READ_ONLY_REGISTER
+#include "msp430x21x2.h"
+#undef const
+
+/* The compiler puts interrupt(n) in __interrupt_vector_n, at FFE0 + 2(n - 1) in
+GCC/lnk430F2122_BLINK.ld, msp430x21x2.h has the offset from FFE0 */
+#undef PORT1_VECTOR
+#undef PORT2_VECTOR
+#undef ADC10_VECTOR
+#undef USCIAB0TX_VECTOR
+#undef USCIAB0RX_VECTOR
+#undef TIMER0_A1_VECTOR
+#undef TIMER0_A0_VECTOR
+#undef WDT_VECTOR
+#undef COMPARATORA_VECTOR
+#undef TIMER1_A1_VECTOR
+#undef TIMER1_A0_VECTOR
+#undef NMI_VECTOR
+#undef RESET_VECTOR
+#define PORT1_VECTOR           3
+#define PORT2_VECTOR           4
+#define ADC10_VECTOR           6
+#define USCIAB0TX_VECTOR       7
+#define USCIAB0RX_VECTOR       8
+#define TIMER0_A1_VECTOR       9
+#define TIMER0_A0_VECTOR       10
+#define WDT_VECTOR             11
+#define COMPARATORA_VECTOR     12
+#define TIMER1_A1_VECTOR       13
+#define TIMER1_A0_VECTOR       14
+#define NMI_VECTOR             15
+#define RESET_VECTOR           16
+
+#if !defined(MSP430_SYMBOLS) && !defined(__ASSEMBLER__)
+
+/* msp430x21x2.h only has these for IAR's compiler, which would also bring in its In430.h */
+#define LPM0_bits              (CPUOFF)
+#define LPM1_bits              (SCG0+CPUOFF)
+#define LPM2_bits              (SCG1+CPUOFF)
+#define LPM3_bits              (SCG1+SCG0+CPUOFF)
+#define LPM4_bits              (SCG1+SCG0+OSCOFF+CPUOFF)
+
+/* Names from IAR's io430x21x2.h that the TI header does not have */
+#define TAIV_TACCR1            TA0IV_TACCR1
+#define TAIV_TACCR2            TA0IV_TACCR2
+#define TAIV_TAIFG             TA0IV_TAIFG
+
+#define __bis_SR_register(bits)          __asm__ __volatile__("bis.w %0, r2" : : "ri"((unsigned short)(bits)) : "memory")
+#define __bic_SR_register(bits)          __asm__ __volatile__("bic.w %0, r2" : : "ri"((unsigned short)(bits)) : "memory")
+#define __enable_interrupt()             __asm__ __volatile__("eint" : : : "memory")
+#define __disable_interrupt()            __asm__ __volatile__("dint\n\tnop" : : : "memory")
+#define __no_operation()                 __asm__ __volatile__("nop")
+
+/* Only in an interrupt function.  Asking for the frame address gives it a frame pointer, R4 is
+pushed first and points at its saved value so the SR pushed by the interrupt is the word above */
+#define __bic_SR_register_on_exit(bits)  (((volatile unsigned short*)__builtin_frame_address(0))[1] &= ~(unsigned short)(bits))
+
+#define __get_SR_register()              __extension__({ unsigned short u16SR; __asm__ __volatile__("mov.w r2, %0" : "=r"(u16SR)); u16SR; })
+
+#endif
+
+#endif /* __LLVM_MSP430_HEADER */
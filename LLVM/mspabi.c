@@ -0,0 +1,217 @@
+/**********************************************************************
+* Run time helpers for the clang build
+
+The calls clang makes for what the F2122 cannot do in one instruction, with the MSP430 EABI
+names.  The GNU build gets them from libgcc and newlib, there is no runtime library for the
+msp430 target in LLVM.  Built with -ffreestanding so the loops here do not turn into calls
+to themselves.
+**********************************************************************/
+
+/************************ Revision History ****************************
+YYYY-MM-DD  Comments
+-------------------------------------------------------------------------------------------
+2026-10-19  File created
+
+************************************************************************/
+
+#include "typedef_MSP430.h"
+
+/************************ Function Declarations ****************************/
+
+u16 __mspabi_divu(u16 u16Dividend, u16 u16Divisor);
+u16 __mspabi_remu(u16 u16Dividend, u16 u16Divisor);
+u32 __mspabi_divul(u32 u32Dividend, u32 u32Divisor);
+u16 __mspabi_mpyi(u16 u16A, u16 u16B);
+u32 __mspabi_mpyl(u32 u32A, u32 u32B);
+void* memset(void* pvDestination, int iValue, unsigned int uLength);
+void* memcpy(void* pvDestination, const void* pvSource, unsigned int uLength);
+u16 Mspabi_Divide(u16 u16Dividend, u16 u16Divisor, u16* pu16Remainder) __attribute__((noinline));
+
+/******************** Function Definitions ************************/
+
+/*------------------------------------------------------------------------------
+Function: Mspabi_Divide
+
+Description: 16 bit unsigned division, one quotient bit per pass
+
+Requires: u16Divisor is not 0
+
+Promises: Returns the quotient, *pu16Remainder is the remainder
+*/
+u16 Mspabi_Divide(u16 u16Dividend, u16 u16Divisor, u16* pu16Remainder)
+{
+  u16 u16Remainder = 0;
+  u8 u8Bit;
+
+  for(u8Bit = 0; u8Bit < 16; u8Bit++)
+  {
+    u16Remainder = (u16Remainder << 1) | (u16Dividend >> 15);
+    u16Dividend <<= 1;
+    if(u16Remainder >= u16Divisor)
+    {
+      u16Remainder -= u16Divisor;
+      u16Dividend |= 1;
+    }
+  }
+  *pu16Remainder = u16Remainder;
+  return u16Dividend;
+
+} /* end Mspabi_Divide */
+
+/*------------------------------------------------------------------------------
+Function: __mspabi_divu
+
+Description: u16 / u16
+
+Requires: u16Divisor is not 0
+
+Promises: Returns the quotient
+*/
+u16 __mspabi_divu(u16 u16Dividend, u16 u16Divisor)
+{
+  u16 u16Remainder;
+
+  return Mspabi_Divide(u16Dividend, u16Divisor, &u16Remainder);
+
+} /* end __mspabi_divu */
+
+/*------------------------------------------------------------------------------
+Function: __mspabi_remu
+
+Description: u16 % u16
+
+Requires: u16Divisor is not 0
+
+Promises: Returns the remainder
+*/
+u16 __mspabi_remu(u16 u16Dividend, u16 u16Divisor)
+{
+  u16 u16Remainder;
+
+  Mspabi_Divide(u16Dividend, u16Divisor, &u16Remainder);
+  return u16Remainder;
+
+} /* end __mspabi_remu */
+
+/*------------------------------------------------------------------------------
+Function: __mspabi_divul
+
+Description: u32 / u32, one quotient bit per pass
+
+Requires: u32Divisor is not 0
+
+Promises: Returns the quotient
+*/
+u32 __mspabi_divul(u32 u32Dividend, u32 u32Divisor)
+{
+  u32 u32Remainder = 0;
+  u8 u8Bit;
+
+  for(u8Bit = 0; u8Bit < 32; u8Bit++)
+  {
+    u32Remainder = (u32Remainder << 1) | (u32Dividend >> 31);
+    u32Dividend <<= 1;
+    if(u32Remainder >= u32Divisor)
+    {
+      u32Remainder -= u32Divisor;
+      u32Dividend |= 1;
+    }
+  }
+  return u32Dividend;
+
+} /* end __mspabi_divul */
+
+/*------------------------------------------------------------------------------
+Function: __mspabi_mpyi
+
+Description: u16 * u16 without a hardware multiplier, shift and add
+
+Requires:
+
+Promises: Returns the low 16 bits of the product, the same for signed operands
+*/
+u16 __mspabi_mpyi(u16 u16A, u16 u16B)
+{
+  u16 u16Product = 0;
+
+  while(u16B)
+  {
+    if(u16B & 1)
+    {
+      u16Product += u16A;
+    }
+    u16A <<= 1;
+    u16B >>= 1;
+  }
+  return u16Product;
+
+} /* end __mspabi_mpyi */
+
+/*------------------------------------------------------------------------------
+Function: __mspabi_mpyl
+
+Description: u32 * u32 without a hardware multiplier, shift and add
+
+Requires:
+
+Promises: Returns the low 32 bits of the product, the same for signed operands
+*/
+u32 __mspabi_mpyl(u32 u32A, u32 u32B)
+{
+  u32 u32Product = 0;
+
+  while(u32B)
+  {
+    if(u32B & 1)
+    {
+      u32Product += u32A;
+    }
+    u32A <<= 1;
+    u32B >>= 1;
+  }
+  return u32Product;
+
+} /* end __mspabi_mpyl */
+
+/*------------------------------------------------------------------------------
+Function: memset
+
+Description: What clang calls to clear a structure or an array
+
+Requires:
+
+Promises: uLength bytes from pvDestination are the low byte of iValue
+*/
+void* memset(void* pvDestination, int iValue, unsigned int uLength)
+{
+  u8* pu8Destination = (u8*)pvDestination;
+
+  while(uLength--)
+  {
+    *pu8Destination++ = (u8)iValue;
+  }
+  return pvDestination;
+
+} /* end memset */
+
+/*------------------------------------------------------------------------------
+Function: memcpy
+
+Description: What clang calls to copy a structure
+
+Requires: The two do not overlap
+
+Promises: uLength bytes from pvSource are at pvDestination
+*/
+void* memcpy(void* pvDestination, const void* pvSource, unsigned int uLength)
+{
+  u8* pu8Destination = (u8*)pvDestination;
+  const u8* pu8Source = (const u8*)pvSource;
+
+  while(uLength--)
+  {
+    *pu8Destination++ = *pu8Source++;
+  }
+  return pvDestination;
+
+} /* end memcpy */
@@ -0,0 +1,225 @@
+#!/usr/bin/env python3
+"""Grades the campers' Time_Rollover, Update_Display, LedOn and LedOff and ranks them by cycles and bytes.
+
+A submission is a C file with the four functions (and any of its own they call) that includes
+camper.h for the names the campers use, hourCounter, MINUTE_LED_ZERO, PM_LED and the rest.  Each
+one is linked with the firmware built with CAMPER_SUBMISSION 1, which leaves out its own:
+    - on the host (tools/host, make camper), with display_check: every hour, minute and AM/PM with
+      the minute rolling over and each button step, the 12:59 and 11:59 edges among them, and LedOn
+      and LedOff of every display LED, all against display_check's reference of the wiring
+    - for the MSP430 (GCC, make camper), when msp430-elf-gcc is found: the bytes of the
+      submission's object (code, constants and initial data) and the worst case cycles of
+      Update_Display plus Time_Rollover, the work of a minute, from wcet.py's longest path.
+      A camper's loops have no bounds in LOOP_BOUNDS, they are bounded by --default-bound
+The submissions are built and checked in parallel, one per CPU; the host check of a class of 24
+takes under 2 seconds on one core.  Those that pass are ranked by cycles then bytes, the rest by
+their mismatches.  A submission that does not build, or whose display_check takes more than
+--timeout seconds (a loop that never ends), fails.  The build's CLOCK_24_HOUR variant is the one graded.
+
+Usage:
+    camper_grade.py submission.c|directory ... [-j n] [--out dir] [--timeout s] [--default-bound n]
+
+A directory means every .c file in it.  Each submission's objects, executables and display_check
+output are in --out/name.  Exits with 1 when any submission fails.
+
+Revision History
+2026-10-19  File created
+"""
+
+import argparse
+import concurrent.futures
+import os
+import re
+import shutil
+import subprocess
+import sys
+import time
+
+import msp430
+import wcet
+
+TOOLS_DIR = os.path.dirname(os.path.abspath(__file__))
+HOST_DIR = os.path.join(TOOLS_DIR, "host")
+GCC_DIR = os.path.join(TOOLS_DIR, os.pardir, "GCC")
+TOOLCHAIN = os.environ.get("TOOLCHAIN", "msp430-elf-")
+
+CAMPER_FUNCTIONS = ("Time_Rollover", "Update_Display", "Update_Display_Hours", "Update_Display_AMPM", "LedOn",
+                    "LedOff")
+MINUTE_FUNCTIONS = ("Update_Display", "Time_Rollover")
+FLASH_SECTIONS = re.compile(r"^\.(text|rodata|data|lower\.text|lower\.rodata|lower\.data)(\.|$)")
+SUMMARY = re.compile(r"(\d+) cases .*, (\d+) mismatches")
+
+
+class Result:
+    def __init__(self, name, path):
+        self.name = name
+        self.path = path
+        self.status = "pass"
+        self.cases = 0
+        self.mismatches = 0
+        self.cycles = None
+        self.bytes = None
+        self.assumed = 0
+
+    def passed(self):
+        return self.status == "pass"
+
+
+def run(command, cwd, timeout=None):
+    """A command's exit status and output, None for the status when it ran out of time."""
+    try:
+        done = subprocess.run(command, cwd=cwd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                              universal_newlines=True, timeout=timeout)
+    except subprocess.TimeoutExpired as expired:
+        output = expired.output or ""
+        return None, output if isinstance(output, str) else output.decode(errors="replace")
+    return done.returncode, done.stdout
+
+
+def host_check(result, out, timeout):
+    """display_check linked with the submission."""
+    status, output = run(["make", "-s", "camper", "CAMPER=" + result.path, "CAMPER_DIR=" + out], HOST_DIR)
+    if status != 0:
+        result.status = "does not build"
+        write(out, "build.txt", output)
+        return
+    status, output = run([os.path.join(out, "display_check")], out, timeout)
+    write(out, "display_check.txt", output)
+    found = SUMMARY.search(output)
+    if status is None:
+        result.status = "timed out"
+    elif found is None:
+        result.status = "crashed" if status < 0 or status > 1 else "no summary"
+    else:
+        result.cases = int(found.group(1))
+        result.mismatches = int(found.group(2))
+        if status != 0:
+            result.status = "%d mismatches" % result.mismatches
+
+
+def msp430_cost(result, out, default_bound):
+    """Bytes of the submission's object and worst case cycles of a minute's work in the linked image."""
+    status, output = run(["make", "-s", "camper", "CAMPER=" + result.path, "CAMPER_DIR=" + out], GCC_DIR)
+    if status != 0:
+        write(out, "msp430.txt", output)
+        return
+    status, output = run([TOOLCHAIN + "size", "-A", os.path.join(out, "camper.o")], out)
+    if status == 0:
+        result.bytes = 0
+        for line in output.splitlines():
+            fields = line.split()
+            if len(fields) >= 2 and FLASH_SECTIONS.match(fields[0]) and fields[1].isdigit():
+                result.bytes += int(fields[1])
+
+    image = msp430.load(os.path.join(out, "camper.elf"))
+    program = msp430.Program(image)
+    bounds = dict((name, bound) for name, bound in wcet.LOOP_BOUNDS.items() if name not in CAMPER_FUNCTIONS)
+    analysis = wcet.Wcet(program, default_bound, bounds)
+    cycles = 0
+    for name in MINUTE_FUNCTIONS:
+        entry = image.address_of(name)
+        if entry is None:
+            return
+        cycles += analysis.function_cycles(entry)
+    result.cycles = cycles
+    result.assumed = len(analysis.assumed)
+    write(out, "wcet.txt", "\n".join(analysis.assumed + sorted(set(program.warnings))) + "\n")
+
+
+def write(out, name, text):
+    with open(os.path.join(out, name), "w") as file:
+        file.write(text)
+
+
+def grade(result, out, arguments, toolchain):
+    os.makedirs(out, exist_ok=True)
+    host_check(result, out, arguments.timeout)
+    if toolchain and result.passed():
+        try:
+            msp430_cost(result, out, arguments.default_bound)
+        except (KeyError, ValueError) as error:
+            write(out, "wcet.txt", "%s\n" % error)
+    return result
+
+
+def submissions(paths):
+    """(name, path) of every submission, names made unique."""
+    files = []
+    for path in paths:
+        if os.path.isdir(path):
+            files.extend(os.path.join(path, name) for name in sorted(os.listdir(path)) if name.endswith(".c"))
+        else:
+            files.append(path)
+    named = []
+    used = set()
+    for path in files:
+        base = os.path.splitext(os.path.basename(path))[0]
+        name = base
+        count = 1
+        while name in used:
+            count += 1
+            name = "%s-%d" % (base, count)
+        used.add(name)
+        named.append((name, os.path.abspath(path)))
+    return named
+
+
+def rank_key(result):
+    none_last = lambda value: float("inf") if value is None else value
+    if result.passed():
+        return (0, none_last(result.cycles), none_last(result.bytes), result.name)
+    return (1, 0 if result.cases else 1, result.mismatches, result.name)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("submissions", nargs="+")
+    parser.add_argument("-j", "--jobs", type=int, default=os.cpu_count() or 1)
+    parser.add_argument("--out", default=os.path.join(HOST_DIR, "camper"))
+    parser.add_argument("--timeout", type=float, default=2.0, help="seconds for a display_check run")
+    parser.add_argument("--default-bound", type=int, default=16, help="times a camper's loop can run")
+    arguments = parser.parse_args()
+
+    start = time.time()
+    named = submissions(arguments.submissions)
+    if not named:
+        print("no submissions", file=sys.stderr)
+        return 1
+
+    # The firmware without the campers' functions, once, before the submissions are built in parallel
+    status, output = run(["make", "-s", "libcamper.a", "obj/display_check.o"], HOST_DIR)
+    if status != 0:
+        print(output, file=sys.stderr)
+        return 1
+    toolchain = shutil.which(TOOLCHAIN + "gcc") is not None
+    if toolchain:
+        status, output = run(["make", "-s", "camper_objects"], GCC_DIR)
+        if status != 0:
+            print(output, file=sys.stderr)
+            toolchain = False
+
+    out = os.path.abspath(arguments.out)
+    with concurrent.futures.ThreadPoolExecutor(max_workers=max(1, arguments.jobs)) as pool:
+        jobs = [pool.submit(grade, Result(name, path), os.path.join(out, name), arguments, toolchain)
+                for name, path in named]
+        results = [job.result() for job in jobs]
+    results.sort(key=rank_key)
+
+    cost = lambda value: "-" if value is None else "%d" % value
+    print("%4s  %-24s %-16s %7s %7s" % ("rank", "submission", "result", "cycles", "bytes"))
+    for rank, result in enumerate(results, 1):
+        print("%4d  %-24s %-16s %7s %7s%s" % (rank, result.name, result.status, cost(result.cycles),
+                                              cost(result.bytes),
+                                              "  (%d loops assumed)" % result.assumed if result.assumed else ""))
+    failed = sum(1 for result in results if not result.passed())
+    print("\n%d submissions, %d pass, %d fail, %.1f s with %d jobs" % (len(results), len(results) - failed, failed,
+                                                                     time.time() - start, arguments.jobs))
+    if not toolchain:
+        print("%sgcc not found, cycles and bytes not measured: passing submissions are ranked by name"
+              % TOOLCHAIN)
+    print("display_check output of each is in %s" % out)
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
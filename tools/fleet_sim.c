@@ -0,0 +1,625 @@
+/**********************************************************************
+* Fleet simulator for the binary clock
+
+Runs N independent clocks for a number of years and reports the spread of what a fleet of
+them would see: how far they drift, how many days a backup battery lasts and how often the
+main loop wakes.  Each clock has its own crystal (tolerance, temperature and ageing), its own
+calibration, its own power cuts and its own button use, all drawn from a seed so a run can be
+repeated exactly whatever the number of threads.
+
+The clocks are a model of the firmware, not the firmware itself, stepped one day at a time:
+  - the clock counts 32768 x 60 ACLK counts per minute, plus GG_s16Calibration (console K),
+    see Calibration_Tick; a reset clears the calibration and the time
+  - ClockSM_Tick wakes twice a second, ClockSM_LP_Sleep four times, a button press wakes
+    for the press, each auto-repeat (REPEAT_FIRST_DELAY, REPEAT_SLOW) and the release
+  - on battery the MCU draws the LPM3 current plus the active current for the cycles of
+    each wake and of TimerAISR every tick
+The constants below follow bnclk-efwd-01.h and the F2122 datasheet, keep them in step.
+
+The clocks are shared out between the threads in ranges; a thread that runs out steals half
+of what is left of another thread's range.  A clock is only its Clock structure while it
+runs, nothing is kept per clock afterwards, each thread keeps its own histograms.
+
+Build:   cc -O2 -pthread -o fleet_sim fleet_sim.c -lm
+Use:     fleet_sim [-n clocks] [-y years] [-j threads] [-s seed] [-p ppm] [-k fraction]
+                   [-o outages] [-b presses] [-w cycles]
+         fleet_sim -n 100000 -y 10      a million clock-years
+**********************************************************************/
+
+/************************ Revision History ****************************
+YYYY-MM-DD  Comments
+-------------------------------------------------------------------------------------------
+2026-10-19  File created
+
+************************************************************************/
+
+#include <math.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Must match bnclk-efwd-01.h and console.h */
+#define ACLK_HZ                32768.0
+#define COUNTS_PER_MINUTE      (32768.0 * 60)
+#define CALIBRATION_MAX        127
+#define TICKS_PER_SECOND       4
+#define TICK_WAKES_PER_SECOND  2          /* ClockSM_Tick: the TICK LED on, then off */
+#define BATTERY_WAKES_PER_SECOND  4       /* ClockSM_LP_Sleep runs every tick */
+#define REPEAT_FIRST_DELAY     0.5
+#define REPEAT_SLOW            0.25
+
+/* MSP430F2122 and a CR2032, typical values */
+#define LPM3_UA                0.9        /* LPM3 with the 32768Hz crystal, 3V */
+#define ACTIVE_UA              10.0       /* active mode at MCLK = 32768Hz */
+#define TIMERA_ISR_CYCLES      60         /* TimerAISR every tick, see tools/wcet.py */
+#define BATTERY_MAH            225.0
+#define BATTERY_SELF_DISCHARGE 0.01       /* of the capacity, per year */
+
+/* The crystal, tuning fork cut */
+#define CRYSTAL_TURNOVER_C     25.0
+#define CRYSTAL_PARABOLA       (-0.034)   /* ppm / C^2 */
+
+#define SECONDS_PER_DAY        86400.0
+#define DAYS_PER_YEAR          365.25
+#define DAYS_IN_SEASON_TABLE   365
+#define CORRECTION_SECONDS     60.0       /* the owner sets the time once it is this far out */
+
+#define HISTOGRAM_BINS         400
+#define CHUNK                  64         /* clocks a thread takes from its range at a time */
+#define THREADS_MAX            256
+
+typedef struct
+{
+  double dLow;
+  double dWidth;
+  unsigned long long aullBin[HISTOGRAM_BINS + 2];   /* [0] below dLow, [HISTOGRAM_BINS + 1] above */
+  double dSum;
+  double dSum_Squares;
+  unsigned long long ullCount;
+} Histogram;
+
+typedef struct
+{
+  Histogram Drift;               /* seconds per year the clock runs fast */
+  Histogram Battery_Days;        /* days a battery lasts at this clock's average drain */
+  Histogram On_Battery;          /* days a year on battery */
+  Histogram Wakes;               /* main loop wakes per day */
+  unsigned long long ullTime_Lost;        /* batteries that ran flat during a power cut */
+  unsigned long long ullCorrections;      /* times the owner had to set the time */
+  unsigned long long ullClocks;
+} Statistics;
+
+/* One clock, everything it needs while it runs */
+typedef struct
+{
+  uint64_t u64Random;
+  double dPpm_25C;               /* crystal error at the turnover temperature */
+  double dAgeing;                /* ppm per year */
+  double dTemperature;           /* mean room temperature */
+  double dSeason;                /* summer to winter swing, +- */
+  double dDaily;                 /* day to night swing, +- */
+  int iCalibration;              /* GG_s16Calibration, counts per minute */
+  double dOutage_Rate;           /* power cuts per day */
+  double dOutage_Hours;          /* median length of a power cut */
+  double dPresses_Limit;         /* exp(-button presses per day), for Poisson */
+  double dOutage_Start;          /* day the current or next power cut starts */
+  double dOutage_End;            /* and ends */
+  double dCharge;                /* battery, uA seconds */
+  double dError;                 /* seconds the clock is ahead */
+  double dDrift;            /* seconds gained this run, never corrected */
+  double dDrain;                 /* uA seconds taken from the battery this run */
+  double dBattery_Seconds;       /* on battery this run */
+  double dWakes;
+} Clock;
+
+typedef struct
+{
+  pthread_mutex_t Lock;
+  unsigned long long ullNext;    /* next clock of this thread's range */
+  unsigned long long ullEnd;
+  Statistics Stats;
+  pthread_t Thread;
+  int iIndex;
+} Worker;
+
+/* Run settings, from the command line */
+unsigned long long ullClocks = 10000;
+double dYears = 10;
+int iThreads = 0;
+uint64_t u64Seed = 1;
+double dPpm_Tolerance = 20;      /* crystals are within +-, taken as 2 sigma */
+double dCalibrated = 0.5;        /* fraction of clocks given a K calibration */
+double dOutages = 4;             /* median power cuts per year */
+double dPresses = 4;             /* median button presses per day */
+double dWake_Cycles = 400;       /* cycles per main loop wake, see tools/wcet.py */
+
+Worker aWorker[THREADS_MAX];
+double adSeason[DAYS_IN_SEASON_TABLE];  /* sin() of the time of year, filled by main() */
+
+/*------------------------------------------------------------------------------
+Function: Random
+
+Description: splitmix64, one stream per clock
+
+Promises: Returns a uniform double in [0, 1)
+*/
+double Random(Clock* pClock)
+{
+  uint64_t z = (pClock->u64Random += 0x9E3779B97F4A7C15ull);
+
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  z ^= z >> 31;
+  return (z >> 11) * (1.0 / 9007199254740992.0);
+
+} /* end Random */
+
+double Normal(Clock* pClock)
+{
+  double dU = Random(pClock);
+
+  return sqrt(-2 * log(1 - dU)) * cos(2 * M_PI * Random(pClock));
+}
+
+double Exponential(Clock* pClock, double dMean)
+{
+  return -dMean * log(1 - Random(pClock));
+}
+
+/* dLimit is exp(-mean) */
+int Poisson(Clock* pClock, double dLimit)
+{
+  int iCount = 0;
+  double dProduct = Random(pClock);
+
+  while(dProduct > dLimit)
+  {
+    iCount++;
+    dProduct *= Random(pClock);
+  }
+  return iCount;
+}
+
+/*------------------------------------------------------------------------------
+Function: Histogram_Add
+
+Description: Adds a value to a histogram and its sums
+*/
+void Histogram_Add(Histogram* pHistogram, double dValue)
+{
+  double dBin = (dValue - pHistogram->dLow) / pHistogram->dWidth;
+  int iBin;
+
+  if(dBin < 0)
+  {
+    iBin = 0;
+  }
+  else if(dBin >= HISTOGRAM_BINS)
+  {
+    iBin = HISTOGRAM_BINS + 1;
+  }
+  else
+  {
+    iBin = 1 + (int)dBin;
+  }
+  pHistogram->aullBin[iBin]++;
+  pHistogram->dSum += dValue;
+  pHistogram->dSum_Squares += dValue * dValue;
+  pHistogram->ullCount++;
+
+} /* end Histogram_Add */
+
+/*------------------------------------------------------------------------------
+Function: Statistics_Initialize
+
+Description: Empties a set of statistics and sets the histogram ranges
+*/
+void Statistics_Initialize(Statistics* pStats)
+{
+  memset(pStats, 0, sizeof(*pStats));
+  pStats->Drift.dLow = -1000;
+  pStats->Drift.dWidth = 5;
+  pStats->Battery_Days.dLow = 0;
+  pStats->Battery_Days.dWidth = 100;
+  pStats->On_Battery.dLow = 0;
+  pStats->On_Battery.dWidth = 0.25;
+  pStats->Wakes.dLow = 0;
+  pStats->Wakes.dWidth = 1000;
+
+} /* end Statistics_Initialize */
+
+/*------------------------------------------------------------------------------
+Function: Clock_Start
+
+Description: Draws a clock's crystal, calibration, power and owner from the seed and its number
+
+Promises: The clock is set and running, with a full battery
+*/
+void Clock_Start(Clock* pClock, unsigned long long ullNumber)
+{
+  double dPpm_Calibration;
+
+  memset(pClock, 0, sizeof(*pClock));
+  pClock->u64Random = u64Seed ^ (ullNumber * 0xD1B54A32D192ED03ull);
+  pClock->dPpm_25C = Normal(pClock) * dPpm_Tolerance / 2;
+  pClock->dAgeing = Normal(pClock) * 1.0;
+  pClock->dTemperature = 21 + Normal(pClock) * 2;
+  pClock->dSeason = 1 + Random(pClock) * 4;
+  pClock->dDaily = Random(pClock) * 3;
+  pClock->dOutage_Rate = dOutages * exp(Normal(pClock)) / DAYS_PER_YEAR;
+  pClock->dOutage_Hours = exp(Normal(pClock) * 1.5);
+  pClock->dPresses_Limit = exp(-dPresses * exp(Normal(pClock) * 0.7));
+  pClock->dOutage_Start = Exponential(pClock, 1 / pClock->dOutage_Rate);
+  pClock->dOutage_End = pClock->dOutage_Start + Exponential(pClock, pClock->dOutage_Hours) / 24;
+  pClock->dCharge = BATTERY_MAH * 3600e3;
+
+  /* K is measured against a reference over a few days at room temperature */
+  if(Random(pClock) < dCalibrated)
+  {
+    dPpm_Calibration = pClock->dPpm_25C + CRYSTAL_PARABOLA * (pClock->dTemperature - CRYSTAL_TURNOVER_C)
+                                                           * (pClock->dTemperature - CRYSTAL_TURNOVER_C);
+    pClock->iCalibration = (int)lround(dPpm_Calibration * COUNTS_PER_MINUTE * 1e-6);
+    if(pClock->iCalibration > CALIBRATION_MAX)
+    {
+      pClock->iCalibration = CALIBRATION_MAX;
+    }
+    if(pClock->iCalibration < -CALIBRATION_MAX)
+    {
+      pClock->iCalibration = -CALIBRATION_MAX;
+    }
+  }
+
+} /* end Clock_Start */
+
+/*------------------------------------------------------------------------------
+Function: Clock_Day
+
+Description: Runs one day of a clock
+
+Requires: Clock_Start
+
+Promises: The day's error, battery drain and wakes are added to the clock, pStats counts a
+battery that ran flat and an owner setting the time
+*/
+void Clock_Day(Clock* pClock, int iDay, Statistics* pStats)
+{
+  double dDay = iDay;
+  double dTemperature;
+  double dPpm;
+  double dRate;
+  double dBattery_Seconds = 0;
+  double dStart;
+  double dEnd;
+  double dCurrent;
+  double dHold;
+  int iPresses;
+
+  /* Crystal rate today: the parabola averaged over the day's swing, and ageing */
+  dTemperature = pClock->dTemperature + pClock->dSeason * adSeason[iDay % DAYS_IN_SEASON_TABLE] - CRYSTAL_TURNOVER_C;
+  dPpm = pClock->dPpm_25C + pClock->dAgeing * iDay / DAYS_PER_YEAR
+       + CRYSTAL_PARABOLA * (dTemperature * dTemperature + pClock->dDaily * pClock->dDaily / 2);
+  dRate = (1 + dPpm * 1e-6) * COUNTS_PER_MINUTE / (COUNTS_PER_MINUTE + pClock->iCalibration) - 1;
+  pClock->dError += dRate * SECONDS_PER_DAY;
+  pClock->dDrift += dRate * SECONDS_PER_DAY;
+
+  /* Power cuts that overlap today, one may carry on from yesterday or into tomorrow */
+  while(1)
+  {
+    dStart = fmax(pClock->dOutage_Start, dDay);
+    dEnd = fmin(pClock->dOutage_End, dDay + 1);
+    if(dEnd > dStart)
+    {
+      dBattery_Seconds += (dEnd - dStart) * SECONDS_PER_DAY;
+    }
+    if(pClock->dOutage_End > dDay + 1)
+    {
+      break;
+    }
+    pClock->dOutage_Start = pClock->dOutage_End + Exponential(pClock, 1 / pClock->dOutage_Rate);
+    pClock->dOutage_End = pClock->dOutage_Start + Exponential(pClock, pClock->dOutage_Hours) / 24;
+    if(pClock->dOutage_Start >= dDay + 1)
+    {
+      break;
+    }
+  }
+
+  /* Battery: LPM3, ClockSM_LP_Sleep and TimerAISR every tick, and self-discharge */
+  dCurrent = LPM3_UA + (BATTERY_WAKES_PER_SECOND * dWake_Cycles + TICKS_PER_SECOND * TIMERA_ISR_CYCLES) / ACLK_HZ
+                       * ACTIVE_UA;
+  pClock->dBattery_Seconds += dBattery_Seconds;
+  pClock->dCharge -= dCurrent * dBattery_Seconds;
+  pClock->dDrain += dCurrent * dBattery_Seconds;
+  pClock->dCharge -= BATTERY_SELF_DISCHARGE * BATTERY_MAH * 3600e3 / DAYS_PER_YEAR;
+  pClock->dDrain += BATTERY_SELF_DISCHARGE * BATTERY_MAH * 3600e3 / DAYS_PER_YEAR;
+  if(pClock->dCharge <= 0 && dBattery_Seconds > 0)
+  {
+    /* Flat during a power cut: the clock resets to 12:00 with no calibration, the owner
+    fits a new battery and sets the time */
+    pStats->ullTime_Lost++;
+    pStats->ullCorrections++;
+    pClock->dCharge = BATTERY_MAH * 3600e3;
+    pClock->dError = 0;
+    pClock->iCalibration = 0;
+  }
+
+  /* Wakes: the clock, the battery and the buttons, each press with its repeats and release */
+  pClock->dWakes += (SECONDS_PER_DAY - dBattery_Seconds) * TICK_WAKES_PER_SECOND
+                  + dBattery_Seconds * BATTERY_WAKES_PER_SECOND;
+  iPresses = Poisson(pClock, pClock->dPresses_Limit);
+  for(int i = 0; i < iPresses; i++)
+  {
+    dHold = Exponential(pClock, 0.4);
+    pClock->dWakes += 2;
+    if(dHold > REPEAT_FIRST_DELAY)
+    {
+      pClock->dWakes += 1 + floor((dHold - REPEAT_FIRST_DELAY) / REPEAT_SLOW);
+    }
+  }
+
+  /* The owner sets the time once it is noticeably out, to within half a second */
+  if(fabs(pClock->dError) > CORRECTION_SECONDS)
+  {
+    pStats->ullCorrections++;
+    pClock->dError = (Random(pClock) - 0.5);
+  }
+
+} /* end Clock_Day */
+
+/*------------------------------------------------------------------------------
+Function: Clock_Run
+
+Description: Runs one clock for the whole run and adds it to the thread's statistics
+*/
+void Clock_Run(unsigned long long ullNumber, Statistics* pStats)
+{
+  Clock Clock;
+  int iDays = (int)(dYears * DAYS_PER_YEAR);
+
+  Clock_Start(&Clock, ullNumber);
+  for(int iDay = 0; iDay < iDays; iDay++)
+  {
+    Clock_Day(&Clock, iDay, pStats);
+  }
+  Histogram_Add(&pStats->Drift, Clock.dDrift / dYears);
+  Histogram_Add(&pStats->Battery_Days, BATTERY_MAH * 3600e3 / (Clock.dDrain / iDays));
+  Histogram_Add(&pStats->On_Battery, Clock.dBattery_Seconds / SECONDS_PER_DAY / dYears);
+  Histogram_Add(&pStats->Wakes, Clock.dWakes / iDays);
+  pStats->ullClocks++;
+
+} /* end Clock_Run */
+
+/*------------------------------------------------------------------------------
+Function: Take
+
+Description: Takes the next clocks for a worker, from its own range or stolen from another
+
+Promises: Returns 1 with [*pullFirst, *pullLast) to run, 0 when every range is empty
+*/
+int Take(Worker* pWorker, unsigned long long* pullFirst, unsigned long long* pullLast)
+{
+  Worker* pVictim;
+  unsigned long long ullMiddle;
+
+  pthread_mutex_lock(&pWorker->Lock);
+  if(pWorker->ullNext < pWorker->ullEnd)
+  {
+    *pullFirst = pWorker->ullNext;
+    *pullLast = pWorker->ullNext + CHUNK < pWorker->ullEnd ? pWorker->ullNext + CHUNK : pWorker->ullEnd;
+    pWorker->ullNext = *pullLast;
+    pthread_mutex_unlock(&pWorker->Lock);
+    return 1;
+  }
+  pthread_mutex_unlock(&pWorker->Lock);
+
+  for(int i = 1; i < iThreads; i++)
+  {
+    pVictim = &aWorker[(pWorker->iIndex + i) % iThreads];
+    pthread_mutex_lock(&pVictim->Lock);
+    if(pVictim->ullEnd - pVictim->ullNext > CHUNK)
+    {
+      ullMiddle = pVictim->ullNext + (pVictim->ullEnd - pVictim->ullNext) / 2;
+      pthread_mutex_lock(&pWorker->Lock);
+      pWorker->ullNext = ullMiddle;
+      pWorker->ullEnd = pVictim->ullEnd;
+      pthread_mutex_unlock(&pWorker->Lock);
+      pVictim->ullEnd = ullMiddle;
+      pthread_mutex_unlock(&pVictim->Lock);
+      return Take(pWorker, pullFirst, pullLast);
+    }
+    if(pVictim->ullNext < pVictim->ullEnd)
+    {
+      *pullFirst = pVictim->ullNext;
+      *pullLast = pVictim->ullEnd;
+      pVictim->ullNext = pVictim->ullEnd;
+      pthread_mutex_unlock(&pVictim->Lock);
+      return 1;
+    }
+    pthread_mutex_unlock(&pVictim->Lock);
+  }
+  return 0;
+
+} /* end Take */
+
+void* Worker_Run(void* pvWorker)
+{
+  Worker* pWorker = pvWorker;
+  unsigned long long ullFirst;
+  unsigned long long ullLast;
+
+  while(Take(pWorker, &ullFirst, &ullLast))
+  {
+    for(unsigned long long ull = ullFirst; ull < ullLast; ull++)
+    {
+      Clock_Run(ull, &pWorker->Stats);
+    }
+  }
+  return NULL;
+}
+
+/*------------------------------------------------------------------------------
+Function: Histogram_Merge
+
+Description: Adds histogram pFrom into pTo, both with the same bins
+*/
+void Histogram_Merge(Histogram* pTo, const Histogram* pFrom)
+{
+  for(int i = 0; i < HISTOGRAM_BINS + 2; i++)
+  {
+    pTo->aullBin[i] += pFrom->aullBin[i];
+  }
+  pTo->dSum += pFrom->dSum;
+  pTo->dSum_Squares += pFrom->dSum_Squares;
+  pTo->ullCount += pFrom->ullCount;
+
+} /* end Histogram_Merge */
+
+/*------------------------------------------------------------------------------
+Function: Percentile
+
+Description: The value below which a fraction of the histogram lies, to the nearest bin
+
+Promises: Returns the middle of the bin, or the edge of the range for the two outside ones
+*/
+double Percentile(const Histogram* pHistogram, double dFraction)
+{
+  unsigned long long ullWanted = (unsigned long long)ceil(dFraction * pHistogram->ullCount);
+  unsigned long long ullSeen = 0;
+
+  for(int i = 0; i < HISTOGRAM_BINS + 2; i++)
+  {
+    ullSeen += pHistogram->aullBin[i];
+    if(ullSeen >= ullWanted && ullSeen > 0)
+    {
+      if(i == 0)
+      {
+        return pHistogram->dLow;
+      }
+      if(i == HISTOGRAM_BINS + 1)
+      {
+        return pHistogram->dLow + HISTOGRAM_BINS * pHistogram->dWidth;
+      }
+      return pHistogram->dLow + (i - 0.5) * pHistogram->dWidth;
+    }
+  }
+  return 0;
+
+} /* end Percentile */
+
+void Histogram_Print(const char* pcName, const Histogram* pHistogram)
+{
+  double dMean = pHistogram->dSum / pHistogram->ullCount;
+  double dDeviation = sqrt(fmax(0, pHistogram->dSum_Squares / pHistogram->ullCount - dMean * dMean));
+
+  printf("%-22s %10.1f %9.1f %10.1f %10.1f %10.1f %10.1f %10.1f\n", pcName, dMean, dDeviation,
+         Percentile(pHistogram, 0.01), Percentile(pHistogram, 0.05), Percentile(pHistogram, 0.5),
+         Percentile(pHistogram, 0.95), Percentile(pHistogram, 0.99));
+}
+
+void Usage(const char* pcName)
+{
+  fprintf(stderr, "usage: %s [-n clocks] [-y years] [-j threads] [-s seed] [-p ppm] [-k fraction]"
+                  " [-o outages] [-b presses] [-w cycles]\n"
+                  "  -p  crystal tolerance, +-ppm (%.0f)\n"
+                  "  -k  fraction of clocks calibrated with the console K command (%.2f)\n"
+                  "  -o  median power cuts per year (%.0f)\n"
+                  "  -b  median button presses per day (%.0f)\n"
+                  "  -w  cycles per main loop wake on battery (%.0f)\n",
+          pcName, dPpm_Tolerance, dCalibrated, dOutages, dPresses, dWake_Cycles);
+  exit(2);
+}
+
+int main(int argc, char** argv)
+{
+  Statistics Total;
+  struct timespec Start;
+  struct timespec Stop;
+  double dSeconds;
+  unsigned long long ullShare;
+  int iOption;
+
+  while((iOption = getopt(argc, argv, "n:y:j:s:p:k:o:b:w:h")) != -1)
+  {
+    switch(iOption)
+    {
+      case 'n': ullClocks = strtoull(optarg, NULL, 0); break;
+      case 'y': dYears = atof(optarg); break;
+      case 'j': iThreads = atoi(optarg); break;
+      case 's': u64Seed = strtoull(optarg, NULL, 0); break;
+      case 'p': dPpm_Tolerance = atof(optarg); break;
+      case 'k': dCalibrated = atof(optarg); break;
+      case 'o': dOutages = atof(optarg); break;
+      case 'b': dPresses = atof(optarg); break;
+      case 'w': dWake_Cycles = atof(optarg); break;
+      default: Usage(argv[0]);
+    }
+  }
+  if(iThreads <= 0)
+  {
+    iThreads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+  }
+  if(iThreads > THREADS_MAX)
+  {
+    iThreads = THREADS_MAX;
+  }
+  if(ullClocks == 0 || dYears * DAYS_PER_YEAR < 1)
+  {
+    Usage(argv[0]);
+  }
+
+  for(int i = 0; i < DAYS_IN_SEASON_TABLE; i++)
+  {
+    adSeason[i] = sin(2 * M_PI * i / DAYS_IN_SEASON_TABLE);
+  }
+
+  /* Each thread starts with an equal range and its own histograms */
+  ullShare = (ullClocks + iThreads - 1) / iThreads;
+  for(int i = 0; i < iThreads; i++)
+  {
+    Worker* pWorker = &aWorker[i];
+
+    pthread_mutex_init(&pWorker->Lock, NULL);
+    pWorker->iIndex = i;
+    pWorker->ullNext = i * ullShare < ullClocks ? i * ullShare : ullClocks;
+    pWorker->ullEnd = (i + 1) * ullShare < ullClocks ? (i + 1) * ullShare : ullClocks;
+    Statistics_Initialize(&pWorker->Stats);
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &Start);
+  for(int i = 0; i < iThreads; i++)
+  {
+    pthread_create(&aWorker[i].Thread, NULL, Worker_Run, &aWorker[i]);
+  }
+  for(int i = 0; i < iThreads; i++)
+  {
+    pthread_join(aWorker[i].Thread, NULL);
+  }
+  clock_gettime(CLOCK_MONOTONIC, &Stop);
+  dSeconds = (Stop.tv_sec - Start.tv_sec) + (Stop.tv_nsec - Start.tv_nsec) * 1e-9;
+
+  Statistics_Initialize(&Total);
+  for(int i = 0; i < iThreads; i++)
+  {
+    Histogram_Merge(&Total.Drift, &aWorker[i].Stats.Drift);
+    Histogram_Merge(&Total.Battery_Days, &aWorker[i].Stats.Battery_Days);
+    Histogram_Merge(&Total.On_Battery, &aWorker[i].Stats.On_Battery);
+    Histogram_Merge(&Total.Wakes, &aWorker[i].Stats.Wakes);
+    Total.ullTime_Lost += aWorker[i].Stats.ullTime_Lost;
+    Total.ullCorrections += aWorker[i].Stats.ullCorrections;
+    Total.ullClocks += aWorker[i].Stats.ullClocks;
+  }
+
+  printf("%llu clocks x %.1f years on %d threads: %.2f s, %.0f clock-years/s, %zu bytes per clock\n\n",
+         Total.ullClocks, dYears, iThreads, dSeconds, Total.ullClocks * dYears / dSeconds, sizeof(Clock));
+  printf("%-22s %10s %9s %10s %10s %10s %10s %10s\n", "", "mean", "std", "p1", "p5", "p50", "p95", "p99");
+  Histogram_Print("drift s/year", &Total.Drift);
+  Histogram_Print("battery days", &Total.Battery_Days);
+  Histogram_Print("days on battery/year", &Total.On_Battery);
+  Histogram_Print("wakes/day", &Total.Wakes);
+  printf("\ntime set by the owner %.2f per clock-year, time lost to a flat battery %.4f per clock-year\n",
+         Total.ullCorrections / (Total.ullClocks * dYears), Total.ullTime_Lost / (Total.ullClocks * dYears));
+  return 0;
+}
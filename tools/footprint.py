@@ -0,0 +1,214 @@
+#!/usr/bin/env python3
+"""Flash and RAM footprint of the binary clock firmware from the IAR XLINK map file or the GNU ELF image.
+
+Reports bytes per segment (CODE, DATA16_C, DATA16_I / DATA16_ID, DATA16_Z, DATA16_N, CSTACK ...),
+per object file and per function, against the 4KB of flash and 512B of RAM of the F2122, and the
+difference from a saved baseline so a change in Update_Display_Hours or the LED tables shows at once.
+
+Both configurations in bnclk-efwd.ewp run it after linking (Build Actions, post-build), the map is
+$CONFIG_NAME$\\List\\bnclk-efwd.map when "Generate linker listing" is on, which it is for both.
+GCC/Makefile runs it on bnclk-efwd.elf the same way, with msp430-elf-size and nm (TOOLCHAIN) reading
+the sections and functions and tools/footprint-GCC.json as the baseline.  An ELF has no object files
+after -flto, so only sections and functions are reported for it.
+
+Usage:
+    footprint.py map|elf [--baseline file.json] [--save file.json] [--top n]
+
+Without --baseline only the report is printed.  --save writes the baseline for the next build,
+run it once on a known good build of each configuration, the post-build steps compare against
+tools/footprint-Debug.json (opt level low) and tools/footprint-Release.json (opt level high).
+Exits with 1 when flash or RAM is over, which fails the build.
+
+Revision History
+2026-10-19  File created
+"""
+
+import argparse
+import json
+import os
+import re
+import subprocess
+import sys
+
+FLASH_BYTES = 0xFFDE - 0xF000 + 32      # CODE and constants F000-FFDD, the vectors FFE0-FFFF
+RAM_BYTES = 512
+FLASH_SEGMENTS = ("CSTART", "CODE", "ISR_CODE", "DATA16_C", "DATA16_ID", "DIFUNCT", "INTVEC", "RESET", "NMI",
+                  "CHECKSUM")
+RAM_SEGMENTS = ("DATA16_I", "DATA16_Z", "DATA16_N", "DATA16_HEAP", "HEAP", "CSTACK")
+CODE_SEGMENTS = ("CODE", "CSTART", "ISR_CODE")
+
+SEGMENT_ROW = re.compile(r"^([A-Z_][A-Z0-9_]*)\s+(?:\S+\s+)?([0-9A-Fa-f]{4,})(?:\s+-\s+([0-9A-Fa-f]{4,}))?\s+"
+                         r"([0-9A-Fa-f]+)?\s*(rel|dse|com|stc|ovr|\?)")
+PART = re.compile(r"^\s+(Relative|Common|Absolute|Stack|Overlay)\s+segment.*?address:\s*([0-9A-Fa-f]+)\s*-\s*"
+                  r"([0-9A-Fa-f]+)\s*\((0x[0-9A-Fa-f]+|\d+)\s*bytes\)")
+ENTRY = re.compile(r"^\s{5,}([A-Za-z_?][\w?]*)\s+([0-9A-Fa-f]{4,})\b")
+
+# The sections of GCC/lnk430F2122_BLINK.ld, .data is in both as it is loaded from flash
+ELF_FLASH_SECTIONS = (".vectors", ".text", ".rodata", ".data")
+ELF_RAM_SECTIONS = (".data", ".bss", ".noinit", "CSTACK")
+TOOLCHAIN = os.environ.get("TOOLCHAIN", "msp430-elf-")
+
+
+class Footprint:
+    def __init__(self):
+        self.segments = {}     # segment -> bytes
+        self.modules = {}      # object file -> {segment: bytes}
+        self.functions = {}    # function -> bytes of code
+
+
+def parse(path):
+    footprint = Footprint()
+    section = None
+    module = None
+    segment = None
+    part = None               # [start, end, entries]
+    parts = []
+
+    with open(path, errors="replace") as f:
+        for line in f:
+            text = line.rstrip("\n")
+            if "MODULE MAP" in text:
+                section = "modules"
+                continue
+            if "SEGMENTS IN ADDRESS ORDER" in text:
+                section = "segments"
+                continue
+            if "END OF CROSS REFERENCE" in text:
+                section = None
+                continue
+
+            if section == "segments":
+                match = SEGMENT_ROW.match(text)
+                if match:
+                    name, start, end, size = match.group(1), match.group(2), match.group(3), match.group(4)
+                    if size is None:
+                        size = "0" if end is None else "%X" % (int(end, 16) - int(start, 16) + 1)
+                    footprint.segments[name] = footprint.segments.get(name, 0) + int(size, 16)
+
+            elif section == "modules":
+                if "FILE NAME :" in text:
+                    module = os.path.basename(text.split("FILE NAME :", 1)[1].strip().replace("\\", "/"))
+                    continue
+                if re.match(r"^[A-Z_][A-Z0-9_]*\s*$", text):
+                    segment = text.strip()
+                    continue
+                match = PART.match(text)
+                if match and module:
+                    size = int(match.group(4), 0)
+                    module_segments = footprint.modules.setdefault(module, {})
+                    module_segments[segment] = module_segments.get(segment, 0) + size
+                    part = [int(match.group(2), 16), int(match.group(3), 16), []]
+                    if segment in CODE_SEGMENTS:
+                        parts.append(part)
+                    continue
+                match = ENTRY.match(text)
+                if match and part is not None and segment in CODE_SEGMENTS:
+                    part[2].append((int(match.group(2), 16), match.group(1)))
+
+    # A function is its entry up to the next entry of the same segment part
+    for start, end, entries in parts:
+        entries.sort()
+        for i, (address, name) in enumerate(entries):
+            following = entries[i + 1][0] if i + 1 < len(entries) else end + 1
+            footprint.functions[name] = footprint.functions.get(name, 0) + following - address
+    return footprint
+
+
+def parse_elf(path):
+    """Sections from size -A, functions from nm, CSTACK from the linker script's __cstack symbols."""
+    footprint = Footprint()
+    sizes = subprocess.check_output([TOOLCHAIN + "size", "-A", path], universal_newlines=True)
+    for line in sizes.splitlines():
+        fields = line.split()
+        if len(fields) == 3 and fields[0].startswith(".") and fields[1].isdigit() and int(fields[1]) and \
+                fields[2] != "0":     # .debug_* and .comment are at 0, they are not in the image
+            footprint.segments[fields[0]] = int(fields[1])
+
+    symbols = {}
+    names = subprocess.check_output([TOOLCHAIN + "nm", "-S", path], universal_newlines=True)
+    for line in names.splitlines():
+        fields = line.split()
+        if len(fields) == 4 and fields[2] in "tT":
+            footprint.functions[fields[3]] = int(fields[1], 16)
+        elif len(fields) == 3:
+            symbols[fields[2]] = int(fields[0], 16)
+    if "__cstack_begin" in symbols and "__cstack_end" in symbols:
+        footprint.segments["CSTACK"] = symbols["__cstack_end"] - symbols["__cstack_begin"]
+    return footprint
+
+
+def is_elf(path):
+    with open(path, "rb") as f:
+        return f.read(4) == b"\x7fELF"
+
+
+def difference(now, then):
+    if then is None:
+        return ""
+    change = now - then
+    return "%+d" % change if change else ""
+
+
+def table(title, rows, baseline, top=None):
+    print("\n%-36s %7s %8s" % (title, "bytes", "change"))
+    shown = sorted(rows.items(), key=lambda item: -item[1])
+    if top:
+        shown = shown[:top]
+    for name, size in shown:
+        print("%-36s %7d %8s" % (name, size, difference(size, None if baseline is None else baseline.get(name, 0))))
+    if baseline is not None:
+        for name in sorted(set(baseline) - set(rows)):
+            print("%-36s %7s %8s" % (name, "gone", "%+d" % -baseline[name]))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("map")
+    parser.add_argument("--baseline", help="json saved with --save from an earlier build")
+    parser.add_argument("--save", help="write this build's footprint as a baseline")
+    parser.add_argument("--top", type=int, default=0, help="only the n largest functions")
+    arguments = parser.parse_args()
+
+    elf = is_elf(arguments.map)
+    if elf:
+        flash_segments, ram_segments = ELF_FLASH_SECTIONS, ELF_RAM_SECTIONS
+        try:
+            footprint = parse_elf(arguments.map)
+        except (OSError, subprocess.CalledProcessError) as error:
+            sys.exit("%s: %s, is %ssize on the PATH (TOOLCHAIN)?" % (arguments.map, error, TOOLCHAIN))
+    else:
+        flash_segments, ram_segments = FLASH_SEGMENTS, RAM_SEGMENTS
+        footprint = parse(arguments.map)
+        if not footprint.segments:
+            sys.exit("%s: no SEGMENTS IN ADDRESS ORDER table, is it an XLINK map with the segment map on?"
+                     % arguments.map)
+
+    baseline = None
+    if arguments.baseline and os.path.exists(arguments.baseline):
+        with open(arguments.baseline) as f:
+            baseline = json.load(f)
+    elif arguments.baseline:
+        print("no baseline %s yet, run with --save to make one" % arguments.baseline)
+
+    flash = sum(size for name, size in footprint.segments.items() if name in flash_segments)
+    ram = sum(size for name, size in footprint.segments.items() if name in ram_segments)
+    print("%s" % arguments.map)
+    print("Flash %5d of %d bytes, %d free" % (flash, FLASH_BYTES, FLASH_BYTES - flash))
+    print("RAM   %5d of %d bytes, %d free (CSTACK %d included)"
+          % (ram, RAM_BYTES, RAM_BYTES - ram, footprint.segments.get("CSTACK", 0)))
+
+    table("section" if elf else "segment", footprint.segments, baseline and baseline["segments"])
+    modules = dict((name, sum(sizes.values())) for name, sizes in footprint.modules.items())
+    if not elf:
+        table("object file", modules, baseline and baseline["modules"])
+    table("function", footprint.functions, baseline and baseline["functions"], arguments.top)
+
+    if arguments.save:
+        with open(arguments.save, "w") as f:
+            json.dump({"segments": footprint.segments, "modules": modules, "functions": footprint.functions},
+                      f, indent=1, sort_keys=True)
+    return 1 if flash > FLASH_BYTES or ram > RAM_BYTES else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
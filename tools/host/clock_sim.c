@@ -0,0 +1,302 @@
+/**********************************************************************
+* Timed simulation of one clock running the firmware
+
+Runs the host build of the firmware from a power on reset for a number of days against the
+timer model of sim.c, and reports what it did: wakes, against the Timer A ticks the main loop was
+woken on before button 0 had its edge interrupt, interrupts and the estimated time awake.
+With -o the run is written as a trace (trace.h) for trace_vcd and the other trace tools.
+
+The owner presses button 1 once, 2s after the reset, to leave ClockSM_Start, which makes it
+12:01.  The power can be cut every day with -c, from 03:00 of the simulated day for the minutes given.
+With -s the inputs and the crystal come from a scenario file instead (scenario.h); the days of -d
+are still the clock's own, counted on its ACLK, and the scenario's times are real time.
+
+-r records the run's inputs, with a checkpoint every -k seconds, and -p replays a recording
+(replay.h) to its end or for -d days, from the last checkpoint before -f seconds if it is given.
+A replay compares the checkpoints it passes with the recording and exits 1 if the run differs.
+
+Build:   make clock_sim
+Use:     clock_sim [-d days] [-o trace] [-i index_seconds] [-c outage_minutes | -s scenario]
+                   [-r recording [-k checkpoint_seconds] | -p recording [-f from_seconds]]
+         clock_sim -d 365 -o year.trace
+         clock_sim -d 365 -s scenarios/year.scenario -r year.replay
+         clock_sim -p year.replay -f 31000000 -o end.trace
+**********************************************************************/
+
+/************************ Revision History ****************************
+YYYY-MM-DD  Comments
+-------------------------------------------------------------------------------------------
+2026-10-19  File created
+
+************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include "sim.h"
+#include "scenario.h"
+#include "replay.h"
+#include "bnclk-efwd-01.h"
+
+#define COUNTS_PER_MINUTE      (60ULL * TRACE_ACLK_HZ)
+#define COUNTS_PER_DAY         (1440ULL * COUNTS_PER_MINUTE)
+#define OUTAGE_START           (3 * 60 * COUNTS_PER_MINUTE)
+#define START_PRESS            (2 * TRACE_ACLK_HZ)
+#define START_RELEASE          (START_PRESS + TRACE_ACLK_HZ / 5)
+
+/* Options */
+double dDays = 1;
+const char* pcTrace = NULL;
+double dIndex_Seconds = TRACE_INTERVAL_DEFAULT / TRACE_ACLK_HZ;
+u32 u32Outage_Minutes = 0;
+const char* pcScenario = NULL;
+const char* pcRecord = NULL;
+const char* pcPlay = NULL;
+double dCheckpoint_Seconds = REPLAY_INTERVAL_DEFAULT / TRACE_ACLK_HZ;
+double dFrom = -1;
+
+/* The inputs, see Owner_Input */
+u8 u8Presses = 0;
+u64 u64Outage_Day = 0;
+bool bOutage_Off = FALSE;
+
+/*------------------------------------------------------------------------------
+Function: Owner_Input
+
+Description: fnSim_Input_type, the press of button 1 that starts the clock then, with -c, the power
+going at OUTAGE_START of each day and coming back u32Outage_Minutes later
+
+Promises: Returns the next change, FALSE when there are no more
+*/
+bool Owner_Input(SimInput* pInput)
+{
+  pInput->u8P2IN = SIM_PINS_IDLE_P2;
+  pInput->u8P3IN = SIM_PINS_IDLE_P3;
+  if(u8Presses < 2)
+  {
+    pInput->u64Time = u8Presses ? START_RELEASE : START_PRESS;
+    pInput->u8P3IN = u8Presses ? SIM_PINS_IDLE_P3 : SIM_PINS_IDLE_P3 & ~P3_7_BUTTON_1;
+    u8Presses++;
+    return TRUE;
+  }
+  if(u32Outage_Minutes == 0)
+  {
+    return FALSE;
+  }
+  if(!bOutage_Off)
+  {
+    pInput->u64Time = u64Outage_Day * COUNTS_PER_DAY + OUTAGE_START;
+    pInput->u8P2IN = SIM_PINS_IDLE_P2 & ~P2_5_LOST_POWER_IND;
+  }
+  else
+  {
+    pInput->u64Time = u64Outage_Day * COUNTS_PER_DAY + OUTAGE_START + u32Outage_Minutes * COUNTS_PER_MINUTE;
+    u64Outage_Day++;
+  }
+  bOutage_Off = !bOutage_Off;
+  return TRUE;
+
+} /* end Owner_Input */
+
+/*------------------------------------------------------------------------------
+Function: Seconds
+
+Description: Wall clock time
+
+Promises: Returns seconds from an arbitrary start
+*/
+double Seconds(void)
+{
+  struct timespec sNow;
+
+  clock_gettime(CLOCK_MONOTONIC, &sNow);
+  return sNow.tv_sec + sNow.tv_nsec * 1e-9;
+
+} /* end Seconds */
+
+int main(int argc, char** argv)
+{
+  int iOption;
+  TraceWriter sWriter;
+  TraceState sStart;
+  u64 u64End;
+  double dStart;
+  double dWall;
+  double dSimulated;
+  u64 u64Records;
+  u64 u64Entries;
+  FILE* pFile;
+  long lBytes;
+  Scenario sScenario;
+  Replay sReplay;
+  u64 u64Interval = 0;
+  u64 u64Slice;
+  u64 u64Begin;
+  bool bDays = FALSE;
+
+  while((iOption = getopt(argc, argv, "d:o:i:c:s:r:p:k:f:")) != -1)
+  {
+    switch(iOption)
+    {
+      case 'd': dDays = atof(optarg); bDays = TRUE; break;
+      case 'o': pcTrace = optarg; break;
+      case 'i': dIndex_Seconds = atof(optarg); break;
+      case 'c': u32Outage_Minutes = (u32)atol(optarg); break;
+      case 's': pcScenario = optarg; break;
+      case 'r': pcRecord = optarg; break;
+      case 'p': pcPlay = optarg; break;
+      case 'k': dCheckpoint_Seconds = atof(optarg); break;
+      case 'f': dFrom = atof(optarg); break;
+      default:
+        fprintf(stderr, "usage: %s [-d days] [-o trace] [-i index_seconds] [-c outage_minutes | -s scenario]\n"
+                        "       [-r recording [-k checkpoint_seconds] | -p recording [-f from_seconds]]\n", argv[0]);
+        return 2;
+    }
+  }
+  if(dDays <= 0 || dIndex_Seconds * TRACE_ACLK_HZ < 1 || u32Outage_Minutes >= 1440 - 180 ||
+     dCheckpoint_Seconds * TRACE_ACLK_HZ < 1)
+  {
+    fprintf(stderr, "days and the index and checkpoint intervals must be more than 0, an outage must end the day it starts\n");
+    return 2;
+  }
+  if(pcPlay && (pcScenario || u32Outage_Minutes || pcRecord))
+  {
+    fprintf(stderr, "-p replays the inputs of the recording, without -c, -s or -r\n");
+    return 2;
+  }
+  if(pcScenario && u32Outage_Minutes)
+  {
+    fprintf(stderr, "-c and -s do not go together, a scenario has its own outages\n");
+    return 2;
+  }
+  if(pcScenario && !Scenario_Open(&sScenario, pcScenario))
+  {
+    return 2;
+  }
+  u64End = (u64)(dDays * COUNTS_PER_DAY);
+
+  if(pcRecord)
+  {
+    if(!Replay_Create(&sReplay, pcRecord, pcScenario ? Scenario_Input : Owner_Input,
+                      (u64)(dCheckpoint_Seconds * TRACE_ACLK_HZ)))
+    {
+      perror(pcRecord);
+      return 2;
+    }
+    Sim_Reset(Replay_Input);
+    u64Interval = sReplay.sHeader.u64Interval;
+  }
+  else if(pcPlay)
+  {
+    if(!Replay_Open(&sReplay, pcPlay))
+    {
+      return 2;
+    }
+    Sim_Reset(Replay_Input);
+    if(dFrom >= 0 && !Replay_Seek(&sReplay, (u64)(dFrom * TRACE_ACLK_HZ)))
+    {
+      fprintf(stderr, "%s: cannot start from a checkpoint of it\n", pcPlay);
+      return 2;
+    }
+    u64Interval = sReplay.sHeader.u64Interval;
+    if(!bDays)
+    {
+      u64End = sReplay.sHeader.u64End_Time;
+    }
+  }
+  else
+  {
+    Sim_Reset(pcScenario ? Scenario_Input : Owner_Input);
+  }
+  u64Begin = GG_u64Sim_Time;
+  if(pcTrace)
+  {
+    Sim_State(&sStart);
+    if(!Trace_Create(&sWriter, pcTrace, (u64)(dIndex_Seconds * TRACE_ACLK_HZ), &sStart))
+    {
+      perror(pcTrace);
+      return 2;
+    }
+    GG_pSim_Trace = &sWriter;
+  }
+
+  /* A recording and its replays stop for the checkpoints at the same times */
+  dStart = Seconds();
+  if(u64Interval)
+  {
+    for(u64Slice = (sReplay.u64Checkpoint + 1) * u64Interval; u64Slice <= u64End; u64Slice += u64Interval)
+    {
+      Sim_Run(u64Slice);
+      Replay_Checkpoint(&sReplay);
+    }
+  }
+  Sim_Run(u64End);
+  dWall = Seconds() - dStart;
+  dSimulated = (double)(GG_u64Sim_Time - u64Begin) / TRACE_ACLK_HZ;
+  if(pcScenario)
+  {
+    Scenario_Close(&sScenario);
+    if(sScenario.bError)
+    {
+      return 2;
+    }
+  }
+
+  printf("%.2f days simulated in %.2f s, %.0f simulated seconds a second\n", dSimulated / 86400, dWall,
+         dSimulated / (dWall > 0 ? dWall : 1e-9));
+  if(u64Begin)
+  {
+    printf("from the checkpoint at %.3f s\n", (double)u64Begin / TRACE_ACLK_HZ);
+  }
+  printf("%llu wakes, %llu interrupts, %llu function entries\n", GG_sSim.u64Wakes, GG_sSim.u64Interrupts, GG_sSim.u64Calls);
+  printf("%llu Timer A ticks, %.3f wakes a tick, the old Poll_Buttons woke the main loop on every tick\n",
+         GG_u64Sim_Time / TIMERA_PERIOD, (double)GG_sSim.u64Wakes * TIMERA_PERIOD / GG_u64Sim_Time);
+  printf("awake %.4f%% of the time, %.0f cycles a wake, %.1f cycles a minute (estimated, %d a call)\n",
+         100.0 * GG_sSim.u64Awake_Cycles / GG_u64Sim_Time,
+         GG_sSim.u64Wakes ? (double)GG_sSim.u64Awake_Cycles / GG_sSim.u64Wakes : 0.0,
+         (double)GG_sSim.u64Awake_Cycles * COUNTS_PER_MINUTE / GG_u64Sim_Time, SIM_CALL_CYCLES);
+  if(pcTrace)
+  {
+    GG_pSim_Trace = NULL;
+    u64Records = sWriter.sHeader.u64Records;
+    u64Entries = sWriter.sHeader.u64Index_Entries;
+    if(!Trace_Close(&sWriter, GG_u64Sim_Time))
+    {
+      perror(pcTrace);
+      return 2;
+    }
+    pFile = fopen(pcTrace, "rb");
+    fseek(pFile, 0, SEEK_END);
+    lBytes = ftell(pFile);
+    fclose(pFile);
+    printf("%s: %llu records, %llu index entries, %ld bytes, %.1f bytes a simulated second\n", pcTrace,
+           u64Records, u64Entries, lBytes, lBytes / dSimulated);
+  }
+  if(pcRecord)
+  {
+    if(!Replay_Close(&sReplay, GG_u64Sim_Time))
+    {
+      perror(pcRecord);
+      return 2;
+    }
+    pFile = fopen(pcRecord, "rb");
+    fseek(pFile, 0, SEEK_END);
+    lBytes = ftell(pFile);
+    fclose(pFile);
+    printf("%s: %llu inputs, %llu checkpoints, %ld bytes\n", pcRecord, sReplay.sHeader.u64Inputs,
+           sReplay.sHeader.u64Checkpoints, lBytes);
+  }
+  if(pcPlay)
+  {
+    printf("%s: %llu checkpoints passed were the same as the recording%s\n", pcPlay, sReplay.u64Matched,
+           sReplay.bDiverged ? ", the run then differed" : "");
+    Replay_Close(&sReplay, 0);
+    if(sReplay.bDiverged)
+    {
+      return 1;
+    }
+  }
+  return 0;
+
+} /* end main */
@@ -0,0 +1,292 @@
+/**********************************************************************
+* Check of the UART console protocol through a Linux pseudo terminal
+
+The firmware on the host is the far end of a pty, as the clock is the far end of a USB serial
+adapter: bytes a program writes to the pty's terminal side go to USCIRxISR one at a time, the main
+loop is run whenever they wake it, and what USCITxISR sends comes back out of the terminal side.
+The checks talk to the terminal side like a person at a terminal would and compare the replies:
+  - T, D and K setting the time, the date and the calibration, and reading them back
+  - malformed lines: an unknown command, values out of range (years outside 2000 to 2199 among them),
+    too few numbers
+  - a line longer than the receive ring with no room for its line end, which must be dropped
+    whole without losing the lines after it, and counted in the C command's lost bytes
+The clock is put straight into MODE_CONSOLE, as button 0 leaves it after stepping through the modes.
+
+With -i the pty is left open for a terminal program instead, e.g. screen /dev/pts/3, until ^C.
+
+Build:   make console_check
+Use:     console_check              prints each exchange that is wrong, exits 1 on any
+         console_check -i           prints the pty to open and bridges it to the firmware
+**********************************************************************/
+
+/************************ Revision History ****************************
+YYYY-MM-DD  Comments
+-------------------------------------------------------------------------------------------
+2026-10-19  File created
+
+************************************************************************/
+
+#define _GNU_SOURCE
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+#include "host.h"
+#include "bnclk-efwd-01.h"
+#include "alarm.h"
+#include "console.h"
+#include "main.h"
+
+/******************** External Globals ************************/
+extern fnCode_type GG_fpCLOCKSM;                /* From bnclk-efwd-01.c */
+extern u8 LG_u8Mode;                            /* From bnclk-efwd-01.c */
+extern volatile u8 LG_u8Console_Tx_Tail;        /* From console.c */
+
+#define CONSOLE_CHECK_WAIT_MS  200       /* for the bytes written to one side of the pty to reach the other */
+#define CONSOLE_CHECK_REPLY    256
+
+int iDevice = -1;                        //the pty master, the clock's end
+int iTerminal = -1;                      //the pty slave, the end a person or the checks use
+long lFailures = 0;
+
+/*------------------------------------------------------------------------------
+Function: Pty_Open
+
+Description: A pty with both ends raw, so CR and LF go through as they are
+
+Promises: iDevice and iTerminal are open, returns the terminal side's name or NULL
+*/
+const char* Pty_Open(bool bOpen_Terminal)
+{
+  struct termios sTermios;
+  const char* pcName;
+
+  iDevice = posix_openpt(O_RDWR | O_NOCTTY);
+  if(iDevice < 0 || grantpt(iDevice) != 0 || unlockpt(iDevice) != 0 || (pcName = ptsname(iDevice)) == NULL)
+  {
+    perror("console_check: pty");
+    return NULL;
+  }
+  iTerminal = open(pcName, O_RDWR | O_NOCTTY);
+  if(iTerminal < 0 || tcgetattr(iTerminal, &sTermios) != 0)
+  {
+    perror(pcName);
+    return NULL;
+  }
+  cfmakeraw(&sTermios);
+  cfsetispeed(&sTermios, B9600);
+  cfsetospeed(&sTermios, B9600);
+  tcsetattr(iTerminal, TCSANOW, &sTermios);
+  fcntl(iDevice, F_SETFL, O_NONBLOCK);
+  if(!bOpen_Terminal)
+  {
+    close(iTerminal);                    //a terminal program opens it, the master reads EIO until then
+    iTerminal = -1;
+  }
+  return pcName;
+
+} /* end Pty_Open */
+
+/*------------------------------------------------------------------------------
+Function: Firmware_Send
+
+Description: Runs USCITxISR while the firmware has bytes queued, as the UART does when UCA0TXIFG is set
+
+Promises: Every byte sent is written to the pty
+*/
+void Firmware_Send(void)
+{
+  u8 u8Tail;
+  u8 u8Byte;
+
+  while(IE2 & UCA0TXIE)
+  {
+    u8Tail = LG_u8Console_Tx_Tail;
+    IFG2 |= UCA0TXIFG;
+    Host_Interrupt(USCITxISR);
+    if(LG_u8Console_Tx_Tail != u8Tail)
+    {
+      u8Byte = UCA0TXBUF;
+      if(write(iDevice, &u8Byte, 1) != 1)
+      {
+        perror("console_check: pty");
+        exit(2);
+      }
+    }
+  }
+
+} /* end Firmware_Send */
+
+/*------------------------------------------------------------------------------
+Function: Firmware_Pump
+
+Description: Delivers the bytes waiting on the clock's end of the pty to USCIRxISR, running the main
+loop when one wakes it and sending its replies
+
+Requires: iWait_Ms is how long to wait for the first byte
+
+Promises: Returns the bytes delivered, -1 when the terminal side has closed
+*/
+long Firmware_Pump(int iWait_Ms)
+{
+  struct pollfd sPoll = {iDevice, POLLIN, 0};
+  u8 u8Byte;
+  long lBytes = 0;
+  ssize_t iRead;
+
+  if(poll(&sPoll, 1, iWait_Ms) <= 0)
+  {
+    return 0;
+  }
+  while((iRead = read(iDevice, &u8Byte, 1)) == 1)
+  {
+    UCA0RXBUF = u8Byte;
+    Host_Interrupt(USCIRxISR);
+    if(!Host_Asleep())
+    {
+      Host_Run();
+    }
+    Firmware_Send();
+    lBytes++;
+  }
+  return (iRead < 0 && lBytes == 0 && (sPoll.revents & POLLHUP)) ? -1 : lBytes;
+
+} /* end Firmware_Pump */
+
+/*------------------------------------------------------------------------------
+Function: Exchange
+
+Description: Writes text to the terminal side, lets the firmware handle it and reads what comes back
+
+Promises: Counts and prints a failure if the reply is not pcWant
+*/
+void Exchange(const char* pcSend, const char* pcWant)
+{
+  char acReply[CONSOLE_CHECK_REPLY];
+  size_t iLength = 0;
+  ssize_t iRead;
+  struct pollfd sPoll = {0, POLLIN, 0};
+
+  if(write(iTerminal, pcSend, strlen(pcSend)) != (ssize_t)strlen(pcSend))
+  {
+    perror("console_check: pty");
+    exit(2);
+  }
+  while(Firmware_Pump(CONSOLE_CHECK_WAIT_MS) > 0)
+  {
+  }
+
+  sPoll.fd = iTerminal;
+  while(iLength < sizeof(acReply) - 1 && poll(&sPoll, 1, CONSOLE_CHECK_WAIT_MS) > 0)
+  {
+    iRead = read(iTerminal, &acReply[iLength], sizeof(acReply) - 1 - iLength);
+    if(iRead <= 0)
+    {
+      break;
+    }
+    iLength += iRead;
+  }
+  acReply[iLength] = 0;
+
+  if(strcmp(acReply, pcWant) != 0)
+  {
+    lFailures++;
+    printf("sent ");
+    for(const char* pc = pcSend; *pc; pc++)
+    {
+      printf(*pc == '\r' ? "\\r" : *pc == '\n' ? "\\n" : "%c", *pc);
+    }
+    printf("\n  got  ");
+    for(const char* pc = acReply; *pc; pc++)
+    {
+      printf(*pc == '\r' ? "\\r" : *pc == '\n' ? "\\n" : "%c", *pc);
+    }
+    printf("\n  want ");
+    for(const char* pc = pcWant; *pc; pc++)
+    {
+      printf(*pc == '\r' ? "\\r" : *pc == '\n' ? "\\n" : "%c", *pc);
+    }
+    printf("\n");
+  }
+
+} /* end Exchange */
+
+int main(int argc, char** argv)
+{
+  bool bInteractive = (argc > 1 && strcmp(argv[1], "-i") == 0);
+  const char* pcName;
+  char acLong[3 * CONSOLE_RX_SIZE + 2];
+  long lExchanges = 0;
+
+  Host_Reset();
+  Host_Run();                            //ClockSM_Start, asleep flashing 12:00
+  GG_fpCLOCKSM = ClockSM_Tick;
+  LG_u8Mode = MODE_CONSOLE;
+  Console_On();
+
+  pcName = Pty_Open(!bInteractive);
+  if(pcName == NULL)
+  {
+    return 2;
+  }
+  if(bInteractive)
+  {
+    printf("console on %s, 9600 8N1, ^C to stop\n", pcName);
+    fflush(stdout);
+    while(1)
+    {
+      Firmware_Pump(-1);
+    }
+  }
+
+#define EXCHANGE(send, want)  (Exchange(send, want), lExchanges++)
+  /* Setting and reading back, the time does not move on while the check runs */
+  EXCHANGE("T 13:45:30\r", "T 13:45:30\r\n");
+  EXCHANGE("T\r", "T 13:45:30\r\n");
+  EXCHANGE("T 00:00:00\r\n", "T 00:00:00\r\n");               //the LF of a CR LF is an empty line
+  EXCHANGE("T 23:59:59\r", "T 23:59:59\r\n");
+  EXCHANGE("D 2000-02-29\r", "D 2000-02-29\r\n");               //the ends of CALENDAR_YEAR_FIRST to _LAST
+  EXCHANGE("D 2199-12-31\r", "D 2199-12-31\r\n");
+  EXCHANGE("D 2028-02-29\r", "D 2028-02-29\r\n");
+  EXCHANGE("D\r", "D 2028-02-29\r\n");
+  EXCHANGE("K -5\r", "K -5\r\n");
+  EXCHANGE("K 127\r", "K 127\r\n");
+  EXCHANGE("K\r", "K 127\r\n");
+  EXCHANGE("K 0\r", "K 0\r\n");
+  EXCHANGE("T\rD\r", "T 23:59:59\r\nD 2028-02-29\r\n");      //two lines in one wake
+
+  /* Malformed lines are answered with '?' and change nothing */
+  EXCHANGE("X\r", "X?\r\n");
+  EXCHANGE("T 24:00:00\r", "T?\r\n");
+  EXCHANGE("T 12:60\r", "T?\r\n");
+  EXCHANGE("T 1:2:3:4\r", "T?\r\n");
+  EXCHANGE("D 2027-02-29\r", "D?\r\n");
+  EXCHANGE("D 2027-13-01\r", "D?\r\n");
+  EXCHANGE("D 1999-12-31\r", "D?\r\n");                      //years outside CALENDAR_YEAR_FIRST to _LAST
+  EXCHANGE("D 2200-01-01\r", "D?\r\n");
+  EXCHANGE("D 0-01-01\r", "D?\r\n");
+  EXCHANGE("D 30000-01-01\r", "D?\r\n");                     //was stored as century 44
+  EXCHANGE("K 128\r", "K?\r\n");
+  EXCHANGE("K -128\r", "K?\r\n");
+  EXCHANGE("T\r", "T 23:59:59\r\n");
+  EXCHANGE("D\r", "D 2028-02-29\r\n");
+  EXCHANGE("\r\n\r\n", "");
+
+  /* A line longer than the ring is dropped up to its line end, the console keeps working after it */
+  memset(acLong, 'Z', sizeof(acLong) - 2);
+  acLong[sizeof(acLong) - 2] = '\r';
+  acLong[sizeof(acLong) - 1] = 0;
+  EXCHANGE(acLong, "");
+  EXCHANGE("T\r", "T 23:59:59\r\n");
+  acLong[sizeof(acLong) - 2] = 0;
+  EXCHANGE(acLong, "");                                       //no line end yet
+  EXCHANGE("\rK\r", "K 0\r\n");
+  EXCHANGE("C\r", "C 0 98\r\n");                              //Timer A has not ticked, the Z lines lost with their line ends
+
+  printf("console on a pty: %ld exchanges, %ld wrong\n", lExchanges, lFailures);
+  return lFailures != 0;
+
+} /* end main */
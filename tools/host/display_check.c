@@ -0,0 +1,461 @@
+/**********************************************************************
+* Exhaustive check of the time and display logic
+
+Runs the firmware's own Time_Rollover, ClockSM_Button_Press and Update_Display (with
+Update_Display_Hours, Update_Display_AMPM, LedOn and LedOff when CUSTOM_CODE_ENABLED) on the host
+for every hour, minute and AM/PM, and for each one every input that changes the time:
+  - the minute rolling over, as ClockSM_Tick does it
+  - button 1 at each auto-repeat speed, stepping the minute by 1, 5 and 15
+  - button 2, stepping the hour
+The port images after each step are compared with a reference model of the LED wiring,
+with the other port pins set and cleared beforehand so a pin that is left alone or driven
+when it should not be shows up.  LedOn and LedOff are also checked on their own for every
+display LED, as other code calls them too.  The build's CLOCK_24_HOUR variant is the one checked.
+With CALENDAR_ENABLED, Calendar_Midnight is run over every midnight of a century, 2000-01-01 to
+2101-01-01, against the C library's calendar, with Weekday_Update recalculating the weekday it
+counted on, and the midnights are counted by the path they take.  Counted from the LLVM build's
+image (tools/msp430.py) the paths are 38 to 44 cycles for a day, 51 to 57 for the end of a month,
+83 to 84 for the end of a year and 91 to 92 for the end of a century, the RET included.
+tools/camper_grade.py links it with a camper's Time_Rollover, Update_Display, LedOn and LedOff.
+
+Build:   make display_check
+Use:     display_check              prints the cases checked and the first mismatches, exits 1 on any
+**********************************************************************/
+
+/************************ Revision History ****************************
+YYYY-MM-DD  Comments
+-------------------------------------------------------------------------------------------
+2026-10-19  File created
+
+************************************************************************/
+
+#include <stdio.h>
+#include <time.h>
+#include "host.h"
+#include "bnclk-efwd-01.h"
+#include "leds.h"
+#include "calendar.h"
+
+/******************** External Globals ************************/
+extern u8 LG_u8Minute_Counter;                  /* From bnclk-efwd-01.c */
+extern u8 LG_u8Hour_Counter;                    /* From bnclk-efwd-01.c */
+#if !CLOCK_24_HOUR
+extern u8 LG_u8PM;                              /* From bnclk-efwd-01.c */
+#endif
+extern u8 LG_u8Button_Active;                   /* From bnclk-efwd-01.c */
+extern u8 LG_u8Repeat_Count;                    /* From bnclk-efwd-01.c */
+extern u8 LG_u8Mode;                            /* From bnclk-efwd-01.c */
+extern int GG_u8Second_Counter;                 /* From bnclk-efwd-01.c */
+extern u8 GG_u8Alarm_Ringing;                   /* From alarm.c */
+extern LedInformation LG_aLedInfoHourLeds[];     /* From bnclk-efwd-01.c */
+extern LedInformation LG_aLedInfoMinuteLeds[];   /* From bnclk-efwd-01.c */
+#if !CLOCK_24_HOUR
+extern LedInformation LG_LedInfoPMLed;          /* From bnclk-efwd-01.c */
+#endif
+
+#define PORT1_LEDS             (u8)(~Port1_Clear_Mask)
+#define PORT2_LEDS             (u8)(~Port2_Clear_Mask)
+#define PORT3_LEDS             (u8)(~Port3_Clear_Mask)
+
+#if CLOCK_24_HOUR
+#define HOUR_FIRST             0
+#define HOUR_LAST              23
+#define PM_LAST                0
+#else
+#define HOUR_FIRST             1
+#define HOUR_LAST              12
+#define PM_LAST                1
+#endif
+
+#define MISMATCHES_SHOWN       10
+
+#define CENTURY_FIRST          2000      /* Calendar_Midnight is checked from 1 January of this year */
+#define CENTURY_YEARS          101       /* to 1 January this many years later, 2100 is not a leap year */
+
+typedef enum {STEP_DISPLAY, STEP_MINUTE, STEP_BUTTON_1_BY_1, STEP_BUTTON_1_BY_5, STEP_BUTTON_1_BY_15,
+              STEP_BUTTON_2, STEPS} Step;
+
+const char* apcStep_Name[STEPS] = {"display", "minute", "button 1 by 1", "button 1 by 5", "button 1 by 15",
+                                   "button 2"};
+
+typedef struct
+{
+  u8 u8Hour;
+  u8 u8Minute;
+  u8 u8PM;
+} Time;
+
+long lMismatches = 0;
+
+/*------------------------------------------------------------------------------
+Function: Reference_Step
+
+Description: What a step should do to the time.  The minute wraps into the hour, the hour from
+12 to 1 (turning AM/PM over on the way into 12) or from 23 to 0 in the 24 hour variant.
+
+Promises: Returns the time after the step
+*/
+Time Reference_Step(Time sTime, Step eStep)
+{
+  u8 u8By = 1;
+  bool bNext_Hour = FALSE;
+
+  switch(eStep)
+  {
+    case STEP_BUTTON_2:
+      sTime.u8Hour++;
+      bNext_Hour = TRUE;
+      break;
+
+    case STEP_BUTTON_1_BY_15:
+      u8By = 15;
+      sTime.u8Minute = (sTime.u8Minute / u8By + 1) * u8By;
+      break;
+
+    case STEP_BUTTON_1_BY_5:
+      u8By = 5;
+      sTime.u8Minute = (sTime.u8Minute / u8By + 1) * u8By;
+      break;
+
+    case STEP_MINUTE:
+    case STEP_BUTTON_1_BY_1:
+      sTime.u8Minute++;
+      break;
+
+    default:
+      return sTime;
+  }
+
+  if(sTime.u8Minute >= 60)
+  {
+    sTime.u8Minute -= 60;
+    sTime.u8Hour++;
+    bNext_Hour = TRUE;
+  }
+#if CLOCK_24_HOUR
+  if(sTime.u8Hour == 24 && bNext_Hour)
+  {
+    sTime.u8Hour = 0;
+  }
+#else
+  if(sTime.u8Hour == 12 && bNext_Hour)
+  {
+    sTime.u8PM = !sTime.u8PM;
+  }
+  if(sTime.u8Hour == 13)
+  {
+    sTime.u8Hour = 1;
+  }
+#endif
+  return sTime;
+
+} /* end Reference_Step */
+
+/*------------------------------------------------------------------------------
+Function: Reference_Ports
+
+Description: The LED pins of each port for a time, from the schematic:
+P1 is x x x x m0 m1 m2 m3, P2 is x x x m4 m5 h3 x x, P3 is x PM x x x h0 h1 h2.
+The 24 hour variant shows hours 16 - 23 on the PM LED.
+
+Promises: au8Port[0..2] are the P1OUT, P2OUT and P3OUT LED bits
+*/
+void Reference_Ports(Time sTime, u8* au8Port)
+{
+  u8 u8Hour = sTime.u8Hour;
+  u8 u8Minute = sTime.u8Minute;
+  u8 u8PM = sTime.u8PM;
+
+#if CLOCK_24_HOUR
+  u8PM = u8Hour >> 4;
+  u8Hour &= 0x0F;
+#endif
+  au8Port[0] = (u8Minute & 0x01 ? P1_3_MINUTE_0 : 0) | (u8Minute & 0x02 ? P1_2_MINUTE_1 : 0) |
+               (u8Minute & 0x04 ? P1_1_MINUTE_2 : 0) | (u8Minute & 0x08 ? P1_0_MINUTE_3 : 0);
+  au8Port[1] = (u8Minute & 0x10 ? P2_4_MINUTE_4 : 0) | (u8Minute & 0x20 ? P2_3_MINUTE_5 : 0) |
+               (u8Hour & 0x08 ? P2_2_HOUR_3 : 0);
+  au8Port[2] = (u8Hour & 0x01 ? P3_2_HOUR_0 : 0) | (u8Hour & 0x02 ? P3_1_HOUR_1 : 0) |
+               (u8Hour & 0x04 ? P3_0_HOUR_2 : 0) | (u8PM ? P3_5_POMI_PM_IND : 0);
+
+} /* end Reference_Ports */
+
+/*------------------------------------------------------------------------------
+Function: Firmware_Step
+
+Description: Sets the firmware's time and runs the step through its own functions, the
+buttons through ClockSM_Button_Press with the pin held down like Poll_Buttons left it
+
+Promises: Returns the firmware's time after the step, the ports are what it drove
+*/
+Time Firmware_Step(Time sTime, Step eStep)
+{
+  LG_u8Hour_Counter = sTime.u8Hour;
+  LG_u8Minute_Counter = sTime.u8Minute;
+#if !CLOCK_24_HOUR
+  LG_u8PM = sTime.u8PM;
+#endif
+  LG_u8Mode = MODE_CLOCK;
+  GG_u8Alarm_Ringing = 0;
+  Host_Pins(P2_5_LOST_POWER_IND | P2_1_BUTTON_0, P3_6_BUTTON_2 | P3_7_BUTTON_1);
+
+  switch(eStep)
+  {
+    case STEP_DISPLAY:
+      Update_Display();
+      break;
+
+    case STEP_MINUTE:
+      LG_u8Minute_Counter++;
+      Time_Rollover();
+      Update_Display();
+      break;
+
+    case STEP_BUTTON_2:
+      LG_u8Button_Active = P3_6_BUTTON_2;
+      LG_u8Repeat_Count = 0;
+      Host_Pins(P2_5_LOST_POWER_IND | P2_1_BUTTON_0, P3_7_BUTTON_1);
+      ClockSM_Button_Press();
+      break;
+
+    default:
+      LG_u8Button_Active = P3_7_BUTTON_1;
+      LG_u8Repeat_Count = eStep == STEP_BUTTON_1_BY_1 ? 0 :
+                          eStep == STEP_BUTTON_1_BY_5 ? REPEAT_STEPS_OF_1 : REPEAT_STEPS_OF_5;
+      Host_Pins(P2_5_LOST_POWER_IND | P2_1_BUTTON_0, P3_6_BUTTON_2);
+      ClockSM_Button_Press();
+      break;
+  }
+
+  sTime.u8Hour = LG_u8Hour_Counter;
+  sTime.u8Minute = LG_u8Minute_Counter;
+#if !CLOCK_24_HOUR
+  sTime.u8PM = LG_u8PM;
+#endif
+  return sTime;
+
+} /* end Firmware_Step */
+
+/*------------------------------------------------------------------------------
+Function: Check
+
+Description: One step from one time, with the other pins of every port all clear or all set first
+
+Promises: Prints the first MISMATCHES_SHOWN mismatches and counts them all
+*/
+void Check(Time sTime, Step eStep, u8 u8Other_Pins)
+{
+  Time sExpected = Reference_Step(sTime, eStep);
+  Time sActual;
+  u8 au8Expected[3];
+  u8 au8Actual[3];
+  u8 au8Leds[3] = {PORT1_LEDS, PORT2_LEDS, PORT3_LEDS};
+  int iBad;
+
+  /* The LEDs start as the complement of what they should end up as */
+  Reference_Ports(sExpected, au8Expected);
+  P1OUT = (u8Other_Pins & ~PORT1_LEDS) | (~au8Expected[0] & PORT1_LEDS);
+  P2OUT = (u8Other_Pins & ~PORT2_LEDS) | (~au8Expected[1] & PORT2_LEDS);
+  P3OUT = (u8Other_Pins & ~PORT3_LEDS) | (~au8Expected[2] & PORT3_LEDS);
+
+  sActual = Firmware_Step(sTime, eStep);
+  au8Actual[0] = P1OUT;
+  au8Actual[1] = P2OUT;
+  au8Actual[2] = P3OUT;
+
+  iBad = sActual.u8Hour != sExpected.u8Hour || sActual.u8Minute != sExpected.u8Minute ||
+         sActual.u8PM != sExpected.u8PM;
+  for(int i = 0; i < 3; i++)
+  {
+    au8Expected[i] |= u8Other_Pins & ~au8Leds[i];
+    if(i == 2)
+    {
+      au8Expected[i] = (au8Expected[i] & ~P3_4_PIMO_TICK) | (au8Actual[i] & P3_4_PIMO_TICK);   //the TICK LED is not the display's
+    }
+    iBad |= au8Actual[i] != au8Expected[i];
+  }
+  if(!iBad)
+  {
+    return;
+  }
+  if(lMismatches++ < MISMATCHES_SHOWN)
+  {
+    printf("%2u:%02u %s  %-15s  time %2u:%02u %s want %2u:%02u %s  ports %02X %02X %02X want %02X %02X %02X\n",
+           sTime.u8Hour, sTime.u8Minute, sTime.u8PM ? "PM" : "AM", apcStep_Name[eStep],
+           sActual.u8Hour, sActual.u8Minute, sActual.u8PM ? "PM" : "AM",
+           sExpected.u8Hour, sExpected.u8Minute, sExpected.u8PM ? "PM" : "AM",
+           au8Actual[0], au8Actual[1], au8Actual[2], au8Expected[0], au8Expected[1], au8Expected[2]);
+  }
+
+} /* end Check */
+
+/*------------------------------------------------------------------------------
+Function: Check_Led
+
+Description: LedOn and LedOff of one LED, with it on and off before, and the other pins of its port
+all clear or all set
+
+Promises: Prints the first MISMATCHES_SHOWN mismatches and counts them all, returns the cases checked
+*/
+long Check_Led(LedInformation sLed)
+{
+  u8 au8Other[2] = {0x00, 0xFF};
+  u8 u8Before;
+  u8 u8Want;
+  u8 u8Port;
+
+  for(int i = 0; i < 2; i++)
+  {
+    for(int iWas_On = 0; iWas_On < 2; iWas_On++)
+    {
+      for(int iOn = 0; iOn < 2; iOn++)
+      {
+        u8Before = (au8Other[i] & ~sLed.u8LEDIdentifier) | (iWas_On ? sLed.u8LEDIdentifier : 0);
+        u8Want = (au8Other[i] & ~sLed.u8LEDIdentifier) | (iOn ? sLed.u8LEDIdentifier : 0);
+        *sLed.u8pPortAddress = u8Before;
+        if(iOn)
+        {
+          LedOn(sLed);
+        }
+        else
+        {
+          LedOff(sLed);
+        }
+        u8Port = *sLed.u8pPortAddress;
+        if(u8Port != u8Want && lMismatches++ < MISMATCHES_SHOWN)
+        {
+          printf("%-6s of pin %02X at %03X  port %02X was %02X want %02X\n", iOn ? "LedOn" : "LedOff",
+                 sLed.u8LEDIdentifier, (unsigned)(sLed.u8pPortAddress - GG_au8Host_Io), u8Port, u8Before, u8Want);
+        }
+      }
+    }
+  }
+  return 8;
+
+} /* end Check_Led */
+
+#if CALENDAR_ENABLED
+/*------------------------------------------------------------------------------
+Function: Check_Century
+
+Description: Calendar_Midnight from CENTURY_FIRST-01-01 for CENTURY_YEARS years, each day against
+mktime's normalisation of the day after, with the leap year flag and with Weekday_Update of the
+same date.  alPaths counts the midnights that only step the day, end a month and end a year.
+
+Promises: Prints the first MISMATCHES_SHOWN mismatches and counts them all, returns the days checked
+*/
+long Check_Century(long* alPaths)
+{
+  CalendarInformation* pCalendar = Calendar_Get();
+  struct tm sDay = {0};
+  u16 u16Year;
+  u8 u8Month;
+  u8 u8Weekday;
+  u8 u8Want_Weekday;
+  u8 u8Leap_Year;
+  long lDays = 0;
+
+  Calendar_Set(CENTURY_FIRST, 1, 1);
+  sDay.tm_year = CENTURY_FIRST - 1900;
+  sDay.tm_mday = 1;
+  sDay.tm_hour = 12;                      //noon, a daylight saving change does not move the day
+  sDay.tm_isdst = -1;
+  while(sDay.tm_year < CENTURY_FIRST + CENTURY_YEARS - 1900)
+  {
+    u16Year = (u16)pCalendar->u8Century * YEARS_PER_CENTURY + pCalendar->u8Year;
+    u8Month = pCalendar->u8Month;
+    Calendar_Midnight();
+    sDay.tm_mday++;
+    mktime(&sDay);
+    lDays++;
+
+    if(pCalendar->u8Month == u8Month)
+    {
+      alPaths[0]++;
+    }
+    else if(pCalendar->u8Month != 1)
+    {
+      alPaths[1]++;
+    }
+    else
+    {
+      alPaths[2]++;
+    }
+
+    u16Year = (u16)pCalendar->u8Century * YEARS_PER_CENTURY + pCalendar->u8Year;
+    u8Want_Weekday = sDay.tm_wday == 0 ? DAYS_PER_WEEK : sDay.tm_wday;
+    u8Leap_Year = (u16Year % 4 == 0 && u16Year % 100 != 0) || u16Year % 400 == 0;
+    u8Weekday = pCalendar->u8Weekday;
+    Weekday_Update();
+    if((u16Year != sDay.tm_year + 1900 || pCalendar->u8Month != sDay.tm_mon + 1 || pCalendar->u8Day != sDay.tm_mday ||
+        u8Weekday != u8Want_Weekday || pCalendar->u8Weekday != u8Want_Weekday || pCalendar->u8Leap_Year != u8Leap_Year) &&
+       lMismatches++ < MISMATCHES_SHOWN)
+    {
+      printf("midnight to %04d-%02d-%02d  got %04u-%02u-%02u weekday %u (%u from scratch) leap %u, want weekday %u leap %u\n",
+             sDay.tm_year + 1900, sDay.tm_mon + 1, sDay.tm_mday, u16Year, pCalendar->u8Month, pCalendar->u8Day,
+             u8Weekday, pCalendar->u8Weekday, pCalendar->u8Leap_Year, u8Want_Weekday, u8Leap_Year);
+    }
+  }
+  return lDays;
+
+} /* end Check_Century */
+#endif
+
+int main(int argc, char** argv)
+{
+  struct timespec sStart, sEnd;
+  long lCases = 0;
+  long lLed_Cases = 0;
+  double dSeconds;
+  Time sTime;
+#if CALENDAR_ENABLED
+  long alPaths[3] = {0, 0, 0};
+  long lDays;
+#endif
+
+  Host_Reset();
+  clock_gettime(CLOCK_MONOTONIC, &sStart);
+  for(u8 u8PM = 0; u8PM <= PM_LAST; u8PM++)
+  {
+    for(u8 u8Hour = HOUR_FIRST; u8Hour <= HOUR_LAST; u8Hour++)
+    {
+      for(u8 u8Minute = 0; u8Minute < 60; u8Minute++)
+      {
+        sTime.u8Hour = u8Hour;
+        sTime.u8Minute = u8Minute;
+        sTime.u8PM = u8PM;
+        for(Step eStep = STEP_DISPLAY; eStep < STEPS; eStep++)
+        {
+          Check(sTime, eStep, 0x00);
+          Check(sTime, eStep, 0xFF);
+          lCases += 2;
+        }
+      }
+    }
+  }
+  for(int i = 0; i < LEDS_FOR_HOURS; i++)
+  {
+    lLed_Cases += Check_Led(LG_aLedInfoHourLeds[i]);
+  }
+  for(int i = 0; i < LEDS_FOR_MINUTES; i++)
+  {
+    lLed_Cases += Check_Led(LG_aLedInfoMinuteLeds[i]);
+  }
+#if !CLOCK_24_HOUR
+  lLed_Cases += Check_Led(LG_LedInfoPMLed);
+#endif
+  lCases += lLed_Cases;
+  clock_gettime(CLOCK_MONOTONIC, &sEnd);
+  dSeconds = (sEnd.tv_sec - sStart.tv_sec) + (sEnd.tv_nsec - sStart.tv_nsec) * 1e-9;
+
+  printf("%s hour clock: %ld cases (%d times x %d steps x 2 port states, %ld LedOn and LedOff), %ld mismatches, %.1f ms\n",
+         CLOCK_24_HOUR ? "24" : "12", lCases, (HOUR_LAST - HOUR_FIRST + 1) * 60 * (PM_LAST + 1), STEPS,
+         lLed_Cases, lMismatches, dSeconds * 1e3);
+#if CALENDAR_ENABLED
+  lDays = Check_Century(alPaths);
+  printf("calendar: %ld midnights from %d-01-01 to %d-01-01 (%ld a day, %ld the end of a month, %ld the end of a year), "
+         "%ld mismatches\n", lDays, CENTURY_FIRST, CENTURY_FIRST + CENTURY_YEARS, alPaths[0], alPaths[1],
+         alPaths[2], lMismatches);
+#endif
+  return lMismatches != 0;
+
+} /* end main */
@@ -0,0 +1,256 @@
+/**********************************************************************
+* Definitions for the host build of the firmware
+**********************************************************************/
+
+/************************ Revision History ****************************
+YYYY-MM-DD  Comments
+-------------------------------------------------------------------------------------------
+2026-10-19  File created
+
+************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "host.h"
+#include "bnclk-efwd-01.h"
+#include "stack.h"
+#include "counters.h"
+#include "telemetry.h"
+#include "profile.h"
+
+/******************** External Globals ************************/
+extern fnCode_type GG_fpCLOCKSM;               /* From bnclk-efwd-01.c */
+extern u32 GG_au32Counter[];                   /* From counters.c */
+
+/******************** Program Globals ************************/
+u8 GG_au8Host_Io[HOST_IO_SIZE];                   //the registers, at their MSP430 addresses
+u16 GG_u16Host_SR = 0;                            //the status register, only GIE and the LPM bits are kept
+u8 GG_bHost_Woken = 0;                            //an ISR cleared the LPM bits on exit
+u16 GG_au16Host_Stack[HOST_STACK_WORDS];          //CSTACK for stack.c, painted by Host_Reset
+u16 GG_au16Host_Stack_End[1];
+fnPoint_type GG_pfHost_Point = NULL;              //told about every function entry and sleep, for interrupt arrival points
+u8 GG_u8Host_ISR_Depth = 0;                       //ISRs running, Host_Interrupt
+
+/******************** Local Globals ************************/
+u8 LG_au8Host_Ram_Reset[HOST_RAM_SIZE];           //the firmware's variables as the C startup leaves them
+bool LG_bHost_Ram_Saved = FALSE;
+
+/******************** Function Definitions ************************/
+
+/*------------------------------------------------------------------------------
+Function: __cyg_profile_func_enter
+
+Description: -finstrument-functions calls this on entry to every firmware function,
+the exit is not used
+ 
+Requires: 
+
+Promises: GG_pfHost_Point is called with the function
+*/
+__attribute__((no_instrument_function)) void __cyg_profile_func_enter(void* pvFunction, void* pvCaller)
+{
+  if(GG_pfHost_Point)
+  {
+    GG_pfHost_Point(pvFunction);
+  }
+  
+} /* end __cyg_profile_func_enter */
+
+__attribute__((no_instrument_function)) void __cyg_profile_func_exit(void* pvFunction, void* pvCaller)
+{
+} /* end __cyg_profile_func_exit */
+
+/*------------------------------------------------------------------------------
+Function: Host_Sleep
+
+Description: __bis_SR_register.  The firmware only sets GIE and the LPM3 bits, going to sleep
+on the host is returning to the caller, which runs the ISRs and the next wake itself.
+An interrupt can still arrive just before the bits are set, that is a point too.
+ 
+Requires: 
+
+Promises: The bits are set in GG_u16Host_SR and GG_bHost_Woken is cleared when they include CPUOFF
+*/
+void Host_Sleep(unsigned short u16Bits)
+{
+  if((u16Bits & CPUOFF) && GG_pfHost_Point)
+  {
+    GG_pfHost_Point((void*)Host_Sleep);
+  }
+  GG_u16Host_SR |= u16Bits;
+  if(u16Bits & CPUOFF)
+  {
+    GG_bHost_Woken = 0;
+  }
+  
+} /* end Host_Sleep */
+
+/*------------------------------------------------------------------------------
+Function: Host_Interrupt
+
+Description: Runs an ISR the way the CPU does: GIE and the LPM bits are cleared for the ISR and
+the status register is put back after it, less the LPM bits if it woke the main loop
+ 
+Requires: 
+
+Promises: The ISR has run, Host_Asleep() is FALSE if it woke the main loop
+*/
+void Host_Interrupt(fnCode_type pfISR)
+{
+  u16 u16Saved = GG_u16Host_SR;
+  
+  GG_u16Host_SR &= ~(GIE | LPM4_bits);
+  GG_bHost_Woken = 0;
+  GG_u8Host_ISR_Depth++;
+  pfISR();
+  GG_u8Host_ISR_Depth--;
+  if(GG_bHost_Woken)
+  {
+    u16Saved &= ~LPM4_bits;
+  }
+  GG_u16Host_SR = u16Saved;
+  
+} /* end Host_Interrupt */
+
+/*------------------------------------------------------------------------------
+Function: Host_Asleep
+
+Description: Whether the main loop is in LPM3
+ 
+Requires: 
+
+Promises: Returns TRUE while CPUOFF is set
+*/
+bool Host_Asleep(void)
+{
+  return (GG_u16Host_SR & CPUOFF) ? TRUE : FALSE;
+  
+} /* end Host_Asleep */
+
+/*------------------------------------------------------------------------------
+Function: Host_Run
+
+Description: The body of the main loop in main.c, run until the state machine goes back to sleep
+ 
+Requires: 
+
+Promises: Returns TRUE once the main loop is asleep, FALSE if it was still awake after HOST_RUN_LIMIT states
+*/
+bool Host_Run(void)
+{
+  for(u8 i = 0; i < HOST_RUN_LIMIT && !Host_Asleep(); i++)
+  {
+    COUNT(COUNTER_WAKES);
+    Profile_Begin(PROFILE_SITE_STATE);
+    GG_fpCLOCKSM();
+    Profile_End(PROFILE_SITE_STATE);
+  }
+  return Host_Asleep();
+  
+} /* end Host_Run */
+
+/*------------------------------------------------------------------------------
+Function: Host_Save
+
+Description: Copies the firmware's variables, the registers and the status register
+ 
+Requires: Host_Reset has run once
+
+Promises: Host_Restore of the snapshot puts the firmware back in exactly this state
+*/
+void Host_Save(HostSnapshot* pSnapshot)
+{
+  memcpy(pSnapshot->au8Ram, __start_firmware_ram, HOST_RAM_USED);
+  memcpy(pSnapshot->au8Io, GG_au8Host_Io, HOST_IO_SAVED);
+  pSnapshot->u16SR = GG_u16Host_SR;
+  pSnapshot->u8Woken = GG_bHost_Woken;
+  
+} /* end Host_Save */
+
+/*------------------------------------------------------------------------------
+Function: Host_Restore
+
+Description: Puts back a snapshot from Host_Save
+ 
+Requires: 
+
+Promises: The firmware is in the state it was in when the snapshot was taken
+*/
+void Host_Restore(const HostSnapshot* pSnapshot)
+{
+  memcpy(__start_firmware_ram, pSnapshot->au8Ram, HOST_RAM_USED);
+  memcpy(GG_au8Host_Io, pSnapshot->au8Io, HOST_IO_SAVED);
+  GG_u16Host_SR = pSnapshot->u16SR;
+  GG_bHost_Woken = pSnapshot->u8Woken;
+  
+} /* end Host_Restore */
+
+/*------------------------------------------------------------------------------
+Function: Host_Pins
+
+Description: Sets the input pins, each button pulls its pin low
+ 
+Requires: 
+
+Promises: P2IN and P3IN are the values given
+*/
+void Host_Pins(u8 u8P2IN, u8 u8P3IN)
+{
+  P2IN = u8P2IN;
+  P3IN = u8P3IN;
+  
+} /* end Host_Pins */
+
+/*------------------------------------------------------------------------------
+Function: Host_Reset
+
+Description: A power on reset: cstartup.s43 and main() up to the state machine loop.
+The first call keeps the firmware's variables as the C startup left them, the later ones put them back.
+ 
+Requires: 
+
+Promises: 
+  - The registers are those of __low_level_init with power present and no buttons down
+  - The firmware is initialized, the main loop is awake and the next state is ClockSM_Start
+*/
+void Host_Reset(void)
+{
+  if(HOST_RAM_USED > HOST_RAM_SIZE)
+  {
+    fprintf(stderr, "the firmware has %u bytes of variables, HOST_RAM_SIZE is %u\n", HOST_RAM_USED, HOST_RAM_SIZE);
+    exit(2);
+  }
+  if(!LG_bHost_Ram_Saved)
+  {
+    memcpy(LG_au8Host_Ram_Reset, __start_firmware_ram, HOST_RAM_USED);
+    LG_bHost_Ram_Saved = TRUE;
+  }
+  memcpy(__start_firmware_ram, LG_au8Host_Ram_Reset, HOST_RAM_USED);
+  memset(GG_au8Host_Io, 0, sizeof(GG_au8Host_Io));
+  for(u8 i = 0; i < HOST_STACK_WORDS; i++)
+  {
+    GG_au16Host_Stack[i] = STACK_PAINT;
+  }
+  GG_u16Host_SR = 0;
+  GG_bHost_Woken = 0;
+  GG_u8Host_ISR_Depth = 0;
+  Host_Pins(P2_5_LOST_POWER_IND | P2_1_BUTTON_0, P3_6_BUTTON_2 | P3_7_BUTTON_1);
+  
+  P1DIR = 0x0F;
+  P1OUT = 0x0F;
+  P2SEL = 0xC0;
+  P2DIR = 0x1C;
+  P2OUT = 0x1C;
+  P3DIR = 0xCF;
+  P3OUT = 0xC7;
+  P2IES = 0x22;
+  P2IE = 0x22;
+  
+  Counters_Initialize(PORIFG);
+  Telemetry_Initialize(PORIFG);
+  Clock_Initialize();
+  Profile_Initialize();
+  GG_fpCLOCKSM = ClockSM_Start;
+  
+} /* end Host_Reset */
@@ -0,0 +1,69 @@
+/**********************************************************************
+* Header file for the host build of the firmware
+
+The firmware sources in IAR_7_12_1 built with the host cc against the stand-in headers in this
+directory.  The registers are bytes of GG_au8Host_Io (io430.h), the status register is GG_u16Host_SR
+(intrinsics.h) and main() is Firmware_Main so the tools here can drive the state machine themselves.
+The firmware is built with -finstrument-functions, every function entry is a point the tools can
+deliver an interrupt at.
+**********************************************************************/
+
+/************************ Revision History ****************************
+YYYY-MM-DD  Comments
+-------------------------------------------------------------------------------------------
+2026-10-19  File created
+
+************************************************************************/
+
+#ifndef __HOST_HEADER
+#define __HOST_HEADER
+
+#include "io430.h"
+#include "intrinsics.h"
+#include "typedef_MSP430.h"
+
+/****************************************************************************************
+Constants
+****************************************************************************************/
+
+#define HOST_STACK_WORDS       64        /* the size of CSTACK in the IAR build */
+#define HOST_RAM_SIZE          2048      /* room for the firmware's variables, ints and pointers are wider on the host */
+#define HOST_IO_SAVED          0x0200    /* the peripheral registers, the information memory never changes */
+#define HOST_RUN_LIMIT         64        /* state machine calls in one wake before Host_Run gives up */
+
+/******************************************************************************
+Type Definitions
+******************************************************************************/
+
+/* Everything that makes up the state of the firmware between two instructions */
+typedef struct
+{
+  u8 au8Ram[HOST_RAM_SIZE];              //the firmware's variables, firmware_ram in the Makefile
+  u8 au8Io[HOST_IO_SAVED];               //the registers
+  u16 u16SR;
+  u8 u8Woken;
+} HostSnapshot;
+
+/* Called on entry to every firmware function and just before the main loop sleeps, with the
+function (Host_Sleep for the sleep).  These are the points an interrupt can arrive at, see Host_Point */
+typedef void (*fnPoint_type)(void* pvFunction);
+
+/* The firmware's variables, the Makefile moves them all into the section firmware_ram */
+extern u8 __start_firmware_ram[];
+extern u8 __stop_firmware_ram[];
+#define HOST_RAM_USED          (u16)(__stop_firmware_ram - __start_firmware_ram)
+
+extern fnPoint_type GG_pfHost_Point;
+extern u8 GG_u8Host_ISR_Depth;
+
+/************************ Function Declarations ****************************/
+
+void Host_Reset(void);
+void Host_Pins(u8 u8P2IN, u8 u8P3IN);
+void Host_Save(HostSnapshot* pSnapshot);
+void Host_Restore(const HostSnapshot* pSnapshot);
+void Host_Interrupt(fnCode_type pfISR);
+bool Host_Asleep(void);
+bool Host_Run(void);
+
+#endif /* __HOST_HEADER */
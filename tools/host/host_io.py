@@ -0,0 +1,40 @@
+#!/usr/bin/env python3
+"""Register header for the host build of the binary clock firmware.
+
+Writes host_io.h: IAR_7_12_1/msp430x21x2.h with every register (DEFC, DEFW) made a byte or
+word of GG_au8Host_Io at its MSP430 address, so the firmware, the LED tables that hold
+register addresses and the host tools all see the same registers.  The bit definitions are
+kept as they are, IAR's In430.h is left out, intrinsics.h here has what the firmware uses of it.
+
+Usage:
+    host_io.py msp430x21x2.h host_io.h
+
+Revision History
+2026-10-19  File created
+"""
+
+import re
+import sys
+
+REGISTER = re.compile(r"^\s*(?:READ_ONLY\s+)?DEF([CW])\(\s*(\w+)\s*,\s*(\w+)\s*\)")
+
+
+def main():
+    source, target = sys.argv[1], sys.argv[2]
+    lines = ["/* Generated from %s by host_io.py, do not edit */" % source.replace("\\", "/").split("/")[-1]]
+    for line in open(source, errors="replace"):
+        line = line.rstrip()
+        match = REGISTER.match(line)
+        if line.strip().lower() == "#include <in430.h>":
+            continue
+        if match:
+            kind, name, address = match.groups()
+            size = "unsigned char" if kind == "C" else "unsigned short"
+            line = "#define %-18s (*(volatile %s*)&GG_au8Host_Io[%s])" % (name, size, address)
+        lines.append(line)
+    with open(target, "w") as f:
+        f.write("\n".join(lines) + "\n")
+
+
+if __name__ == "__main__":
+    main()
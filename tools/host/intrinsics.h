@@ -0,0 +1,46 @@
+/**********************************************************************
+* IAR intrinsics.h for the host build
+
+The status register is GG_u16Host_SR.  Sleeping and waking are recorded in it and in
+GG_bHost_Woken so host.c can run the main loop one wake at a time, see Host_Wake.
+**********************************************************************/
+
+/************************ Revision History ****************************
+YYYY-MM-DD  Comments
+-------------------------------------------------------------------------------------------
+2026-10-19  File created
+
+************************************************************************/
+
+#ifndef __HOST_INTRINSICS_HEADER
+#define __HOST_INTRINSICS_HEADER
+
+#include "io430.h"
+
+extern unsigned short GG_u16Host_SR;
+extern unsigned char GG_bHost_Woken;
+extern unsigned short GG_au16Host_Stack[];
+extern unsigned short GG_au16Host_Stack_End[];
+
+void Host_Sleep(unsigned short u16Bits);
+
+#define __bis_SR_register(bits)            Host_Sleep(bits)
+#define __bic_SR_register(bits)            (GG_u16Host_SR &= ~(bits))
+#define __bic_SR_register_on_exit(bits)    (GG_bHost_Woken = 1)
+#define __bis_SR_register_on_exit(bits)    ((void)0)
+#define __get_SR_register()                GG_u16Host_SR
+#define __enable_interrupt()               (GG_u16Host_SR |= GIE)
+#define __disable_interrupt()              (GG_u16Host_SR &= ~GIE)
+#define __no_operation()                   ((void)0)
+
+#define __even_in_range(value, bound)      (value)
+
+#define __istate_t                         unsigned short
+#define __get_interrupt_state()            GG_u16Host_SR
+#define __set_interrupt_state(state)       (GG_u16Host_SR = (state))
+
+/* stack.c only asks for CSTACK, on the host it is an array that is never written */
+#define __segment_begin(segment)           ((void*)GG_au16Host_Stack)
+#define __segment_end(segment)             ((void*)GG_au16Host_Stack_End)
+
+#endif /* __HOST_INTRINSICS_HEADER */
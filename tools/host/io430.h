@@ -0,0 +1,47 @@
+/**********************************************************************
+* IAR io430.h for the host build
+
+The firmware includes IAR's io430.h, io430f2122.h and intrinsics.h.  The host build puts this
+directory after the firmware's on the include path so the same sources build with the host cc.
+Every register is a byte or word of GG_au8Host_Io at its MSP430 address, see host_io.py, so
+the firmware runs unchanged and host.c and the tools read and drive the pins.
+**********************************************************************/
+
+/************************ Revision History ****************************
+YYYY-MM-DD  Comments
+-------------------------------------------------------------------------------------------
+2026-10-19  File created
+
+************************************************************************/
+
+#ifndef __HOST_IO430_HEADER
+#define __HOST_IO430_HEADER
+
+/* The peripherals, information memory and the calibration constants, everything below RAM and FLASH */
+#define HOST_IO_SIZE           0x1100
+extern unsigned char GG_au8Host_Io[HOST_IO_SIZE];
+
+/* msp430x21x2.h checks it is built for the F21x2, and has the C names of the LPM bits */
+#define __TID__                0x2B00
+#define __IAR_SYSTEMS_ICC
+
+#include "host_io.h"
+
+/* Names from IAR's io430x21x2.h that the TI header does not have */
+#ifndef TAIV_TACCR1
+#define TAIV_TACCR1            TA0IV_TACCR1
+#endif
+#ifndef TAIV_TACCR2
+#define TAIV_TACCR2            TA0IV_TACCR2
+#endif
+#ifndef TAIV_TAIFG
+#define TAIV_TAIFG             TA0IV_TAIFG
+#endif
+
+/* Nothing clears RAM on the host, host.c puts the firmware in a known state itself */
+#define __no_init
+
+/* The ISRs are plain functions, host.c calls them */
+#define __interrupt
+
+#endif /* __HOST_IO430_HEADER */
@@ -0,0 +1,944 @@
+/**********************************************************************
+* Explicit state model checker for the state machine and its interrupts
+
+Explores every order in which the inputs and interrupts of the clock can arrive, running the
+firmware itself (the host build) for each one.  An event is one of:
+  - a Timer A tick (TimerAISR, TAIFG), a 62.5ms button sub-tick (TACCR1) or a melody note (TACCR2)
+  - the auto-repeat timer (Timer1AISR) or the release sampling (Timer1A1ISR, TA1CCR1)
+  - LOST_POWER_IND falling or rising, a button going down or coming back up
+Port2ISR runs for the falling edges P2IES and P2IE ask for.  An event that wakes the main loop
+runs the state machine until it is back in LPM3, and a second event can arrive at any point of
+that wake: the entry of any firmware function, or just before the main loop sleeps.  That is
+where Port2ISR rewriting GG_fpCLOCKSM meets the state function that is running.
+
+The timers are not timed, any one that is running may expire next, so the checker sees every
+order the real timings could give and some they cannot.
+
+States are firmware snapshots (host.h), a state is visited again only with more events left to
+run after it.  The visited set keeps a 56 bit hash of each state, 8 bytes a state, leaving out
+what only records the past: the counters, the telemetry log, the tick count and the timer
+compare registers.  After each event, with the main loop asleep again, these must hold:
+  sleeps            the main loop goes back to sleep within HOST_RUN_LIMIT states
+  time valid        the hour, minute and AM/PM are in range
+  minute kept       the time moves one tick for every Timer A tick, unless a button set it,
+                    and Timer A keeps running
+  dark on battery   once power has been gone DARK_TICKS ticks the state is ClockSM_LP_Sleep
+                    and no LED is lit: the minute, hour, PM and TICK pins are low, apart from
+                    the console's pins while P3SEL gives them to the UART
+The first event sequence that breaks each one is printed.
+
+Build:   make model_check
+Use:     model_check [-d depth] [-t hh:mm[am|pm]] [-s second_counter] [-m megabytes] [-r reset|running]
+                     [-n] [-B] [-P] [-k]
+         -n no second event during a wake, -B buttons may be down together, -P power stays on,
+         -k carry on after an invariant is broken.  The depth is 6 events unless -d is given, make check
+         runs that (about 7 s), -d 8 takes about 2 minutes
+**********************************************************************/
+
+/************************ Revision History ****************************
+YYYY-MM-DD  Comments
+-------------------------------------------------------------------------------------------
+2026-10-19  File created
+
+************************************************************************/
+
+#define _GNU_SOURCE
+#include <dlfcn.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "host.h"
+#include "bnclk-efwd-01.h"
+#include "main.h"
+#include "counters.h"
+#include "telemetry.h"
+#include "profile.h"
+
+/******************** External Globals ************************/
+extern fnCode_type GG_fpCLOCKSM;                /* From bnclk-efwd-01.c */
+extern int GG_u8Second_Counter;                 /* From bnclk-efwd-01.c */
+extern volatile u8 GG_u8Wake_Countdown;         /* From bnclk-efwd-01.c */
+extern volatile u16 GG_u16Tick_Count;           /* From bnclk-efwd-01.c */
+extern u8 LG_u8Minute_Counter;                  /* From bnclk-efwd-01.c */
+extern u8 LG_u8Hour_Counter;                    /* From bnclk-efwd-01.c */
+#if !CLOCK_24_HOUR
+extern u8 LG_u8PM;                              /* From bnclk-efwd-01.c */
+#endif
+extern u32 GG_au32Counter[COUNTERS];            /* From counters.c */
+extern u16 LG_u16Counters_Magic;                /* From counters.c */
+#if TELEMETRY_ENABLED
+extern u8 GG_au8Telemetry[TELEMETRY_SIZE];      /* From telemetry.c */
+extern u8 GG_u8Telemetry_Head;                  /* From telemetry.c */
+extern u8 GG_u8Telemetry_Tail;                  /* From telemetry.c */
+extern u16 GG_u16Telemetry_Last;                /* From telemetry.c */
+extern u16 LG_u16Telemetry_Magic;               /* From telemetry.c */
+#endif
+#if PROFILE_ENABLED
+extern ProfileInformation GG_aProfile[PROFILE_SITES];   /* From profile.c */
+extern u16 LG_au16Profile_Start[PROFILE_SITES];        /* From profile.c */
+#endif
+
+typedef unsigned long long u64;
+
+#define DEPTH_DEFAULT          6
+#define MEGABYTES_DEFAULT      64
+#define SECOND_DEFAULT         236         /* one second before the minute */
+#define MAX_POINTS             256         /* arrival points of one wake that get a second event */
+#define DAY_TICKS              (1440L * 240)
+#define DARK_TICKS             (TICKS_PER_SECOND + 1)   /* ClockSM_Tick may sleep 3 ticks before it sees anything */
+#define VISITED_FULL           0.9
+#define PORT3_LEDS             (u8)(~Port3_Clear_Mask | P3_4_PIMO_TICK)
+
+typedef enum {SOURCE_TICK, SOURCE_SUBTICK, SOURCE_MELODY, SOURCE_REPEAT, SOURCE_RELEASE, SOURCE_POWER_LOST,
+              SOURCE_POWER_BACK, SOURCE_BUTTON_0_DOWN, SOURCE_BUTTON_0_UP, SOURCE_BUTTON_1_DOWN, SOURCE_BUTTON_1_UP,
+              SOURCE_BUTTON_2_DOWN, SOURCE_BUTTON_2_UP, SOURCES} Source;
+
+const char* apcEvent_Name[SOURCES] = {"tick", "sub-tick", "melody note", "auto-repeat", "release sample",
+                                     "power lost", "power back", "button 0 down", "button 0 up",
+                                     "button 1 down", "button 1 up", "button 2 down", "button 2 up"};
+
+typedef enum {INVARIANT_SLEEPS, INVARIANT_TIME_VALID, INVARIANT_MINUTE_KEPT, INVARIANT_DARK_ON_BATTERY,
+              INVARIANTS} Invariant;
+
+const char* apcInvariant_Name[INVARIANTS] = {"sleeps", "time valid", "minute kept", "dark on battery"};
+
+/* What the firmware does not know about the path to a state */
+typedef struct
+{
+  s32 s32Expected;                      //clock ticks since midnight the time should be at
+  u8 u8Battery_Ticks;                   //ticks since power was lost, up to DARK_TICKS
+} Ghost;
+
+/* How a state was reached from the one before it */
+typedef struct
+{
+  u8 u8Event;
+  u8 u8Nested;                          //SOURCES for none
+  u16 u16Point;                         //the arrival point u8Nested came at
+  void* pvFunction;                     //the firmware function entered at that point
+} Transition;
+
+/* One level of the depth first search, the state and where its successors have got to */
+typedef struct
+{
+  HostSnapshot sHost;
+  Ghost sGhost;
+  Transition sFrom;
+  u8 u8Depth_Left;
+  u8 u8Event;                           //the event being tried
+  u8 u8Nested;                          //the second event being tried at u16Point
+  u16 u16Point;                         //0 until u8Event has been run on its own
+  u16 u16Points;                        //arrival points of u8Event run on its own
+  u16 au16Enabled[MAX_POINTS];          //events that could arrive at each point
+} Node;
+
+/* Options */
+int iDepth = DEPTH_DEFAULT;
+int iMegabytes = MEGABYTES_DEFAULT;
+int iSecond = SECOND_DEFAULT;
+u8 u8Start_Hour = 11;
+u8 u8Start_Minute = 59;
+u8 u8Start_PM = 1;
+const char* pcRoots = "both";
+bool bNested = TRUE;
+bool bButtons_Together = FALSE;
+bool bPower = TRUE;
+bool bKeep_Going = FALSE;
+
+/* The run of one transition, see Point */
+Ghost sGhost;
+u16 u16Point_Count;
+u16 u16Inject_At;                       //0 for no second event
+u8 u8Inject_Event;
+bool bInject_Failed;
+void* pvInject_Function;
+bool bTime_Set;
+u16* pu16Enabled_Record;                //where the events that could arrive at each point go, or NULL
+
+/* The visited set and the results */
+u64* pu64Visited;
+u64 u64Visited_Mask;
+u64 u64Visited_Count = 0;
+bool bVisited_Full = FALSE;
+u8 au8Key_Mask[HOST_RAM_SIZE + HOST_IO_SAVED];
+u16 u16Key_Bytes;
+u64 u64States = 0;
+u64 u64Transitions = 0;
+u16 u16Max_Points = 0;
+long alBroken[INVARIANTS];
+bool bStop = FALSE;
+Node* aNode;
+
+/*------------------------------------------------------------------------------
+Function: Name
+
+Description: The name of a firmware function from the executable's symbols (linked with -rdynamic)
+
+Promises: Returns the name, or "?" when there is none
+*/
+const char* Name(void* pvFunction)
+{
+  Dl_info sInfo;
+
+  if(pvFunction == (void*)Host_Sleep)
+  {
+    return "going to sleep";
+  }
+  if(pvFunction && dladdr(pvFunction, &sInfo) && sInfo.dli_sname)
+  {
+    return sInfo.dli_sname;
+  }
+  return "?";
+
+} /* end Name */
+
+/*------------------------------------------------------------------------------
+Function: Clock_Ticks
+
+Description: The firmware's time as Timer A ticks since midnight, the second counter may be past 240
+when the minute has not been rolled over yet
+
+Promises: Returns 0 to DAY_TICKS - 1
+*/
+s32 Clock_Ticks(void)
+{
+  s32 s32Minutes;
+
+#if CLOCK_24_HOUR
+  s32Minutes = LG_u8Hour_Counter * 60 + LG_u8Minute_Counter;
+#else
+  s32Minutes = ((LG_u8Hour_Counter % 12) + (LG_u8PM ? 12 : 0)) * 60 + LG_u8Minute_Counter;
+#endif
+  return (s32)((s32Minutes * 240L + GG_u8Second_Counter) % DAY_TICKS);
+
+} /* end Clock_Ticks */
+
+/*------------------------------------------------------------------------------
+Function: Timer_Running
+
+Description: Whether a timer is counting, from its control register
+
+Promises: Returns TRUE if the mode is not stop
+*/
+bool Timer_Running(u16 u16Control)
+{
+  return (u16Control & MC_3) ? TRUE : FALSE;
+
+} /* end Timer_Running */
+
+/*------------------------------------------------------------------------------
+Function: Buttons_Held
+
+Description: The buttons that are down, from the pins
+
+Promises: Returns the pin masks, as Buttons_Down in the firmware
+*/
+u8 Buttons_Held(void)
+{
+  return (~P3IN & (P3_6_BUTTON_2 | P3_7_BUTTON_1)) | (~P2IN & P2_1_BUTTON_0);
+
+} /* end Buttons_Held */
+
+/*------------------------------------------------------------------------------
+Function: Event_Enabled
+
+Description: Whether an event can happen in the firmware's state now
+
+Promises: Returns TRUE if it can
+*/
+bool Event_Enabled(u8 u8Event)
+{
+  u8 u8Held = Buttons_Held();
+  bool bFree = (bButtons_Together || u8Held == 0) ? TRUE : FALSE;
+
+  switch(u8Event)
+  {
+    case SOURCE_TICK:          return (TACTL & TAIE) && Timer_Running(TACTL);
+    case SOURCE_SUBTICK:       return (TACCTL1 & CCIE) && Timer_Running(TACTL);
+    case SOURCE_MELODY:        return (TACCTL2 & CCIE) && Timer_Running(TACTL);
+    case SOURCE_REPEAT:        return (TA1CCTL0 & CCIE) && Timer_Running(TA1CTL);
+    case SOURCE_RELEASE:       return (TA1CCTL1 & CCIE) && Timer_Running(TA1CTL);
+    case SOURCE_POWER_LOST:    return bPower && (P2IN & P2_5_LOST_POWER_IND);
+    case SOURCE_POWER_BACK:    return bPower && !(P2IN & P2_5_LOST_POWER_IND);
+    case SOURCE_BUTTON_0_DOWN: return bFree && !(u8Held & P2_1_BUTTON_0);
+    case SOURCE_BUTTON_0_UP:   return (u8Held & P2_1_BUTTON_0) ? TRUE : FALSE;
+    case SOURCE_BUTTON_1_DOWN: return bFree && !(u8Held & P3_7_BUTTON_1);
+    case SOURCE_BUTTON_1_UP:   return (u8Held & P3_7_BUTTON_1) ? TRUE : FALSE;
+    case SOURCE_BUTTON_2_DOWN: return bFree && !(u8Held & P3_6_BUTTON_2);
+    case SOURCE_BUTTON_2_UP:   return (u8Held & P3_6_BUTTON_2) ? TRUE : FALSE;
+    default:                  return FALSE;
+  }
+
+} /* end Event_Enabled */
+
+/*------------------------------------------------------------------------------
+Function: Port2_Pin
+
+Description: Drives a port 2 input, the edge P2IES selects sets its P2IFG bit and Port2ISR runs
+if P2IE has it and interrupts are on
+
+Promises: P2IN has the new level
+*/
+void Port2_Pin(u8 u8Pin, bool bHigh)
+{
+  u8 u8Was = P2IN & u8Pin;
+
+  if(bHigh)
+  {
+    P2IN |= u8Pin;
+  }
+  else
+  {
+    P2IN &= ~u8Pin;
+  }
+  if((u8Was && !bHigh && (P2IES & u8Pin)) || (!u8Was && bHigh && !(P2IES & u8Pin)))
+  {
+    P2IFG |= u8Pin;
+  }
+  if((P2IFG & P2IE) && (GG_u16Host_SR & GIE))
+  {
+    Host_Interrupt(Port2ISR);
+  }
+
+} /* end Port2_Pin */
+
+/*------------------------------------------------------------------------------
+Function: Event_Deliver
+
+Description: Makes an event happen, the ISR it causes runs straight away
+
+Promises: The ISR has run, a wake it asked for is left to the caller
+*/
+void Event_Deliver(u8 u8Event)
+{
+  switch(u8Event)
+  {
+    case SOURCE_TICK:
+      TAIV = TAIV_TAIFG;
+      Host_Interrupt(TimerAISR);
+      TAIV = 0;
+      sGhost.s32Expected = (sGhost.s32Expected + 1) % DAY_TICKS;
+      if(!(P2IN & P2_5_LOST_POWER_IND) && sGhost.u8Battery_Ticks < DARK_TICKS)
+      {
+        sGhost.u8Battery_Ticks++;
+      }
+      break;
+
+    case SOURCE_SUBTICK:
+      TAIV = TAIV_TACCR1;
+      Host_Interrupt(TimerAISR);
+      TAIV = 0;
+      break;
+
+    case SOURCE_MELODY:
+      TAIV = TAIV_TACCR2;
+      Host_Interrupt(TimerAISR);
+      TAIV = 0;
+      break;
+
+    case SOURCE_REPEAT:
+      Host_Interrupt(Timer1AISR);
+      break;
+
+    case SOURCE_RELEASE:
+      TA1IV = TAIV_TACCR1;
+      Host_Interrupt(Timer1A1ISR);
+      TA1IV = 0;
+      break;
+
+    case SOURCE_POWER_LOST:
+      sGhost.u8Battery_Ticks = 0;
+      Port2_Pin(P2_5_LOST_POWER_IND, FALSE);
+      break;
+
+    case SOURCE_POWER_BACK:
+      sGhost.u8Battery_Ticks = 0;
+      Port2_Pin(P2_5_LOST_POWER_IND, TRUE);
+      break;
+
+    case SOURCE_BUTTON_0_DOWN:
+    case SOURCE_BUTTON_0_UP:
+      Port2_Pin(P2_1_BUTTON_0, u8Event == SOURCE_BUTTON_0_UP);
+      break;
+
+    case SOURCE_BUTTON_1_DOWN:
+      P3IN &= ~P3_7_BUTTON_1;
+      break;
+
+    case SOURCE_BUTTON_1_UP:
+      P3IN |= P3_7_BUTTON_1;
+      break;
+
+    case SOURCE_BUTTON_2_DOWN:
+      P3IN &= ~P3_6_BUTTON_2;
+      break;
+
+    case SOURCE_BUTTON_2_UP:
+      P3IN |= P3_6_BUTTON_2;
+      break;
+
+    default:
+      break;
+  }
+
+} /* end Event_Deliver */
+
+/*------------------------------------------------------------------------------
+Function: Point
+
+Description: GG_pfHost_Point.  Every firmware function entry and every sleep of the awake main
+loop with interrupts on is an arrival point, the second event of a transition is delivered at
+point u16Inject_At.  Setting the time with the buttons is noted here too, in any context.
+
+Promises: u16Point_Count is the points so far
+*/
+void Point(void* pvFunction)
+{
+  u16 u16Enabled = 0;
+
+  if(pvFunction == (void*)ClockSM_Button_Press || pvFunction == (void*)Time_Set_Latch)
+  {
+    bTime_Set = TRUE;
+  }
+  if(GG_u8Host_ISR_Depth || !(GG_u16Host_SR & GIE) || Host_Asleep())
+  {
+    return;
+  }
+  u16Point_Count++;
+  if(pu16Enabled_Record && u16Point_Count <= MAX_POINTS)
+  {
+    for(u8 u8Event = 0; u8Event < SOURCES; u8Event++)
+    {
+      if(Event_Enabled(u8Event))
+      {
+        u16Enabled |= 1 << u8Event;
+      }
+    }
+    pu16Enabled_Record[u16Point_Count - 1] = u16Enabled;
+  }
+  if(u16Point_Count == u16Inject_At)
+  {
+    pvInject_Function = pvFunction;
+    if(Event_Enabled(u8Inject_Event))
+    {
+      Event_Deliver(u8Inject_Event);
+    }
+    else
+    {
+      bInject_Failed = TRUE;
+    }
+  }
+
+} /* end Point */
+
+/*------------------------------------------------------------------------------
+Function: Key_Mask_Initialize
+
+Description: Which bytes of a snapshot make up the state, the rest only record the past
+
+Promises: au8Key_Mask and u16Key_Bytes are set for State_Hash
+*/
+void Key_Mask_Exclude(volatile void* pvVariable, u16 u16Size)
+{
+  memset(au8Key_Mask + ((volatile u8*)pvVariable - __start_firmware_ram), 0, u16Size);
+
+} /* end Key_Mask_Exclude */
+
+void Key_Mask_Initialize(void)
+{
+  memset(au8Key_Mask, 0, sizeof(au8Key_Mask));
+  memset(au8Key_Mask, 0xFF, HOST_RAM_USED);
+  memset(au8Key_Mask + HOST_RAM_SIZE, 0xFF, HOST_IO_SAVED);
+  u16Key_Bytes = HOST_RAM_SIZE + HOST_IO_SAVED;
+
+  Key_Mask_Exclude(&GG_u16Tick_Count, sizeof(GG_u16Tick_Count));
+  Key_Mask_Exclude(GG_au32Counter, sizeof(u32) * COUNTERS);
+  Key_Mask_Exclude(&LG_u16Counters_Magic, sizeof(LG_u16Counters_Magic));
+#if TELEMETRY_ENABLED
+  Key_Mask_Exclude(GG_au8Telemetry, TELEMETRY_SIZE);
+  Key_Mask_Exclude(&GG_u8Telemetry_Head, sizeof(GG_u8Telemetry_Head));
+  Key_Mask_Exclude(&GG_u8Telemetry_Tail, sizeof(GG_u8Telemetry_Tail));
+  Key_Mask_Exclude(&GG_u16Telemetry_Last, sizeof(GG_u16Telemetry_Last));
+  Key_Mask_Exclude(&LG_u16Telemetry_Magic, sizeof(LG_u16Telemetry_Magic));
+#endif
+#if PROFILE_ENABLED
+  Key_Mask_Exclude(GG_aProfile, sizeof(ProfileInformation) * PROFILE_SITES);
+  Key_Mask_Exclude(LG_au16Profile_Start, sizeof(u16) * PROFILE_SITES);
+#endif
+
+  /* The counts and compare registers of both timers, the timers are not timed */
+  memset(au8Key_Mask + HOST_RAM_SIZE + TA0R_, 0, 8);
+  memset(au8Key_Mask + HOST_RAM_SIZE + TA1R_, 0, 8);
+
+} /* end Key_Mask_Initialize */
+
+/*------------------------------------------------------------------------------
+Function: State_Hash
+
+Description: 64 bit hash of the bytes au8Key_Mask keeps, the status register and the ghost
+
+Promises: Returns the hash
+*/
+u64 State_Hash(const HostSnapshot* pSnapshot, const Ghost* pGhost)
+{
+  const u8* pu8State = (const u8*)pSnapshot;
+  u64 u64Hash = 0x9E3779B97F4A7C15ull ^ ((u64)pSnapshot->u16SR << 8) ^ pGhost->u8Battery_Ticks;
+  u64 u64Word;
+  u64 u64Mask;
+
+  for(u16 i = 0; i < u16Key_Bytes; i += 8)
+  {
+    memcpy(&u64Word, pu8State + i, 8);
+    memcpy(&u64Mask, au8Key_Mask + i, 8);
+    if(u64Mask)
+    {
+      u64Hash = (u64Hash ^ (u64Word & u64Mask) ^ i) * 0xFF51AFD7ED558CCDull;
+      u64Hash ^= u64Hash >> 32;
+    }
+  }
+  u64Hash ^= u64Hash >> 29;
+  u64Hash *= 0xC4CEB9FE1A85EC53ull;
+  return u64Hash ^ (u64Hash >> 32);
+
+} /* end State_Hash */
+
+/*------------------------------------------------------------------------------
+Function: Visited_Add
+
+Description: The visited set, open addressing with the hash in the top 56 bits of each slot
+and the events that were left to run after the state in the low 8
+
+Promises: Returns TRUE if the state is new, or was seen before with fewer events left, and records it
+*/
+bool Visited_Add(u64 u64Hash, u8 u8Depth_Left)
+{
+  u64 u64Tag = (u64Hash | 0x8000000000000000ull) & ~0xFFull;
+  u64 u64Index = u64Hash & u64Visited_Mask;
+
+  while(pu64Visited[u64Index])
+  {
+    if((pu64Visited[u64Index] & ~0xFFull) == u64Tag)
+    {
+      if((pu64Visited[u64Index] & 0xFF) >= u8Depth_Left)
+      {
+        return FALSE;
+      }
+      pu64Visited[u64Index] = u64Tag | u8Depth_Left;
+      return TRUE;
+    }
+    u64Index = (u64Index + 1) & u64Visited_Mask;
+  }
+  if(u64Visited_Count >= VISITED_FULL * (u64Visited_Mask + 1))
+  {
+    bVisited_Full = TRUE;
+    return FALSE;
+  }
+  pu64Visited[u64Index] = u64Tag | u8Depth_Left;
+  u64Visited_Count++;
+  return TRUE;
+
+} /* end Visited_Add */
+
+/*------------------------------------------------------------------------------
+Function: State_Print
+
+Description: One line about the firmware's state
+
+Promises: Printed with the prefix
+*/
+void State_Print(const char* pcPrefix)
+{
+  printf("%s%2u:%02u %s +%d ticks  %-18s  P1OUT %02X P2OUT %02X P3OUT %02X  power %s  buttons %02X\n",
+         pcPrefix, LG_u8Hour_Counter, LG_u8Minute_Counter,
+#if CLOCK_24_HOUR
+         "",
+#else
+         LG_u8PM ? "PM" : "AM",
+#endif
+         GG_u8Second_Counter, Name((void*)GG_fpCLOCKSM), P1OUT, P2OUT, P3OUT,
+         (P2IN & P2_5_LOST_POWER_IND) ? "on" : "off", Buttons_Held());
+
+} /* end State_Print */
+
+/*------------------------------------------------------------------------------
+Function: Transition_Print
+
+Description: One line about how a state was reached
+
+Promises: Printed
+*/
+void Transition_Print(int iStep, const Transition* pFrom)
+{
+  printf("  %3d  %s", iStep, apcEvent_Name[pFrom->u8Event]);
+  if(pFrom->u8Nested < SOURCES)
+  {
+    printf(", then %s at point %u (%s)", apcEvent_Name[pFrom->u8Nested], pFrom->u16Point,
+           Name(pFrom->pvFunction));
+  }
+  printf("\n");
+
+} /* end Transition_Print */
+
+/*------------------------------------------------------------------------------
+Function: Violation_Print
+
+Description: The event sequence from the root to a state that breaks an invariant
+
+Promises: Printed, the firmware is left in the broken state
+*/
+void Violation_Print(Invariant eInvariant, int iLevel, const Transition* pLast)
+{
+  HostSnapshot sBroken;
+
+  Host_Save(&sBroken);
+  printf("\ninvariant \"%s\" broken after %d events:\n", apcInvariant_Name[eInvariant], iLevel + 1);
+  Host_Restore(&aNode[0].sHost);
+  State_Print("  from ");
+  for(int i = 1; i <= iLevel; i++)
+  {
+    Transition_Print(i, &aNode[i].sFrom);
+  }
+  Transition_Print(iLevel + 1, pLast);
+  Host_Restore(&sBroken);
+  State_Print("  to   ");
+  if(eInvariant == INVARIANT_MINUTE_KEPT)
+  {
+    printf("  the time is %ld ticks off\n", (long)((Clock_Ticks() - sGhost.s32Expected) % DAY_TICKS));
+  }
+
+} /* end Violation_Print */
+
+/*------------------------------------------------------------------------------
+Function: Invariant_Check
+
+Description: The invariants, with the firmware in the state a transition left it in
+
+Promises: Returns the first one broken, or INVARIANTS
+*/
+Invariant Invariant_Check(bool bSlept)
+{
+  bool bLit = (P1OUT & ~Port1_Clear_Mask) || (P2OUT & ~Port2_Clear_Mask) || (P3OUT & ~P3SEL & PORT3_LEDS);
+
+  if(!bSlept)
+  {
+    return INVARIANT_SLEEPS;
+  }
+#if CLOCK_24_HOUR
+  if(LG_u8Hour_Counter > 23 || LG_u8Minute_Counter > 59)
+#else
+  if(LG_u8Hour_Counter < 1 || LG_u8Hour_Counter > 12 || LG_u8Minute_Counter > 59 || LG_u8PM > 1)
+#endif
+  {
+    return INVARIANT_TIME_VALID;
+  }
+  if(bTime_Set)
+  {
+    sGhost.s32Expected = Clock_Ticks();
+  }
+  else if(Clock_Ticks() != sGhost.s32Expected || !Event_Enabled(SOURCE_TICK))
+  {
+    return INVARIANT_MINUTE_KEPT;
+  }
+  if(sGhost.u8Battery_Ticks >= DARK_TICKS && (GG_fpCLOCKSM != ClockSM_LP_Sleep || bLit))
+  {
+    return INVARIANT_DARK_ON_BATTERY;
+  }
+  return INVARIANTS;
+
+} /* end Invariant_Check */
+
+/*------------------------------------------------------------------------------
+Function: Transition_Run
+
+Description: Runs an event from a node's state, with a second event at one arrival point of the wake
+if u8Nested is not SOURCES, and checks the invariants after it
+
+Promises: Returns TRUE and fills in the child if the transition could happen and the result is a
+state not seen before.  A broken invariant is counted and printed the first time
+*/
+bool Transition_Run(int iLevel, u8 u8Event, u8 u8Nested, u16 u16Point)
+{
+  Node* pNode = &aNode[iLevel];
+  Node* pChild = &aNode[iLevel + 1];
+  Transition sFrom = {u8Event, u8Nested, u16Point, NULL};
+  Invariant eBroken;
+  bool bSlept;
+
+  Host_Restore(&pNode->sHost);
+  sGhost = pNode->sGhost;
+  u16Point_Count = 0;
+  u16Inject_At = u8Nested < SOURCES ? u16Point : 0;
+  u8Inject_Event = u8Nested;
+  bInject_Failed = FALSE;
+  pvInject_Function = NULL;
+  bTime_Set = FALSE;
+  pu16Enabled_Record = u8Nested < SOURCES ? NULL : pNode->au16Enabled;
+
+  Event_Deliver(u8Event);
+  bSlept = Host_Run();
+  if(u8Nested == SOURCES)
+  {
+    pNode->u16Points = u16Point_Count;
+    if(u16Point_Count > u16Max_Points)
+    {
+      u16Max_Points = u16Point_Count;
+    }
+  }
+  else if(bInject_Failed || u16Point_Count < u16Point)
+  {
+    return FALSE;
+  }
+  sFrom.pvFunction = pvInject_Function;
+  u64Transitions++;
+
+  eBroken = Invariant_Check(bSlept);
+  if(eBroken < INVARIANTS)
+  {
+    if(alBroken[eBroken]++ == 0 || bKeep_Going == FALSE)
+    {
+      Violation_Print(eBroken, iLevel, &sFrom);
+    }
+    bStop = !bKeep_Going;
+    return FALSE;
+  }
+
+  Host_Save(&pChild->sHost);
+  pChild->sGhost = sGhost;
+  if(!Visited_Add(State_Hash(&pChild->sHost, &pChild->sGhost), pNode->u8Depth_Left - 1))
+  {
+    return FALSE;
+  }
+  u64States++;
+  pChild->sFrom = sFrom;
+  pChild->u8Depth_Left = pNode->u8Depth_Left - 1;
+  pChild->u8Event = 0;
+  pChild->u8Nested = 0;
+  pChild->u16Point = 0;
+  pChild->u16Points = 0;
+  return TRUE;
+
+} /* end Transition_Run */
+
+/*------------------------------------------------------------------------------
+Function: Next_Child
+
+Description: Runs the next transitions from a node until one gives a new state.  Each event is run
+on its own first, which finds its arrival points and the events that could come at each one,
+then with each of those at each point.
+
+Promises: Returns TRUE with the new state in the next node, FALSE once every transition has been run
+*/
+bool Next_Child(int iLevel)
+{
+  Node* pNode = &aNode[iLevel];
+  u16 u16Point;
+  u8 u8Nested;
+
+  while(pNode->u8Event < SOURCES && !bStop)
+  {
+    if(pNode->u16Point == 0)
+    {
+      pNode->u16Point = 1;
+      pNode->u8Nested = 0;
+      pNode->u16Points = 0;
+      Host_Restore(&pNode->sHost);
+      if(!Event_Enabled(pNode->u8Event))
+      {
+        pNode->u8Event++;
+        pNode->u16Point = 0;
+        continue;
+      }
+      if(Transition_Run(iLevel, pNode->u8Event, SOURCES, 0))
+      {
+        return TRUE;
+      }
+      continue;
+    }
+    if(!bNested || pNode->u16Point > pNode->u16Points || pNode->u16Point > MAX_POINTS)
+    {
+      pNode->u8Event++;
+      pNode->u16Point = 0;
+      continue;
+    }
+    u16Point = pNode->u16Point;
+    u8Nested = pNode->u8Nested++;
+    if(pNode->u8Nested == SOURCES)
+    {
+      pNode->u8Nested = 0;
+      pNode->u16Point++;
+    }
+    if((pNode->au16Enabled[u16Point - 1] & (1 << u8Nested)) &&
+       Transition_Run(iLevel, pNode->u8Event, u8Nested, u16Point))
+    {
+      return TRUE;
+    }
+  }
+  return FALSE;
+
+} /* end Next_Child */
+
+/*------------------------------------------------------------------------------
+Function: Explore
+
+Description: Depth first search from the state the firmware is in now, iDepth events deep
+
+Promises: Every state within reach has been checked unless bStop or bVisited_Full
+*/
+void Explore(const char* pcRoot)
+{
+  int iLevel = 0;
+
+  Host_Save(&aNode[0].sHost);
+  aNode[0].sGhost.s32Expected = Clock_Ticks();
+  aNode[0].sGhost.u8Battery_Ticks = 0;
+  aNode[0].u8Depth_Left = iDepth;
+  aNode[0].u8Event = 0;
+  aNode[0].u16Point = 0;
+  State_Print(pcRoot);
+  if(!Visited_Add(State_Hash(&aNode[0].sHost, &aNode[0].sGhost), iDepth))
+  {
+    return;
+  }
+  u64States++;
+
+  while(iLevel >= 0 && !bStop)
+  {
+    if(aNode[iLevel].u8Depth_Left > 0 && Next_Child(iLevel))
+    {
+      iLevel++;
+    }
+    else
+    {
+      iLevel--;
+    }
+  }
+
+} /* end Explore */
+
+/*------------------------------------------------------------------------------
+Function: Root_Running
+
+Description: The clock set to the start time with the buttons and left running in ClockSM_Tick
+
+Promises: The main loop is asleep
+*/
+void Root_Running(void)
+{
+  Host_Reset();
+  Host_Run();
+  LG_u8Hour_Counter = u8Start_Hour;
+  LG_u8Minute_Counter = u8Start_Minute;
+#if !CLOCK_24_HOUR
+  LG_u8PM = u8Start_PM;
+#endif
+  GG_u8Second_Counter = iSecond;
+  GG_fpCLOCKSM = ClockSM_Tick;
+  GG_u8Wake_Countdown = 1;
+  Update_Display();
+
+} /* end Root_Running */
+
+void Usage(const char* pcName)
+{
+  fprintf(stderr, "usage: %s [-d depth] [-t hh:mm[am|pm]] [-s second_counter] [-m megabytes] [-r reset|running]\n"
+                  "          [-n] [-B] [-P] [-k]\n", pcName);
+  exit(2);
+
+} /* end Usage */
+
+int main(int argc, char** argv)
+{
+  struct timespec sStart, sEnd;
+  double dSeconds;
+  u64 u64Slots;
+  unsigned int uHour, uMinute;
+  char acHalf[3] = "";
+  int iOption;
+  int iBroken = 0;
+
+  while((iOption = getopt(argc, argv, "d:t:s:m:r:nBPk")) != -1)
+  {
+    switch(iOption)
+    {
+      case 'd': iDepth = atoi(optarg); break;
+      case 's': iSecond = atoi(optarg); break;
+      case 'm': iMegabytes = atoi(optarg); break;
+      case 'r': pcRoots = optarg; break;
+      case 'n': bNested = FALSE; break;
+      case 'B': bButtons_Together = TRUE; break;
+      case 'P': bPower = FALSE; break;
+      case 'k': bKeep_Going = TRUE; break;
+      case 't':
+        if(sscanf(optarg, "%u:%u%2s", &uHour, &uMinute, acHalf) < 2 || uMinute > 59)
+        {
+          Usage(argv[0]);
+        }
+        u8Start_Hour = (u8)uHour;
+        u8Start_Minute = (u8)uMinute;
+        u8Start_PM = (acHalf[0] == 'p' || acHalf[0] == 'P') ? 1 : 0;
+        break;
+      default:
+        Usage(argv[0]);
+    }
+  }
+  if(iDepth < 1 || iDepth > 255 || iMegabytes < 1)
+  {
+    Usage(argv[0]);
+  }
+
+  for(u64Slots = 1; u64Slots * 2 * sizeof(u64) <= (u64)iMegabytes << 20; u64Slots *= 2)
+  {
+  }
+  pu64Visited = calloc(u64Slots, sizeof(u64));
+  aNode = malloc(sizeof(Node) * (iDepth + 1));
+  if(!pu64Visited || !aNode)
+  {
+    fprintf(stderr, "out of memory\n");
+    return 2;
+  }
+  u64Visited_Mask = u64Slots - 1;
+
+  Host_Reset();
+  Key_Mask_Initialize();
+  GG_pfHost_Point = Point;
+  printf("%d events deep, %s, %d MB visited set\n", iDepth,
+         bNested ? "a second event at any point of a wake" : "events only while asleep", iMegabytes);
+
+  clock_gettime(CLOCK_MONOTONIC, &sStart);
+  if(strcmp(pcRoots, "running") != 0)
+  {
+    Host_Reset();
+    Host_Run();
+    Explore("reset    ");
+  }
+  if(strcmp(pcRoots, "reset") != 0 && !bStop)
+  {
+    Root_Running();
+    Explore("running  ");
+  }
+  clock_gettime(CLOCK_MONOTONIC, &sEnd);
+  dSeconds = (sEnd.tv_sec - sStart.tv_sec) + (sEnd.tv_nsec - sStart.tv_nsec) * 1e-9;
+
+  printf("\n%llu states, %llu transitions, up to %u arrival points in a wake, visited set %.1f%% full%s\n",
+         (unsigned long long)u64States, (unsigned long long)u64Transitions, u16Max_Points,
+         100.0 * u64Visited_Count / (u64Visited_Mask + 1), bVisited_Full ? ", FULL: not every state was explored" : "");
+  printf("%.2f s, %.0f states/s, %.0f transitions/s\n", dSeconds, u64States / dSeconds, u64Transitions / dSeconds);
+  for(int i = 0; i < INVARIANTS; i++)
+  {
+    printf("  %-16s %s", apcInvariant_Name[i], alBroken[i] ? "BROKEN" : "holds");
+    if(alBroken[i])
+    {
+      printf(" (%ld)", alBroken[i]);
+      iBroken++;
+    }
+    printf("\n");
+  }
+  if(bStop)
+  {
+    printf("stopped at the first broken invariant, -k to carry on\n");
+  }
+  return iBroken != 0;
+
+} /* end main */
@@ -0,0 +1,425 @@
+/**********************************************************************
+* Recording and replaying simulated runs, see replay.h
+
+Replay_Input is the run's fnSim_Input_type both ways: recording it passes on what the source gives
+and writes it down, replaying it reads it back.  The run is cut into slices of u64Interval by the
+caller, with Replay_Checkpoint between them, the same way when recording and replaying so the two
+runs stop at the same times.
+**********************************************************************/
+
+/************************ Revision History ****************************
+YYYY-MM-DD  Comments
+-------------------------------------------------------------------------------------------
+2026-10-19  File created
+
+************************************************************************/
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include "replay.h"
+#include "bnclk-efwd-01.h"
+
+/******************** Local Globals ************************/
+Replay* LG_pReplay = NULL;                        //the one Replay_Input records or replays
+
+/******************** Function Definitions ************************/
+
+/*------------------------------------------------------------------------------
+Function: Replay_Packed_Size
+
+Description: The bytes of a packed SimSnapshot, see replay.h
+
+Promises: Returns it for the RAM size given
+*/
+u32 Replay_Packed_Size(u32 u32Ram_Used)
+{
+  return offsetof(SimSnapshot, sHost) + HOST_IO_SAVED + 3 + u32Ram_Used;
+
+} /* end Replay_Packed_Size */
+
+/*------------------------------------------------------------------------------
+Function: Replay_Pack
+
+Description: A snapshot without the RAM the firmware does not use
+
+Promises: pu8Out has Replay_Packed_Size(HOST_RAM_USED) bytes of it
+*/
+void Replay_Pack(const SimSnapshot* pSnapshot, u8* pu8Out)
+{
+  memcpy(pu8Out, pSnapshot, offsetof(SimSnapshot, sHost));
+  pu8Out += offsetof(SimSnapshot, sHost);
+  memcpy(pu8Out, pSnapshot->sHost.au8Io, HOST_IO_SAVED);
+  pu8Out += HOST_IO_SAVED;
+  *pu8Out++ = (u8)pSnapshot->sHost.u16SR;
+  *pu8Out++ = (u8)(pSnapshot->sHost.u16SR >> 8);
+  *pu8Out++ = pSnapshot->sHost.u8Woken;
+  memcpy(pu8Out, pSnapshot->sHost.au8Ram, HOST_RAM_USED);
+
+} /* end Replay_Pack */
+
+/*------------------------------------------------------------------------------
+Function: Replay_Unpack
+
+Description: The other way from Replay_Pack
+
+Promises: pSnapshot is the snapshot, the RAM after HOST_RAM_USED zero
+*/
+void Replay_Unpack(const u8* pu8In, SimSnapshot* pSnapshot)
+{
+  memset(pSnapshot, 0, sizeof(*pSnapshot));
+  memcpy(pSnapshot, pu8In, offsetof(SimSnapshot, sHost));
+  pu8In += offsetof(SimSnapshot, sHost);
+  memcpy(pSnapshot->sHost.au8Io, pu8In, HOST_IO_SAVED);
+  pu8In += HOST_IO_SAVED;
+  pSnapshot->sHost.u16SR = (u16)(pu8In[0] | (pu8In[1] << 8));
+  pSnapshot->sHost.u8Woken = pu8In[2];
+  memcpy(pSnapshot->sHost.au8Ram, pu8In + 3, HOST_RAM_USED);
+
+} /* end Replay_Unpack */
+
+/*------------------------------------------------------------------------------
+Function: Replay_Pins
+
+Description: The input pins of a SimInput in 4 bits
+
+Promises: Returns the REPLAY_PIN_* bits of the pins that are high
+*/
+u8 Replay_Pins(const SimInput* pInput)
+{
+  return ((pInput->u8P2IN & P2_1_BUTTON_0) ? REPLAY_PIN_BUTTON_0 : 0) |
+         ((pInput->u8P2IN & P2_5_LOST_POWER_IND) ? REPLAY_PIN_LOST_POWER : 0) |
+         ((pInput->u8P3IN & P3_6_BUTTON_2) ? REPLAY_PIN_BUTTON_2 : 0) |
+         ((pInput->u8P3IN & P3_7_BUTTON_1) ? REPLAY_PIN_BUTTON_1 : 0);
+
+} /* end Replay_Pins */
+
+/*------------------------------------------------------------------------------
+Function: Replay_Create
+
+Description: Starts recording a run to a file, with the inputs from pfSource (NULL for none)
+
+Requires: u64Interval is not 0.  Sim_Reset(Replay_Input) starts the run after this.
+Promises: Returns FALSE if the file cannot be created
+*/
+bool Replay_Create(Replay* pReplay, const char* pcPath, fnSim_Input_type pfSource, u64 u64Interval)
+{
+  memset(pReplay, 0, sizeof(*pReplay));
+  pReplay->pcPath = pcPath;
+  if(!(pReplay->pFile = fopen(pcPath, "wb")))
+  {
+    return FALSE;
+  }
+  memcpy(pReplay->sHeader.acMagic, REPLAY_MAGIC, sizeof(REPLAY_MAGIC));
+  pReplay->sHeader.u32Version = REPLAY_VERSION;
+  pReplay->sHeader.u32Ram_Used = HOST_RAM_USED;
+  pReplay->sHeader.u64Build = (u64)(size_t)Sim_Reset;
+  pReplay->sHeader.u64Interval = u64Interval;
+  fwrite(&pReplay->sHeader, sizeof(pReplay->sHeader), 1, pReplay->pFile);
+  pReplay->bRecording = TRUE;
+  pReplay->bSame_Build = TRUE;
+  pReplay->pfSource = pfSource;
+  LG_pReplay = pReplay;
+  return TRUE;
+
+} /* end Replay_Create */
+
+/*------------------------------------------------------------------------------
+Function: Replay_Open
+
+Description: Opens a recording to replay, with its index of checkpoints
+
+Requires: Sim_Reset(Replay_Input) starts the run after this, then Replay_Seek if it is to start later
+Promises: Returns FALSE, with the reason on stderr, if it is not a whole recording of this version
+*/
+bool Replay_Open(Replay* pReplay, const char* pcPath)
+{
+  memset(pReplay, 0, sizeof(*pReplay));
+  pReplay->pcPath = pcPath;
+  if(!(pReplay->pFile = fopen(pcPath, "rb")))
+  {
+    perror(pcPath);
+    return FALSE;
+  }
+  if(fread(&pReplay->sHeader, sizeof(pReplay->sHeader), 1, pReplay->pFile) != 1 ||
+     memcmp(pReplay->sHeader.acMagic, REPLAY_MAGIC, sizeof(REPLAY_MAGIC)) ||
+     pReplay->sHeader.u32Version != REPLAY_VERSION || pReplay->sHeader.u64Index_Offset == 0)
+  {
+    fprintf(stderr, "%s: not a version %d recording, or the run did not finish\n", pcPath, REPLAY_VERSION);
+    fclose(pReplay->pFile);
+    return FALSE;
+  }
+  pReplay->pIndex = malloc((pReplay->sHeader.u64Checkpoints + 1) * sizeof(ReplayIndex));
+  fseek(pReplay->pFile, (long)pReplay->sHeader.u64Index_Offset, SEEK_SET);
+  if(fread(pReplay->pIndex, sizeof(ReplayIndex), pReplay->sHeader.u64Checkpoints, pReplay->pFile) !=
+     pReplay->sHeader.u64Checkpoints)
+  {
+    fprintf(stderr, "%s: the index is cut short\n", pcPath);
+    Replay_Close(pReplay, 0);
+    return FALSE;
+  }
+  fseek(pReplay->pFile, sizeof(pReplay->sHeader), SEEK_SET);
+  pReplay->bSame_Build = (pReplay->sHeader.u64Build == (u64)(size_t)Sim_Reset &&
+                          pReplay->sHeader.u32Ram_Used == HOST_RAM_USED) ? TRUE : FALSE;
+  if(!pReplay->bSame_Build && pReplay->sHeader.u64Checkpoints)
+  {
+    fprintf(stderr, "%s: written by another build, its inputs replay but its checkpoints are not used\n", pcPath);
+  }
+  LG_pReplay = pReplay;
+  return TRUE;
+
+} /* end Replay_Open */
+
+/*------------------------------------------------------------------------------
+Function: Replay_Input
+
+Description: fnSim_Input_type of a recorded run.  Recording it takes the next input from the
+source and writes it, replaying it reads the next one, stepping over the checkpoints.
+
+Requires: The source gives its inputs in time order, as fnSim_Input_type says
+Promises: Returns the next input, FALSE when there are no more
+*/
+bool Replay_Input(SimInput* pInput)
+{
+  Replay* pReplay = LG_pReplay;
+  u64 u64Delta;
+  int iByte;
+  u8 u8Shift;
+
+  if(!pReplay || pReplay->bEnd)
+  {
+    return FALSE;
+  }
+  if(pReplay->bRecording)
+  {
+    if(!pReplay->pfSource || !pReplay->pfSource(pInput))
+    {
+      fputc(REPLAY_END, pReplay->pFile);
+      pReplay->bEnd = TRUE;
+      return FALSE;
+    }
+    if(pInput->u64Time < pReplay->u64Last)
+    {
+      pInput->u64Time = pReplay->u64Last;
+    }
+    fputc(REPLAY_INPUT | Replay_Pins(pInput), pReplay->pFile);
+    for(u64Delta = pInput->u64Time - pReplay->u64Last; u64Delta >= 0x80; u64Delta >>= 7)
+    {
+      fputc((int)(u64Delta | 0x80) & 0xFF, pReplay->pFile);
+    }
+    fputc((int)u64Delta, pReplay->pFile);
+    pReplay->u64Last = pInput->u64Time;
+    pReplay->sHeader.u64Inputs++;
+    return TRUE;
+  }
+
+  for(;;)
+  {
+    if((u64)ftell(pReplay->pFile) >= pReplay->sHeader.u64Index_Offset || (iByte = fgetc(pReplay->pFile)) == EOF ||
+       (iByte & 0xF0) == REPLAY_END)
+    {
+      pReplay->bEnd = TRUE;
+      return FALSE;
+    }
+    if((iByte & 0xF0) != REPLAY_CHECKPOINT)
+    {
+      break;
+    }
+    fseek(pReplay->pFile, sizeof(ReplayCheckpoint) + Replay_Packed_Size(pReplay->sHeader.u32Ram_Used), SEEK_CUR);
+  }
+  pInput->u8P2IN = SIM_PINS_IDLE_P2 & ~((iByte & REPLAY_PIN_BUTTON_0 ? 0 : P2_1_BUTTON_0) |
+                                        (iByte & REPLAY_PIN_LOST_POWER ? 0 : P2_5_LOST_POWER_IND));
+  pInput->u8P3IN = SIM_PINS_IDLE_P3 & ~((iByte & REPLAY_PIN_BUTTON_2 ? 0 : P3_6_BUTTON_2) |
+                                        (iByte & REPLAY_PIN_BUTTON_1 ? 0 : P3_7_BUTTON_1));
+  u64Delta = 0;
+  u8Shift = 0;
+  do
+  {
+    iByte = fgetc(pReplay->pFile);
+    u64Delta |= (u64)(iByte & 0x7F) << u8Shift;
+    u8Shift += 7;
+  } while(iByte & 0x80);
+  pReplay->u64Last += u64Delta;
+  pInput->u64Time = pReplay->u64Last;
+  return TRUE;
+
+} /* end Replay_Input */
+
+/*------------------------------------------------------------------------------
+Function: Replay_Checkpoint
+
+Description: Between two slices of the run.  Recording it writes a checkpoint, replaying it
+compares the run with the checkpoint the recording wrote here.
+
+Requires: The main loop is asleep, Sim_Run has returned
+Promises: A difference is reported on stderr the first time, with bDiverged set
+*/
+void Replay_Checkpoint(Replay* pReplay)
+{
+  SimSnapshot sSnapshot;
+  ReplayCheckpoint sCheckpoint;
+  u8 au8Now[REPLAY_PACKED_MAX];
+  u8 au8Then[REPLAY_PACKED_MAX];
+  u32 u32Size = Replay_Packed_Size(HOST_RAM_USED);
+  const ReplayIndex* pEntry;
+  long lHere;
+  u32 u32At = 0;
+
+  Sim_Save(&sSnapshot);
+  Replay_Pack(&sSnapshot, au8Now);
+  if(pReplay->bRecording)
+  {
+    if(pReplay->sHeader.u64Checkpoints == pReplay->u64Index_Room)
+    {
+      pReplay->u64Index_Room = pReplay->u64Index_Room ? 2 * pReplay->u64Index_Room : 1024;
+      pReplay->pIndex = realloc(pReplay->pIndex, pReplay->u64Index_Room * sizeof(ReplayIndex));
+    }
+    pReplay->pIndex[pReplay->sHeader.u64Checkpoints].u64Time = GG_u64Sim_Time;
+    pReplay->pIndex[pReplay->sHeader.u64Checkpoints].u64Offset = (u64)ftell(pReplay->pFile);
+    pReplay->sHeader.u64Checkpoints++;
+    sCheckpoint.u64Inputs = pReplay->sHeader.u64Inputs;
+    sCheckpoint.u64Last_Input = pReplay->u64Last;
+    fputc(REPLAY_CHECKPOINT, pReplay->pFile);
+    fwrite(&sCheckpoint, sizeof(sCheckpoint), 1, pReplay->pFile);
+    fwrite(au8Now, 1, u32Size, pReplay->pFile);
+    pReplay->u64Checkpoint++;
+    return;
+  }
+
+  if(!pReplay->bSame_Build || pReplay->u64Checkpoint >= pReplay->sHeader.u64Checkpoints)
+  {
+    return;
+  }
+  pEntry = &pReplay->pIndex[pReplay->u64Checkpoint++];
+  lHere = ftell(pReplay->pFile);
+  fseek(pReplay->pFile, (long)(pEntry->u64Offset + 1 + sizeof(ReplayCheckpoint)), SEEK_SET);
+  if(fread(au8Then, 1, u32Size, pReplay->pFile) != u32Size)
+  {
+    memset(au8Then, 0xFF, u32Size);
+  }
+  fseek(pReplay->pFile, lHere, SEEK_SET);
+  if(pEntry->u64Time == GG_u64Sim_Time && !memcmp(au8Now, au8Then, u32Size))
+  {
+    pReplay->u64Matched++;
+    return;
+  }
+  if(!pReplay->bDiverged)
+  {
+    while(u32At < u32Size && au8Now[u32At] == au8Then[u32At])
+    {
+      u32At++;
+    }
+    fprintf(stderr, "%s: checkpoint %llu at %.3f s is not the run, which is at %.3f s: ", pReplay->pcPath,
+            pReplay->u64Checkpoint - 1, (double)pEntry->u64Time / TRACE_ACLK_HZ, (double)GG_u64Sim_Time / TRACE_ACLK_HZ);
+    if(u32At < offsetof(SimSnapshot, sHost))
+    {
+      fprintf(stderr, "the timers, flags or counts of sim.c differ (byte %lu)\n", u32At);
+    }
+    else if(u32At < offsetof(SimSnapshot, sHost) + HOST_IO_SAVED)
+    {
+      fprintf(stderr, "the register at 0x%03lX differs\n", u32At - offsetof(SimSnapshot, sHost));
+    }
+    else if(u32At < offsetof(SimSnapshot, sHost) + HOST_IO_SAVED + 3)
+    {
+      fprintf(stderr, "SR differs\n");
+    }
+    else
+    {
+      fprintf(stderr, "the firmware's RAM differs at %p\n",
+              (void*)(__start_firmware_ram + u32At - (offsetof(SimSnapshot, sHost) + HOST_IO_SAVED + 3)));
+    }
+  }
+  pReplay->bDiverged = TRUE;
+
+} /* end Replay_Checkpoint */
+
+/*------------------------------------------------------------------------------
+Function: Replay_Seek
+
+Description: Starts a replay from the last checkpoint at or before a time
+
+Requires: Replay_Open then Sim_Reset(Replay_Input), nothing run yet
+Promises: Returns FALSE if the checkpoints cannot be used.  Otherwise the run is at the
+checkpoint, or still at the reset if there is none before u64Time, and Replay_Input carries on
+from there
+*/
+bool Replay_Seek(Replay* pReplay, u64 u64Time)
+{
+  SimSnapshot sSnapshot;
+  ReplayCheckpoint sCheckpoint;
+  u8 au8Packed[REPLAY_PACKED_MAX];
+  u64 u64Low = 0;
+  u64 u64High = pReplay->sHeader.u64Checkpoints;
+  u64 u64Middle;
+
+  if(!pReplay->bSame_Build)
+  {
+    return FALSE;
+  }
+
+  /* The first checkpoint after u64Time is u64Low */
+  while(u64Low < u64High)
+  {
+    u64Middle = (u64Low + u64High) / 2;
+    if(pReplay->pIndex[u64Middle].u64Time <= u64Time)
+    {
+      u64Low = u64Middle + 1;
+    }
+    else
+    {
+      u64High = u64Middle;
+    }
+  }
+  if(u64Low == 0)
+  {
+    return TRUE;
+  }
+  fseek(pReplay->pFile, (long)(pReplay->pIndex[u64Low - 1].u64Offset + 1), SEEK_SET);
+  if(fread(&sCheckpoint, sizeof(sCheckpoint), 1, pReplay->pFile) != 1 ||
+     fread(au8Packed, 1, Replay_Packed_Size(HOST_RAM_USED), pReplay->pFile) != Replay_Packed_Size(HOST_RAM_USED))
+  {
+    fprintf(stderr, "%s: checkpoint %llu is cut short\n", pReplay->pcPath, u64Low - 1);
+    return FALSE;
+  }
+  Replay_Unpack(au8Packed, &sSnapshot);
+  Sim_Restore(&sSnapshot, Replay_Input);
+  pReplay->u64Last = sCheckpoint.u64Last_Input;
+  pReplay->bEnd = FALSE;
+  pReplay->u64Checkpoint = u64Low;
+  return TRUE;
+
+} /* end Replay_Seek */
+
+/*------------------------------------------------------------------------------
+Function: Replay_Close
+
+Description: Ends a recording with its index and the header with the totals, or a replay
+
+Promises: Returns FALSE if a write failed, the memory is freed either way
+*/
+bool Replay_Close(Replay* pReplay, u64 u64End_Time)
+{
+  bool bGood = TRUE;
+
+  if(pReplay->bRecording)
+  {
+    pReplay->sHeader.u64End_Time = u64End_Time;
+    pReplay->sHeader.u64Index_Offset = (u64)ftell(pReplay->pFile);
+    fwrite(pReplay->pIndex, sizeof(ReplayIndex), pReplay->sHeader.u64Checkpoints, pReplay->pFile);
+    fseek(pReplay->pFile, 0, SEEK_SET);
+    fwrite(&pReplay->sHeader, sizeof(pReplay->sHeader), 1, pReplay->pFile);
+    bGood = ferror(pReplay->pFile) ? FALSE : TRUE;
+  }
+  if(fclose(pReplay->pFile))
+  {
+    bGood = FALSE;
+  }
+  free(pReplay->pIndex);
+  pReplay->pIndex = NULL;
+  if(LG_pReplay == pReplay)
+  {
+    LG_pReplay = NULL;
+  }
+  return bGood;
+
+} /* end Replay_Close */
@@ -0,0 +1,118 @@
+/**********************************************************************
+* Header file for recording and replaying simulated runs
+
+The timer model of sim.c is exact and the firmware on the host does the same thing every time, so
+the only thing in a run that does not follow from the reset is the input pins: the buttons and
+LOST_POWER_IND that Poll_Buttons, ClockSM_Button_Press, ClockSM_LP_Sleep and Port2ISR read, and
+the port 2 edges that wake it.  A replay log has every change of them as the run fetched it, and a
+run from the log is the same run bit for bit, whatever gave the inputs the first time.
+
+The log also has a checkpoint every u64Interval counts: a SimSnapshot of the firmware's RAM, the
+registers and the timers, about 1.3 kB.  Replay_Seek starts from the last one before a time, so a
+fault late in a long run is reached without the run up to it, and a replay compares every
+checkpoint it passes with the recording to show where two runs part.
+
+The file is a header, the records, then the index of the checkpoints:
+  - an input is a byte with REPLAY_INPUT in the high 4 bits and the pins in the low 4 (REPLAY_PIN_*),
+    then the counts since the input before it as an unsigned LEB128 number
+  - a checkpoint is a byte of REPLAY_CHECKPOINT, a ReplayCheckpoint, then the SimSnapshot packed:
+    the part before sHost, the registers, SR, the woken flag, then u32Ram_Used bytes of RAM
+  - REPLAY_END is the input source saying there are no more
+The snapshots hold the firmware's function pointers, so checkpoints are only used by the executable
+that wrote them (u64Build), which is linked without PIE; the inputs replay in any build.
+
+Build:   part of libfirmware.a, see the Makefile
+Use:     clock_sim -s scenario -d 365 -r year.replay          then
+         clock_sim -p year.replay -f 31000000 -o end.trace
+**********************************************************************/
+
+/************************ Revision History ****************************
+YYYY-MM-DD  Comments
+-------------------------------------------------------------------------------------------
+2026-10-19  File created
+
+************************************************************************/
+
+#ifndef __REPLAY_HEADER
+#define __REPLAY_HEADER
+
+#include <stdio.h>
+#include "sim.h"
+
+/****************************************************************************************
+Constants
+****************************************************************************************/
+
+#define REPLAY_MAGIC           "BCLKRPL"
+#define REPLAY_VERSION         1
+#define REPLAY_INTERVAL_DEFAULT (86400ULL * TRACE_ACLK_HZ)   /* a checkpoint a day */
+
+#define REPLAY_INPUT           0x00      /* record kinds, the high 4 bits of the first byte */
+#define REPLAY_CHECKPOINT      0x10
+#define REPLAY_END             0x20
+
+#define REPLAY_PIN_BUTTON_0    0x01      /* P2_1_BUTTON_0 */
+#define REPLAY_PIN_LOST_POWER  0x02      /* P2_5_LOST_POWER_IND */
+#define REPLAY_PIN_BUTTON_2    0x04      /* P3_6_BUTTON_2 */
+#define REPLAY_PIN_BUTTON_1    0x08      /* P3_7_BUTTON_1 */
+
+#define REPLAY_PACKED_MAX      (sizeof(SimSnapshot))
+
+/******************************************************************************
+Type Definitions
+******************************************************************************/
+
+typedef struct
+{
+  char acMagic[8];
+  u32 u32Version;
+  u32 u32Ram_Used;                       //HOST_RAM_USED of the executable that wrote it
+  u64 u64Build;                          //the address of Sim_Reset in it
+  u64 u64Interval;                       //counts between checkpoints
+  u64 u64Inputs;
+  u64 u64End_Time;
+  u64 u64Index_Offset;
+  u64 u64Checkpoints;
+} ReplayHeader;
+
+/* Before each checkpoint's snapshot */
+typedef struct
+{
+  u64 u64Inputs;                         //inputs before it in the log
+  u64 u64Last_Input;                     //the time of the last of them, the next input's delta is from it
+} ReplayCheckpoint;
+
+/* The index, a checkpoint's time and the offset of its first byte */
+typedef struct
+{
+  u64 u64Time;
+  u64 u64Offset;
+} ReplayIndex;
+
+typedef struct
+{
+  FILE* pFile;
+  const char* pcPath;
+  ReplayHeader sHeader;
+  bool bRecording;
+  bool bSame_Build;                      //the checkpoints can be used
+  fnSim_Input_type pfSource;             //recording, where the inputs come from
+  u64 u64Last;                           //time of the last input
+  bool bEnd;                             //there are no more inputs
+  ReplayIndex* pIndex;
+  u64 u64Index_Room;
+  u64 u64Checkpoint;                     //the next one to write or compare
+  u64 u64Matched;                        //replaying, checkpoints that were the same
+  bool bDiverged;
+} Replay;
+
+/************************ Function Declarations ****************************/
+
+bool Replay_Create(Replay* pReplay, const char* pcPath, fnSim_Input_type pfSource, u64 u64Interval);
+bool Replay_Open(Replay* pReplay, const char* pcPath);
+bool Replay_Input(SimInput* pInput);
+bool Replay_Seek(Replay* pReplay, u64 u64Time);
+void Replay_Checkpoint(Replay* pReplay);
+bool Replay_Close(Replay* pReplay, u64 u64End_Time);
+
+#endif /* __REPLAY_HEADER */
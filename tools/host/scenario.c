@@ -0,0 +1,736 @@
+/**********************************************************************
+* Simulator scenarios, see scenario.h
+
+Scenario_Open checks every line of the file once and notes where each track starts, then goes back
+to the start.  From then on each track, and the statements outside them, has its own FILE reading
+the same file, and all that is kept of it is the statement read ahead and the repeats being run: a
+repeat goes back to the line after it with fseek at its end.  Scenario_Input takes whichever comes
+first of the statements read ahead and the releases of the buttons and power that are held.
+**********************************************************************/
+
+/************************ Revision History ****************************
+YYYY-MM-DD  Comments
+-------------------------------------------------------------------------------------------
+2026-10-19  File created
+
+************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include "scenario.h"
+#include "bnclk-efwd-01.h"
+
+/******************** Local Globals ************************/
+Scenario* LG_pScenario = NULL;                    //the one Scenario_Input reads
+
+#define SCENARIO_TOKENS        16
+
+/* The pin each button pulls low, then LOST_POWER_IND */
+const u8 LG_au8Scenario_Pin[SCENARIO_HELD] = {P2_1_BUTTON_0, P3_7_BUTTON_1, P3_6_BUTTON_2, P2_5_LOST_POWER_IND};
+const bool LG_abScenario_P2[SCENARIO_HELD] = {TRUE, FALSE, FALSE, TRUE};
+
+/******************** Function Definitions ************************/
+
+/*------------------------------------------------------------------------------
+Function: Scenario_Part
+
+Description: One word of a SPAN: hh:mm[:ss] or numbers each with a unit, 1d3h
+
+Promises: Returns TRUE with the seconds added to pdSeconds if it is one
+*/
+bool Scenario_Part(const char* pcWord, double* pdSeconds)
+{
+  const char* apcUnit[] = {"ms", "s", "m", "h", "d"};
+  const double adUnit[] = {0.001, 1, 60, 3600, 86400};
+  unsigned uHours;
+  unsigned uMinutes;
+  double dSeconds = 0;
+  double dNumber;
+  char* pcEnd;
+  int iUsed;
+  u8 i;
+
+  if(strchr(pcWord, ':'))
+  {
+    iUsed = 0;
+    if(sscanf(pcWord, "%u:%u%n", &uHours, &uMinutes, &iUsed) < 2 || uMinutes > 59 ||
+       (pcWord[iUsed] && (pcWord[iUsed] != ':' || sscanf(pcWord + iUsed + 1, "%lf", &dSeconds) != 1 || dSeconds >= 60)))
+    {
+      return FALSE;
+    }
+    *pdSeconds += uHours * 3600.0 + uMinutes * 60.0 + dSeconds;
+    return TRUE;
+  }
+  if(!*pcWord)
+  {
+    return FALSE;
+  }
+  while(*pcWord)
+  {
+    dNumber = strtod(pcWord, &pcEnd);
+    if(pcEnd == pcWord || dNumber < 0)
+    {
+      return FALSE;
+    }
+    for(i = 0; i < 5; i++)
+    {
+      /* "m" must not take the m of "ms" */
+      if(!strncmp(pcEnd, apcUnit[i], strlen(apcUnit[i])) && !(i == 2 && pcEnd[1] == 's'))
+      {
+        break;
+      }
+    }
+    if(i == 5)
+    {
+      return FALSE;
+    }
+    dSeconds += dNumber * adUnit[i];
+    pcWord = pcEnd + strlen(apcUnit[i]);
+  }
+  *pdSeconds += dSeconds;
+  return TRUE;
+
+} /* end Scenario_Part */
+
+/*------------------------------------------------------------------------------
+Function: Scenario_Span
+
+Description: A SPAN, the words from *pu8Word on for as long as they are parts of one
+
+Promises: Returns TRUE if there was at least one, with *pu8Word after the last
+*/
+bool Scenario_Span(char** ppcWord, u8 u8Words, u8* pu8Word, double* pdSeconds)
+{
+  u8 u8First = *pu8Word;
+
+  *pdSeconds = 0;
+  while(*pu8Word < u8Words && Scenario_Part(ppcWord[*pu8Word], pdSeconds))
+  {
+    (*pu8Word)++;
+  }
+  return *pu8Word > u8First;
+
+} /* end Scenario_Span */
+
+/*------------------------------------------------------------------------------
+Function: Scenario_Number
+
+Description: A number that is the whole word
+
+Promises: Returns TRUE if it is one
+*/
+bool Scenario_Number(const char* pcWord, double* pdNumber)
+{
+  char* pcEnd;
+
+  *pdNumber = strtod(pcWord, &pcEnd);
+  return pcEnd != pcWord && !*pcEnd;
+
+} /* end Scenario_Number */
+
+/*------------------------------------------------------------------------------
+Function: Scenario_Parse
+
+Description: Splits a line into its statement
+
+Requires: pcPath and u32Line are where the line is, for the message
+Promises: Returns FALSE with a message on stderr if it is not a statement; a blank line or a
+comment is SCENARIO_NONE
+*/
+bool Scenario_Parse(const char* pcPath, u32 u32Line, char* pcText, ScenarioLine* pLine)
+{
+  char* apcWord[SCENARIO_TOKENS];
+  u8 u8Words = 0;
+  u8 u8Word = 0;
+  char* pcWord;
+  const char* pcError = NULL;
+
+  memset(pLine, 0, sizeof(*pLine));
+  if((pcWord = strchr(pcText, '#')))
+  {
+    *pcWord = '\0';
+  }
+  for(pcWord = strtok(pcText, " \t\r\n"); pcWord && u8Words < SCENARIO_TOKENS; pcWord = strtok(NULL, " \t\r\n"))
+  {
+    apcWord[u8Words++] = pcWord;
+  }
+  if(u8Words == 0)
+  {
+    return TRUE;
+  }
+
+  if(!strcmp(apcWord[0], "at"))
+  {
+    u8Word = 1;
+    pLine->bTime = TRUE;
+    if(u8Word < u8Words && apcWord[u8Word][0] == '+')
+    {
+      pLine->bRelative = TRUE;
+      if(!*++apcWord[u8Word])
+      {
+        u8Word++;
+      }
+    }
+    if(!Scenario_Span(apcWord, u8Words, &u8Word, &pLine->dTime))
+    {
+      pcError = "a TIME after at";
+    }
+  }
+  if(!pcError && u8Word == u8Words)
+  {
+    pcError = "a statement";
+  }
+  else if(!pcError)
+  {
+    pcWord = apcWord[u8Word++];
+    if(!strcmp(pcWord, "press"))
+    {
+      pLine->u8Statement = SCENARIO_PRESS;
+      if(u8Word == u8Words || strlen(apcWord[u8Word]) != 1 || apcWord[u8Word][0] < '0' || apcWord[u8Word][0] > '2')
+      {
+        pcError = "button 0, 1 or 2";
+      }
+      else
+      {
+        pLine->u8Button = apcWord[u8Word++][0] - '0';
+      }
+    }
+    else if(!strcmp(pcWord, "power") && u8Word < u8Words && !strcmp(apcWord[u8Word], "off"))
+    {
+      pLine->u8Statement = SCENARIO_POWER_OFF;
+      u8Word++;
+    }
+    else if(!strcmp(pcWord, "power") && u8Word < u8Words && !strcmp(apcWord[u8Word], "on"))
+    {
+      pLine->u8Statement = SCENARIO_POWER_ON;
+      u8Word++;
+    }
+    else if(!strcmp(pcWord, "ppm") || !strcmp(pcWord, "temp"))
+    {
+      pLine->u8Statement = pcWord[0] == 'p' ? SCENARIO_PPM : SCENARIO_TEMP;
+      if(u8Word == u8Words || !Scenario_Number(apcWord[u8Word++], &pLine->dValue))
+      {
+        pcError = "a number";
+      }
+    }
+    else if(!strcmp(pcWord, "repeat"))
+    {
+      pLine->u8Statement = SCENARIO_REPEAT;
+      if(u8Word < u8Words && !strcmp(apcWord[u8Word], "forever"))
+      {
+        u8Word++;
+      }
+      else if(u8Word == u8Words || !Scenario_Number(apcWord[u8Word++], &pLine->dValue) || pLine->dValue < 1 ||
+              pLine->dValue != (double)(u64)pLine->dValue)
+      {
+        pcError = "a COUNT of 1 or more, or forever";
+      }
+    }
+    else if(!strcmp(pcWord, "track"))
+    {
+      pLine->u8Statement = SCENARIO_TRACK;
+    }
+    else if(!strcmp(pcWord, "end"))
+    {
+      pLine->u8Statement = SCENARIO_END;
+    }
+    else
+    {
+      pcError = "press, power off, power on, ppm, temp, repeat, track or end";
+    }
+  }
+
+  /* for, over or every, which the statement must have or may have */
+  if(!pcError && u8Word < u8Words)
+  {
+    pcWord = apcWord[u8Word++];
+    if(!((!strcmp(pcWord, "for") && (pLine->u8Statement == SCENARIO_PRESS || pLine->u8Statement == SCENARIO_POWER_OFF)) ||
+         (!strcmp(pcWord, "over") && (pLine->u8Statement == SCENARIO_PPM || pLine->u8Statement == SCENARIO_TEMP)) ||
+         (!strcmp(pcWord, "every") && pLine->u8Statement == SCENARIO_REPEAT)) ||
+       !Scenario_Span(apcWord, u8Words, &u8Word, &pLine->dSpan))
+    {
+      pcError = "for SPAN, over SPAN or every SPAN, as the statement has them";
+    }
+  }
+  if(!pcError && pLine->u8Statement == SCENARIO_REPEAT && pLine->dSpan <= 0)
+  {
+    pcError = "every SPAN, more than 0";
+  }
+  if(!pcError && u8Word < u8Words)
+  {
+    pcError = "the end of the line";
+  }
+  if(!pcError && (pLine->u8Statement == SCENARIO_END || pLine->u8Statement == SCENARIO_TRACK) && pLine->bTime)
+  {
+    pcError = "end or track without a TIME";
+  }
+  if(!pcError && pLine->u8Statement < SCENARIO_REPEAT && !pLine->bTime)
+  {
+    pcError = "at TIME";
+  }
+  if(pcError)
+  {
+    fprintf(stderr, "%s:%lu: expected %s\n", pcPath, u32Line, pcError);
+    return FALSE;
+  }
+  return TRUE;
+
+} /* end Scenario_Parse */
+
+/*------------------------------------------------------------------------------
+Function: Scenario_Read
+
+Description: Reads on to a track's next statement that happens at a time, running its repeats.
+The statements outside the tracks skip over the tracks.
+
+Promises: It is in sNext at dNext with bNext set, or bNext is clear and bDone set at the end of
+the track or on an error
+*/
+void Scenario_Read(Scenario* pScenario, ScenarioTrack* pTrack)
+{
+  char acText[SCENARIO_LINE_SIZE];
+  ScenarioLine sLine;
+  ScenarioRepeat* pRepeat;
+  double dTime;
+  u8 u8Open;
+
+  pTrack->bNext = FALSE;
+  while(!pTrack->bDone)
+  {
+    if(!fgets(acText, sizeof(acText), pTrack->pFile))
+    {
+      pTrack->bDone = TRUE;
+      return;
+    }
+    pTrack->u32Line++;
+    if(!Scenario_Parse(pScenario->pcPath, pTrack->u32Line, acText, &sLine))
+    {
+      pScenario->bError = TRUE;
+      pTrack->bDone = TRUE;
+      return;
+    }
+    switch(sLine.u8Statement)
+    {
+      case SCENARIO_NONE:
+        continue;
+
+      case SCENARIO_TRACK:
+        /* Another reader has it, Scenario_Open checked that it ends */
+        for(u8Open = 1; u8Open && fgets(acText, sizeof(acText), pTrack->pFile); )
+        {
+          pTrack->u32Line++;
+          Scenario_Parse(pScenario->pcPath, pTrack->u32Line, acText, &sLine);
+          u8Open += (sLine.u8Statement == SCENARIO_REPEAT) - (sLine.u8Statement == SCENARIO_END);
+        }
+        continue;
+
+      case SCENARIO_END:
+        if(pTrack->u8Depth == 0)
+        {
+          pTrack->bDone = TRUE;                   //of the track
+          return;
+        }
+        pRepeat = &pTrack->asRepeat[pTrack->u8Depth - 1];
+        if(pRepeat->dCount == 0)
+        {
+          pTrack->u8Depth--;
+          continue;
+        }
+        if(pRepeat->dCount > 0)
+        {
+          pRepeat->dCount--;
+        }
+        pRepeat->dBase += pRepeat->dEvery;
+        pTrack->u32Line = pRepeat->u32Line;
+        fseek(pTrack->pFile, pRepeat->lOffset, SEEK_SET);
+        continue;
+
+      default:
+        break;
+    }
+
+    /* A time from the start, the repeat or the statement before */
+    dTime = pTrack->u8Depth ? pTrack->asRepeat[pTrack->u8Depth - 1].dBase : 0;
+    if(sLine.bTime)
+    {
+      dTime = (sLine.bRelative ? pTrack->dLast : dTime) + sLine.dTime;
+    }
+    if(sLine.u8Statement == SCENARIO_REPEAT)
+    {
+      pRepeat = &pTrack->asRepeat[pTrack->u8Depth++];
+      pRepeat->lOffset = ftell(pTrack->pFile);
+      pRepeat->u32Line = pTrack->u32Line;
+      pRepeat->dCount = sLine.dValue ? sLine.dValue - 1 : -1;
+      pRepeat->dEvery = sLine.dSpan;
+      pRepeat->dBase = dTime;
+      continue;
+    }
+    if(dTime < pTrack->dLast)
+    {
+      fprintf(stderr, "%s:%lu: at %.3f s, before the statement before it at %.3f s\n", pScenario->pcPath,
+              pTrack->u32Line, dTime, pTrack->dLast);
+      pScenario->bError = TRUE;
+      pTrack->bDone = TRUE;
+      return;
+    }
+    pTrack->dLast = dTime;
+    pTrack->sNext = sLine;
+    pTrack->dNext = dTime;
+    pTrack->bNext = TRUE;
+    return;
+  }
+
+} /* end Scenario_Read */
+
+/*------------------------------------------------------------------------------
+Function: Scenario_Ramp
+
+Description: A ramp's value at a time
+
+Promises: Returns it
+*/
+double Scenario_Ramp(const ScenarioRamp* pRamp, double dTime)
+{
+  if(dTime >= pRamp->dEnd)
+  {
+    return pRamp->dTo;
+  }
+  return pRamp->dFrom + (pRamp->dTo - pRamp->dFrom) * (dTime - pRamp->dStart) / (pRamp->dEnd - pRamp->dStart);
+
+} /* end Scenario_Ramp */
+
+/*------------------------------------------------------------------------------
+Function: Scenario_Ppm
+
+Description: The crystal's error at a time, from its ppm at 25C and its temperature
+
+Promises: Returns it in ppm, positive is fast
+*/
+double Scenario_Ppm(const Scenario* pScenario, double dTime)
+{
+  double dOff_Turnover = Scenario_Ramp(&pScenario->sTemp, dTime) - CRYSTAL_TURNOVER_C;
+
+  return Scenario_Ramp(&pScenario->sPpm, dTime) + CRYSTAL_PARABOLA * dOff_Turnover * dOff_Turnover;
+
+} /* end Scenario_Ppm */
+
+/*------------------------------------------------------------------------------
+Function: Scenario_Crystal
+
+Description: Integrates the ACLK counts up to a real time.  Between the ends of the ramps the ppm
+is at most quadratic in time, which Simpson's rule integrates exactly.
+
+Requires: dTime is not before dCrystal_Time
+Promises: dCounts is the counts at dTime, and dCrystal_Time is dTime
+*/
+void Scenario_Crystal(Scenario* pScenario, double dTime)
+{
+  double dFrom;
+  double dTo;
+
+  while(pScenario->dCrystal_Time < dTime)
+  {
+    dFrom = pScenario->dCrystal_Time;
+    dTo = dTime;
+    if(pScenario->sPpm.dEnd > dFrom && pScenario->sPpm.dEnd < dTo)
+    {
+      dTo = pScenario->sPpm.dEnd;
+    }
+    if(pScenario->sTemp.dEnd > dFrom && pScenario->sTemp.dEnd < dTo)
+    {
+      dTo = pScenario->sTemp.dEnd;
+    }
+    pScenario->dCounts += TRACE_ACLK_HZ * ((dTo - dFrom) + 1e-6 * (dTo - dFrom) / 6 *
+                          (Scenario_Ppm(pScenario, dFrom) + 4 * Scenario_Ppm(pScenario, (dFrom + dTo) / 2) +
+                           Scenario_Ppm(pScenario, dTo)));
+    pScenario->dCrystal_Time = dTo;
+  }
+
+} /* end Scenario_Crystal */
+
+/*------------------------------------------------------------------------------
+Function: Scenario_Counts
+
+Description: The ACLK count the clock is at, at a real time
+
+Requires: dTime is not before the time of the last call
+Promises: Returns it, to the nearest count
+*/
+u64 Scenario_Counts(Scenario* pScenario, double dTime)
+{
+  Scenario_Crystal(pScenario, dTime);
+  return (u64)(pScenario->dCounts + 0.5);
+
+} /* end Scenario_Counts */
+
+/*------------------------------------------------------------------------------
+Function: Scenario_Pin
+
+Description: Pulls a button's pin or LOST_POWER_IND low, or lets it go high
+
+Promises: u8P2IN or u8P3IN has it
+*/
+void Scenario_Pin(Scenario* pScenario, u8 u8Held, bool bLow)
+{
+  u8* pu8Port = LG_abScenario_P2[u8Held] ? &pScenario->u8P2IN : &pScenario->u8P3IN;
+
+  *pu8Port = bLow ? *pu8Port & ~LG_au8Scenario_Pin[u8Held] : *pu8Port | LG_au8Scenario_Pin[u8Held];
+
+} /* end Scenario_Pin */
+
+/*------------------------------------------------------------------------------
+Function: Scenario_Input
+
+Description: fnSim_Input_type for the scenario Scenario_Open opened.  Takes the statements and
+releases in time order up to the next one that moves a pin, and everything else that lands on the
+same ACLK count.
+
+Promises: Returns the pins and the count they change at, FALSE when the scenario has no more
+*/
+bool Scenario_Input(SimInput* pInput)
+{
+  Scenario* pScenario = LG_pScenario;
+  ScenarioTrack* pTrack;
+  ScenarioLine* pLine;
+  ScenarioRamp* pRamp;
+  bool bChanged = FALSE;
+  bool bWas_Changed;
+  double dTime;
+  u8 u8Which;
+  u64 u64Time = 0;
+
+  if(!pScenario)
+  {
+    return FALSE;
+  }
+  while(!pScenario->bError)
+  {
+    /* A release comes before a statement at the same time, and the tracks in the order of the file */
+    dTime = SCENARIO_NEVER;
+    u8Which = SCENARIO_HELD;
+    for(u8 i = 0; i < SCENARIO_HELD; i++)
+    {
+      if(pScenario->adRelease[i] < dTime)
+      {
+        dTime = pScenario->adRelease[i];
+        u8Which = i;
+      }
+    }
+    for(u8 i = 0; i < pScenario->u8Tracks; i++)
+    {
+      if(pScenario->asTrack[i].bNext && pScenario->asTrack[i].dNext < dTime)
+      {
+        dTime = pScenario->asTrack[i].dNext;
+        u8Which = SCENARIO_HELD + i;
+      }
+    }
+    if(dTime >= SCENARIO_NEVER || (bChanged && Scenario_Counts(pScenario, dTime) != u64Time))
+    {
+      break;
+    }
+
+    bWas_Changed = bChanged;
+    if(u8Which < SCENARIO_HELD)
+    {
+      Scenario_Pin(pScenario, u8Which, FALSE);
+      pScenario->adRelease[u8Which] = SCENARIO_NEVER;
+      bChanged = TRUE;
+    }
+    else
+    {
+      pTrack = &pScenario->asTrack[u8Which - SCENARIO_HELD];
+      pLine = &pTrack->sNext;
+      switch(pLine->u8Statement)
+      {
+        case SCENARIO_PRESS:
+          Scenario_Pin(pScenario, pLine->u8Button, TRUE);
+          pScenario->adRelease[pLine->u8Button] = dTime + (pLine->dSpan > 0 ? pLine->dSpan : SCENARIO_PRESS_DEFAULT);
+          bChanged = TRUE;
+          break;
+
+        case SCENARIO_POWER_OFF:
+        case SCENARIO_POWER_ON:
+          Scenario_Pin(pScenario, SCENARIO_POWER, pLine->u8Statement == SCENARIO_POWER_OFF);
+          pScenario->adRelease[SCENARIO_POWER] = (pLine->u8Statement == SCENARIO_POWER_OFF && pLine->dSpan > 0) ?
+                                                 dTime + pLine->dSpan : SCENARIO_NEVER;
+          bChanged = TRUE;
+          break;
+
+        default:
+          /* The crystal changes from here, the counts up to here are at the old one */
+          Scenario_Crystal(pScenario, dTime);
+          pRamp = pLine->u8Statement == SCENARIO_PPM ? &pScenario->sPpm : &pScenario->sTemp;
+          pRamp->dFrom = Scenario_Ramp(pRamp, dTime);
+          pRamp->dTo = pLine->dValue;
+          pRamp->dStart = dTime;
+          pRamp->dEnd = dTime + pLine->dSpan;
+          break;
+      }
+      Scenario_Read(pScenario, pTrack);
+    }
+    if(bChanged && !bWas_Changed)
+    {
+      u64Time = Scenario_Counts(pScenario, dTime);
+    }
+  }
+  if(!bChanged || pScenario->bError)
+  {
+    return FALSE;
+  }
+  pInput->u64Time = u64Time;
+  pInput->u8P2IN = pScenario->u8P2IN;
+  pInput->u8P3IN = pScenario->u8P3IN;
+  return TRUE;
+
+} /* end Scenario_Input */
+
+/*------------------------------------------------------------------------------
+Function: Scenario_Open
+
+Description: Opens a scenario for Scenario_Input, checking all of its lines first
+
+Promises: Returns TRUE if it is a scenario, with messages on stderr if not
+*/
+bool Scenario_Open(Scenario* pScenario, const char* pcPath)
+{
+  char acText[SCENARIO_LINE_SIZE];
+  ScenarioLine sLine;
+  ScenarioTrack* pTrack = &pScenario->asTrack[0];
+  u32 au32Opened[SCENARIO_DEPTH + 1];
+  u32 au32Timed[SCENARIO_DEPTH + 1];
+  long alStart[SCENARIO_TRACKS];
+  u32 u32Timed = 0;
+  u8 u8Depth = 0;
+  bool bIn_Track = FALSE;
+
+  memset(pScenario, 0, sizeof(*pScenario));
+  pScenario->pcPath = pcPath;
+  if(!(pTrack->pFile = fopen(pcPath, "r")))
+  {
+    perror(pcPath);
+    return FALSE;
+  }
+  pScenario->u8Tracks = 1;
+
+  /* Every line, that the repeats, tracks and ends match and that each repeat has something timed */
+  while(!pScenario->bError && fgets(acText, sizeof(acText), pTrack->pFile))
+  {
+    pTrack->u32Line++;
+    if(!strchr(acText, '\n') && !feof(pTrack->pFile))
+    {
+      fprintf(stderr, "%s:%lu: longer than %d characters\n", pcPath, pTrack->u32Line, SCENARIO_LINE_SIZE - 2);
+      pScenario->bError = TRUE;
+    }
+    else if(!Scenario_Parse(pcPath, pTrack->u32Line, acText, &sLine))
+    {
+      pScenario->bError = TRUE;
+    }
+    else if(sLine.u8Statement == SCENARIO_TRACK && (u8Depth || pScenario->u8Tracks == SCENARIO_TRACKS))
+    {
+      fprintf(stderr, "%s:%lu: a track inside a repeat or a track, or more than %d tracks\n", pcPath,
+              pTrack->u32Line, SCENARIO_TRACKS - 1);
+      pScenario->bError = TRUE;
+    }
+    else if(sLine.u8Statement == SCENARIO_REPEAT && u8Depth == SCENARIO_DEPTH + bIn_Track)
+    {
+      fprintf(stderr, "%s:%lu: more than %d repeats inside each other\n", pcPath, pTrack->u32Line, SCENARIO_DEPTH);
+      pScenario->bError = TRUE;
+    }
+    else if(sLine.u8Statement == SCENARIO_REPEAT || sLine.u8Statement == SCENARIO_TRACK)
+    {
+      if(sLine.u8Statement == SCENARIO_TRACK)
+      {
+        bIn_Track = TRUE;
+        pScenario->asTrack[pScenario->u8Tracks].u32Line = pTrack->u32Line;
+        alStart[pScenario->u8Tracks++] = ftell(pTrack->pFile);
+      }
+      au32Opened[u8Depth] = pTrack->u32Line;
+      au32Timed[u8Depth++] = u32Timed;
+    }
+    else if(sLine.u8Statement == SCENARIO_END && u8Depth == 0)
+    {
+      fprintf(stderr, "%s:%lu: end without a repeat or a track\n", pcPath, pTrack->u32Line);
+      pScenario->bError = TRUE;
+    }
+    else if(sLine.u8Statement == SCENARIO_END)
+    {
+      if(--u8Depth == 0 && bIn_Track)
+      {
+        bIn_Track = FALSE;
+      }
+      else if(au32Timed[u8Depth] == u32Timed)
+      {
+        fprintf(stderr, "%s:%lu: nothing to repeat\n", pcPath, au32Opened[u8Depth]);
+        pScenario->bError = TRUE;
+      }
+    }
+    else if(sLine.u8Statement != SCENARIO_NONE)
+    {
+      u32Timed++;
+    }
+  }
+  if(!pScenario->bError && u8Depth)
+  {
+    fprintf(stderr, "%s:%lu: repeat or track without an end\n", pcPath, au32Opened[u8Depth - 1]);
+    pScenario->bError = TRUE;
+  }
+
+  /* A FILE for each track, from the line after its "track" */
+  for(u8 i = 1; i < pScenario->u8Tracks && !pScenario->bError; i++)
+  {
+    pScenario->asTrack[i].pFile = fopen(pcPath, "r");
+    if(!pScenario->asTrack[i].pFile || fseek(pScenario->asTrack[i].pFile, alStart[i], SEEK_SET))
+    {
+      perror(pcPath);
+      pScenario->bError = TRUE;
+    }
+  }
+  if(pScenario->bError)
+  {
+    Scenario_Close(pScenario);
+    return FALSE;
+  }
+
+  rewind(pTrack->pFile);
+  pTrack->u32Line = 0;
+  pScenario->u8P2IN = SIM_PINS_IDLE_P2;
+  pScenario->u8P3IN = SIM_PINS_IDLE_P3;
+  for(u8 i = 0; i < SCENARIO_HELD; i++)
+  {
+    pScenario->adRelease[i] = SCENARIO_NEVER;
+  }
+  pScenario->sTemp.dFrom = CRYSTAL_TURNOVER_C;
+  pScenario->sTemp.dTo = CRYSTAL_TURNOVER_C;
+  for(u8 i = 0; i < pScenario->u8Tracks; i++)
+  {
+    Scenario_Read(pScenario, &pScenario->asTrack[i]);
+  }
+  LG_pScenario = pScenario;
+  return !pScenario->bError;
+
+} /* end Scenario_Open */
+
+/*------------------------------------------------------------------------------
+Function: Scenario_Close
+
+Description: Closes a scenario
+
+Promises: Scenario_Input has no more from it.  bError is still set if a statement out of time
+order stopped the scenario early.
+*/
+void Scenario_Close(Scenario* pScenario)
+{
+  for(u8 i = 0; i < pScenario->u8Tracks; i++)
+  {
+    if(pScenario->asTrack[i].pFile)
+    {
+      fclose(pScenario->asTrack[i].pFile);
+      pScenario->asTrack[i].pFile = NULL;
+    }
+  }
+  if(LG_pScenario == pScenario)
+  {
+    LG_pScenario = NULL;
+  }
+
+} /* end Scenario_Close */
@@ -0,0 +1,139 @@
+/**********************************************************************
+* Header file for simulator scenarios
+
+A scenario is a text file of what happens to a clock over time: the owner pressing and holding
+its buttons, the power going and coming back, and the crystal's error.  The timed simulator reads
+it through Scenario_Input, a line at a time as the run gets to it, so a scenario of years is read
+with no more memory than a line, the repeats it is inside and a file position for each track.
+
+One statement a line, # to the end of the line is a comment:
+  at TIME press BUTTON [for SPAN]     button 0, 1 or 2 down, for 0.2s unless SPAN is given
+  at TIME power off [for SPAN]        LOST_POWER_IND low, until "power on" or for SPAN
+  at TIME power on
+  at TIME ppm PPM [over SPAN]         the crystal's error at 25C from then on, or ramped to it over SPAN
+  at TIME temp CELSIUS [over SPAN]    the crystal's temperature, the same
+  [at TIME] repeat COUNT|forever every SPAN
+  end                                 of the statements repeated
+  track                               statements that run alongside the rest, to their end
+A SPAN is numbers with a unit, ms s m h or d, and hh:mm[:ss], added together: 2s, 1d3h, 1d 03:00.
+A TIME is a SPAN from the start of the scenario, or of the repeat it is in, or with a + the SPAN
+from the statement before.  A repeat starts at its TIME, or at the start of the repeat it is in.
+The statements of a track, and the ones outside all the tracks, must be in time order; the tracks
+are merged, so a weekly power cut and a monthly setting of the clock can each be a repeat of their
+own.  Tracks are not inside repeats or other tracks.
+
+The times are real time.  The clock counts its ACLK, which runs fast or slow by the crystal's ppm,
+its error at 25C plus CRYSTAL_PARABOLA ppm / C^2 off 25C, so with a ppm or temp statement the events
+land at ACLK counts that are not their real time * 32768.  Ramps are linear in ppm and in temperature
+and are integrated exactly.
+
+Build:   part of libfirmware.a, see the Makefile
+Use:     clock_sim -s scenarios/year.scenario -d 365
+**********************************************************************/
+
+/************************ Revision History ****************************
+YYYY-MM-DD  Comments
+-------------------------------------------------------------------------------------------
+2026-10-19  File created
+
+************************************************************************/
+
+#ifndef __SCENARIO_HEADER
+#define __SCENARIO_HEADER
+
+#include <stdio.h>
+#include "sim.h"
+
+/****************************************************************************************
+Constants
+****************************************************************************************/
+
+#define SCENARIO_LINE_SIZE     256
+#define SCENARIO_DEPTH         8         /* repeats inside repeats */
+#define SCENARIO_TRACKS        8         /* the statements outside the tracks, then the tracks */
+#define SCENARIO_PRESS_DEFAULT 0.2       /* s, a press without "for" */
+#define SCENARIO_HELD          4         /* the three buttons then the power, see Scenario.adRelease */
+#define SCENARIO_POWER         3
+#define SCENARIO_NEVER         1e300
+
+#define CRYSTAL_TURNOVER_C     25.0
+#define CRYSTAL_PARABOLA       (-0.034)  /* ppm / C^2, a 32768 Hz tuning fork crystal */
+
+/******************************************************************************
+Type Definitions
+******************************************************************************/
+
+typedef enum {SCENARIO_NONE, SCENARIO_PRESS, SCENARIO_POWER_OFF, SCENARIO_POWER_ON, SCENARIO_PPM,
+              SCENARIO_TEMP, SCENARIO_REPEAT, SCENARIO_TRACK, SCENARIO_END} ScenarioStatement;
+
+/* A line of the scenario */
+typedef struct
+{
+  u8 u8Statement;                        //ScenarioStatement
+  bool bTime;                            //there was an "at"
+  bool bRelative;                        //the TIME had a +
+  u8 u8Button;
+  double dTime;                          //s
+  double dValue;                         //ppm, C or the repeat COUNT, 0 for forever
+  double dSpan;                          //s of for, over or every, 0 for none
+} ScenarioLine;
+
+/* A repeat being run */
+typedef struct
+{
+  long lOffset;                          //in the file, of the line after the repeat
+  u32 u32Line;
+  double dCount;                         //repetitions left after this one, -1 for forever
+  double dEvery;
+  double dBase;                          //the start of the repetition
+} ScenarioRepeat;
+
+/* A linear ramp of the crystal's ppm at 25C or its temperature, constant after dEnd */
+typedef struct
+{
+  double dStart;
+  double dEnd;
+  double dFrom;
+  double dTo;
+} ScenarioRamp;
+
+/* A reader of the file, for a track or the statements outside the tracks */
+typedef struct
+{
+  FILE* pFile;
+  u32 u32Line;
+  bool bDone;
+  bool bNext;                            //sNext is the statement read ahead, at real time dNext
+  ScenarioLine sNext;
+  double dNext;
+  double dLast;                          //time of the statement before it
+  ScenarioRepeat asRepeat[SCENARIO_DEPTH];
+  u8 u8Depth;
+} ScenarioTrack;
+
+typedef struct
+{
+  const char* pcPath;
+  bool bError;
+  ScenarioTrack asTrack[SCENARIO_TRACKS];
+  u8 u8Tracks;
+
+  /* The pins and when the ones held come back up, SCENARIO_NEVER if they are not held */
+  u8 u8P2IN;
+  u8 u8P3IN;
+  double adRelease[SCENARIO_HELD];
+
+  /* The crystal, ACLK counts are integrated up to dCrystal_Time */
+  ScenarioRamp sPpm;
+  ScenarioRamp sTemp;
+  double dCrystal_Time;
+  double dCounts;
+} Scenario;
+
+/************************ Function Declarations ****************************/
+
+bool Scenario_Open(Scenario* pScenario, const char* pcPath);
+bool Scenario_Input(SimInput* pInput);
+void Scenario_Close(Scenario* pScenario);
+
+#endif /* __SCENARIO_HEADER */
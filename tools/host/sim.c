@@ -0,0 +1,553 @@
+/**********************************************************************
+* The timed simulator, see sim.h
+
+Timer A runs in up mode to TACCR0 and Timer1_A in continuous mode, both from ACLK, the same as the
+firmware sets them.  Their counts are not stepped: the time of the next wrap or compare match is
+worked out from the time the timer was last cleared, so a wait costs nothing however long it is.
+TAR and TA1R are written for the firmware to read at every function entry.
+
+Interrupt flags are kept here, not in the registers, and are taken in the F2122's priority order:
+Timer1_A0, Timer1_A1, Timer0_A1 (TACCR1, TACCR2, TAIFG as TAIV orders them), Port 2.
+**********************************************************************/
+
+/************************ Revision History ****************************
+YYYY-MM-DD  Comments
+-------------------------------------------------------------------------------------------
+2026-10-19  File created
+
+************************************************************************/
+
+#include <string.h>
+#include "sim.h"
+#include "bnclk-efwd-01.h"
+#include "main.h"
+
+/******************** External Globals ************************/
+extern int GG_u8Second_Counter;                /* From bnclk-efwd-01.c */
+
+/******************** Program Globals ************************/
+u64 GG_u64Sim_Time = 0;                           //ACLK counts since the reset
+TraceWriter* GG_pSim_Trace = NULL;                //the run is traced when this is set
+SimStatistics GG_sSim;
+
+/******************** Local Globals ************************/
+u64 LG_u64Sim_TA_Start;                           //when TAR was last 0
+u64 LG_u64Sim_TA1_Start;                          //when TA1R was last cleared
+u64 LG_u64Sim_Latched;                            //the flags of everything up to this time are set
+u8 LG_u8Sim_Pending;                              //timer interrupt flags, a bit per TraceSource
+fnSim_Input_type LG_pfSim_Input;
+SimInput LG_sSim_Input;                           //the next change of the inputs
+bool LG_bSim_Input;                               //there is one
+u8 LG_au8Sim_Port[TRACE_PORTS];                   //the pins as last traced
+
+/* What Sim_Next found */
+#define SIM_NEXT_WRAP          TRACE_SOURCES
+#define SIM_NEXT_INPUT         (TRACE_SOURCES + 1)
+#define SIM_NEXT_NONE          (TRACE_SOURCES + 2)
+#define SIM_NEVER              (~0ULL)
+
+/******************** Function Definitions ************************/
+
+/*------------------------------------------------------------------------------
+Function: Sim_State
+
+Description: The pins and the CPU now, as a trace records them
+
+Promises: pState is filled in
+*/
+void Sim_State(TraceState* pState)
+{
+  memset(pState, 0, sizeof(*pState));
+  pState->au8Port[TRACE_P1OUT] = P1OUT;
+  pState->au8Port[TRACE_P2OUT] = P2OUT;
+  pState->au8Port[TRACE_P3OUT] = P3OUT;
+  pState->au8Port[TRACE_P2IN] = P2IN;
+  pState->au8Port[TRACE_P3IN] = P3IN;
+  pState->u8Awake = Host_Asleep() ? 0 : 1;
+
+} /* end Sim_State */
+
+/*------------------------------------------------------------------------------
+Function: Sim_Ports
+
+Description: Traces the output ports that have changed since they were last traced
+
+Promises: A record for each, at the time now
+*/
+void Sim_Ports(void)
+{
+  u8 au8Now[3] = {P1OUT, P2OUT, P3OUT};
+
+  for(u8 i = 0; i < 3; i++)
+  {
+    if(au8Now[i] != LG_au8Sim_Port[i])
+    {
+      LG_au8Sim_Port[i] = au8Now[i];
+      Trace_Write(GG_pSim_Trace, GG_u64Sim_Time, TRACE_P1OUT + i, au8Now[i]);
+    }
+  }
+
+} /* end Sim_Ports */
+
+/*------------------------------------------------------------------------------
+Function: Sim_Cleared
+
+Description: The firmware has written the timer control registers with TACLR, which the hardware
+acts on and then drops.  Called before the time moves on, so the clear is at the time it was written.
+
+Promises: The timers cleared are restarted from now and TACLR is off again
+*/
+void Sim_Cleared(void)
+{
+  if(TACTL & TACLR)
+  {
+    TACTL &= ~TACLR;
+    LG_u64Sim_TA_Start = GG_u64Sim_Time;
+  }
+  if(TA1CTL & TACLR)
+  {
+    TA1CTL &= ~TACLR;
+    LG_u64Sim_TA1_Start = GG_u64Sim_Time;
+  }
+
+} /* end Sim_Cleared */
+
+/*------------------------------------------------------------------------------
+Function: Sim_Next
+
+Description: The first thing after LG_u64Sim_Latched that sets a flag or moves a pin: a wrap of
+Timer A, a compare match of either timer or a change of the inputs
+
+Promises: Returns its time, SIM_NEVER if there is nothing, and what it is in pu8What
+*/
+u64 Sim_Next(u8* pu8What)
+{
+  u64 u64Best = SIM_NEVER;
+  u64 u64Time;
+  u64 u64Latched = LG_u64Sim_Latched;
+
+  *pu8What = SIM_NEXT_NONE;
+  if(TACTL & MC_3)
+  {
+    u16 u16Top = ((TACTL & MC_3) == MC_1) ? TACCR0 : 0xFFFF;
+    u64 u64Count = u64Latched - LG_u64Sim_TA_Start;
+    u16 au16Compare[2] = {TACCR1, TACCR2};
+    u16 au16Control[2] = {TACCTL1, TACCTL2};
+
+    /* Up mode rolls to zero straight away if TACCR0 is moved below the count */
+    u64Best = (u64Count > u16Top) ? u64Latched + 1 : LG_u64Sim_TA_Start + u16Top + 1;
+    *pu8What = SIM_NEXT_WRAP;
+    for(u8 i = 0; i < 2; i++)
+    {
+      u64Time = LG_u64Sim_TA_Start + au16Compare[i];
+      if((au16Control[i] & CCIE) && au16Compare[i] <= u16Top && u64Time > u64Latched && u64Time < u64Best)
+      {
+        u64Best = u64Time;
+        *pu8What = TRACE_SOURCE_SUBTICK + i;
+      }
+    }
+  }
+  if(TA1CTL & MC_3)
+  {
+    u16 u16Count = (u16)(u64Latched - LG_u64Sim_TA1_Start);
+    u16 au16Compare[2] = {TA1CCR0, TA1CCR1};
+    u16 au16Control[2] = {TA1CCTL0, TA1CCTL1};
+
+    for(u8 i = 0; i < 2; i++)
+    {
+      u64Time = u64Latched + (u16)(au16Compare[i] - u16Count - 1) + 1;
+      if((au16Control[i] & CCIE) && u64Time < u64Best)
+      {
+        u64Best = u64Time;
+        *pu8What = TRACE_SOURCE_REPEAT + i;
+      }
+    }
+  }
+  if(LG_bSim_Input)
+  {
+    u64Time = LG_sSim_Input.u64Time > u64Latched ? LG_sSim_Input.u64Time : u64Latched + 1;
+    if(u64Time < u64Best)
+    {
+      u64Best = u64Time;
+      *pu8What = SIM_NEXT_INPUT;
+    }
+  }
+  return u64Best;
+
+} /* end Sim_Next */
+
+/*------------------------------------------------------------------------------
+Function: Sim_Inputs
+
+Description: Drives the input pins, a port 2 edge that P2IES selects sets its P2IFG bit
+
+Promises: P2IN and P3IN have the new levels, the next change is fetched
+*/
+void Sim_Inputs(const SimInput* pInput)
+{
+  u8 u8P2IN = (P2IN & ~SIM_P2_INPUTS) | (pInput->u8P2IN & SIM_P2_INPUTS);
+  u8 u8P3IN = (P3IN & ~SIM_P3_INPUTS) | (pInput->u8P3IN & SIM_P3_INPUTS);
+  u8 u8Falling = P2IN & ~u8P2IN;
+  u8 u8Rising = ~P2IN & u8P2IN;
+
+  P2IFG |= (u8Falling & P2IES) | (u8Rising & ~P2IES);
+  if(GG_pSim_Trace && u8P2IN != P2IN)
+  {
+    Trace_Write(GG_pSim_Trace, GG_u64Sim_Time, TRACE_P2IN, u8P2IN);
+  }
+  if(GG_pSim_Trace && u8P3IN != P3IN)
+  {
+    Trace_Write(GG_pSim_Trace, GG_u64Sim_Time, TRACE_P3IN, u8P3IN);
+  }
+  P2IN = u8P2IN;
+  P3IN = u8P3IN;
+  LG_bSim_Input = LG_pfSim_Input ? LG_pfSim_Input(&LG_sSim_Input) : FALSE;
+
+} /* end Sim_Inputs */
+
+/*------------------------------------------------------------------------------
+Function: Sim_Latch
+
+Description: Sets the flags of everything that has happened up to now and writes TAR and TA1R
+
+Promises: LG_u64Sim_Latched is now
+*/
+void Sim_Latch(void)
+{
+  u8 u8What;
+  u64 u64Time;
+
+  while((u64Time = Sim_Next(&u8What)) <= GG_u64Sim_Time)
+  {
+    LG_u64Sim_Latched = u64Time;
+    switch(u8What)
+    {
+      case SIM_NEXT_WRAP:
+        LG_u64Sim_TA_Start = u64Time;
+        if(TACTL & TAIE)
+        {
+          LG_u8Sim_Pending |= 1 << TRACE_SOURCE_TICK;
+        }
+        /* Compare matches at a count of 0 are at the wrap, Sim_Next only finds them after it */
+        if((TACCTL1 & CCIE) && TACCR1 == 0)
+        {
+          LG_u8Sim_Pending |= 1 << TRACE_SOURCE_SUBTICK;
+        }
+        if((TACCTL2 & CCIE) && TACCR2 == 0)
+        {
+          LG_u8Sim_Pending |= 1 << TRACE_SOURCE_MELODY;
+        }
+        break;
+
+      case SIM_NEXT_INPUT:
+      {
+        /* An input given for a time already past is at the time now */
+        u64 u64Now = GG_u64Sim_Time;
+        SimInput sInput = LG_sSim_Input;
+
+        GG_u64Sim_Time = u64Time;
+        Sim_Inputs(&sInput);
+        GG_u64Sim_Time = u64Now;
+        break;
+      }
+
+      default:
+        LG_u8Sim_Pending |= 1 << u8What;
+        break;
+    }
+  }
+  LG_u64Sim_Latched = GG_u64Sim_Time;
+  TAR = (u16)(GG_u64Sim_Time - LG_u64Sim_TA_Start);
+  TA1R = (u16)(GG_u64Sim_Time - LG_u64Sim_TA1_Start);
+
+} /* end Sim_Latch */
+
+/*------------------------------------------------------------------------------
+Function: Sim_Interrupt
+
+Description: Runs the ISR for a source the way the CPU takes it, with its cycles
+
+Promises: The ISR has run, a wake of the main loop is traced
+*/
+void Sim_Interrupt(u8 u8Source)
+{
+  bool bAsleep = Host_Asleep();
+
+  if(GG_pSim_Trace)
+  {
+    if(u8Source == TRACE_SOURCE_TICK && GG_u8Second_Counter + 1 == SIM_MINUTE_TICKS)
+    {
+      Trace_Write(GG_pSim_Trace, GG_u64Sim_Time, TRACE_MINUTE, 0);
+    }
+    Trace_Write(GG_pSim_Trace, GG_u64Sim_Time, TRACE_ISR, u8Source);
+  }
+  GG_sSim.u64Interrupts++;
+  GG_u64Sim_Time += SIM_ISR_ENTRY_CYCLES;
+  switch(u8Source)
+  {
+    case TRACE_SOURCE_TICK:
+    case TRACE_SOURCE_SUBTICK:
+    case TRACE_SOURCE_MELODY:
+      TAIV = (u8Source == TRACE_SOURCE_TICK) ? TAIV_TAIFG : (u8Source == TRACE_SOURCE_SUBTICK) ? TAIV_TACCR1 : TAIV_TACCR2;
+      Host_Interrupt(TimerAISR);
+      TAIV = 0;
+      break;
+
+    case TRACE_SOURCE_REPEAT:
+      Host_Interrupt(Timer1AISR);
+      break;
+
+    case TRACE_SOURCE_RELEASE:
+      TA1IV = TAIV_TACCR1;
+      Host_Interrupt(Timer1A1ISR);
+      TA1IV = 0;
+      break;
+
+    default:
+      Host_Interrupt(Port2ISR);
+      break;
+  }
+  Sim_Cleared();
+  GG_u64Sim_Time += SIM_RETI_CYCLES;
+  Sim_Latch();
+  if(GG_pSim_Trace)
+  {
+    Sim_Ports();
+    if(bAsleep && !Host_Asleep())
+    {
+      Trace_Write(GG_pSim_Trace, GG_u64Sim_Time, TRACE_WAKE, 0);
+    }
+  }
+
+} /* end Sim_Interrupt */
+
+/*------------------------------------------------------------------------------
+Function: Sim_Enabled
+
+Description: Whether the firmware has a source's interrupt enabled, a flag set while it was
+enabled is dropped when it is disabled since the firmware clears the flag with the enable
+
+Promises: Returns TRUE if it is enabled
+*/
+bool Sim_Enabled(u8 u8Source)
+{
+  switch(u8Source)
+  {
+    case TRACE_SOURCE_TICK:    return (TACTL & TAIE) ? TRUE : FALSE;
+    case TRACE_SOURCE_SUBTICK: return (TACCTL1 & CCIE) ? TRUE : FALSE;
+    case TRACE_SOURCE_MELODY:  return (TACCTL2 & CCIE) ? TRUE : FALSE;
+    case TRACE_SOURCE_REPEAT:  return (TA1CCTL0 & CCIE) ? TRUE : FALSE;
+    case TRACE_SOURCE_RELEASE: return (TA1CCTL1 & CCIE) ? TRUE : FALSE;
+    default:                   return (P2IFG & P2IE) ? TRUE : FALSE;
+  }
+
+} /* end Sim_Enabled */
+
+/*------------------------------------------------------------------------------
+Function: Sim_Deliver
+
+Description: Takes the interrupts that are due, highest priority first, while GIE is set
+
+Promises: No interrupt that is enabled is left pending unless GIE is clear
+*/
+void Sim_Deliver(void)
+{
+  const u8 au8Priority[TRACE_SOURCES] = {TRACE_SOURCE_REPEAT, TRACE_SOURCE_RELEASE, TRACE_SOURCE_SUBTICK,
+                                         TRACE_SOURCE_MELODY, TRACE_SOURCE_TICK, TRACE_SOURCE_PORT2};
+  u8 u8Source;
+
+  while(GG_u16Host_SR & GIE)
+  {
+    Sim_Latch();
+    if(P2IFG & P2IE)
+    {
+      LG_u8Sim_Pending |= 1 << TRACE_SOURCE_PORT2;
+    }
+    u8Source = TRACE_SOURCES;
+    for(u8 i = 0; i < TRACE_SOURCES && u8Source == TRACE_SOURCES; i++)
+    {
+      if(LG_u8Sim_Pending & (1 << au8Priority[i]))
+      {
+        LG_u8Sim_Pending &= ~(1 << au8Priority[i]);
+        if(Sim_Enabled(au8Priority[i]))
+        {
+          u8Source = au8Priority[i];
+        }
+      }
+    }
+    if(u8Source == TRACE_SOURCES)
+    {
+      return;
+    }
+    Sim_Interrupt(u8Source);
+  }
+
+} /* end Sim_Deliver */
+
+/*------------------------------------------------------------------------------
+Function: Sim_Point
+
+Description: GG_pfHost_Point.  Charges the function entered, and takes the interrupts that
+have come due if the main loop is running with GIE set
+
+Promises: The time has moved on by SIM_CALL_CYCLES, except for going to sleep
+*/
+void Sim_Point(void* pvFunction)
+{
+  Sim_Cleared();
+  if(pvFunction != (void*)Host_Sleep)
+  {
+    GG_u64Sim_Time += SIM_CALL_CYCLES;
+    GG_sSim.u64Calls++;
+  }
+  Sim_Latch();
+  if(GG_pSim_Trace)
+  {
+    Sim_Ports();
+  }
+  if(!GG_u8Host_ISR_Depth && !Host_Asleep())
+  {
+    Sim_Deliver();
+  }
+
+} /* end Sim_Point */
+
+/*------------------------------------------------------------------------------
+Function: Sim_Reset
+
+Description: A power on reset at time 0, with the inputs to come from pfInput (NULL for none)
+
+Promises: The firmware is reset and awake, the idle pins are applied and then any input for time 0
+*/
+void Sim_Reset(fnSim_Input_type pfInput)
+{
+  SimInput sIdle = {0, SIM_PINS_IDLE_P2, SIM_PINS_IDLE_P3};
+
+  GG_pfHost_Point = NULL;
+  Host_Reset();
+  GG_u64Sim_Time = 0;
+  LG_u64Sim_TA_Start = 0;
+  LG_u64Sim_TA1_Start = 0;
+  LG_u64Sim_Latched = 0;
+  LG_u8Sim_Pending = 0;
+  memset(&GG_sSim, 0, sizeof(GG_sSim));
+  LG_pfSim_Input = pfInput;
+  Sim_Inputs(&sIdle);
+  P2IFG = 0;
+  while(LG_bSim_Input && LG_sSim_Input.u64Time == 0)
+  {
+    SimInput sInput = LG_sSim_Input;
+
+    Sim_Inputs(&sInput);
+    P2IFG = 0;
+  }
+  Sim_Cleared();
+  LG_au8Sim_Port[0] = P1OUT;
+  LG_au8Sim_Port[1] = P2OUT;
+  LG_au8Sim_Port[2] = P3OUT;
+  GG_pfHost_Point = Sim_Point;
+
+} /* end Sim_Reset */
+
+/*------------------------------------------------------------------------------
+Function: Sim_Save
+
+Description: Saves the run, the firmware with Host_Save and the timers, flags and input here.
+The pins as last traced are not saved, they are only kept while there is a trace.
+
+Requires: The main loop is asleep, between two calls of Sim_Run
+Promises: pSnapshot has it, with the bytes that are not used zero so snapshots can be compared
+*/
+void Sim_Save(SimSnapshot* pSnapshot)
+{
+  memset(pSnapshot, 0, sizeof(*pSnapshot));
+  pSnapshot->u64Time = GG_u64Sim_Time;
+  pSnapshot->u64TA_Start = LG_u64Sim_TA_Start;
+  pSnapshot->u64TA1_Start = LG_u64Sim_TA1_Start;
+  pSnapshot->u64Latched = LG_u64Sim_Latched;
+  pSnapshot->sStatistics = GG_sSim;
+  pSnapshot->u64Input_Time = LG_sSim_Input.u64Time;
+  pSnapshot->u8Input_P2IN = LG_sSim_Input.u8P2IN;
+  pSnapshot->u8Input_P3IN = LG_sSim_Input.u8P3IN;
+  pSnapshot->bInput = LG_bSim_Input;
+  pSnapshot->u8Pending = LG_u8Sim_Pending;
+  Host_Save(&pSnapshot->sHost);
+
+} /* end Sim_Save */
+
+/*------------------------------------------------------------------------------
+Function: Sim_Restore
+
+Description: Puts back a run from Sim_Save, in this process or another of the same executable.
+The firmware's RAM has function pointers, so the executable is linked without PIE.
+
+Requires: pfInput gives the changes of the inputs after the one the snapshot had fetched
+Promises: Sim_Run carries on the way it did from where the snapshot was taken
+*/
+void Sim_Restore(const SimSnapshot* pSnapshot, fnSim_Input_type pfInput)
+{
+  Host_Restore(&pSnapshot->sHost);
+  GG_u64Sim_Time = pSnapshot->u64Time;
+  LG_u64Sim_TA_Start = pSnapshot->u64TA_Start;
+  LG_u64Sim_TA1_Start = pSnapshot->u64TA1_Start;
+  LG_u64Sim_Latched = pSnapshot->u64Latched;
+  GG_sSim = pSnapshot->sStatistics;
+  LG_sSim_Input.u64Time = pSnapshot->u64Input_Time;
+  LG_sSim_Input.u8P2IN = pSnapshot->u8Input_P2IN;
+  LG_sSim_Input.u8P3IN = pSnapshot->u8Input_P3IN;
+  LG_bSim_Input = pSnapshot->bInput;
+  LG_u8Sim_Pending = pSnapshot->u8Pending;
+  LG_au8Sim_Port[0] = P1OUT;
+  LG_au8Sim_Port[1] = P2OUT;
+  LG_au8Sim_Port[2] = P3OUT;
+  LG_pfSim_Input = pfInput;
+  GG_pfHost_Point = Sim_Point;
+
+} /* end Sim_Restore */
+
+/*------------------------------------------------------------------------------
+Function: Sim_Run
+
+Description: Runs the firmware until a time, sleeping through the time nothing happens.  A wake
+that is still going at u64Until is run to its end.
+
+Promises: The main loop is asleep and GG_u64Sim_Time is u64Until or just after it
+*/
+void Sim_Run(u64 u64Until)
+{
+  u8 u8What;
+  u64 u64Next;
+  u64 u64Woke;
+
+  for(;;)
+  {
+    if(!Host_Asleep())
+    {
+      u64Woke = GG_u64Sim_Time;
+      GG_sSim.u64Wakes++;
+      while(!Host_Run())
+      {
+      }
+      GG_sSim.u64Awake_Cycles += GG_u64Sim_Time - u64Woke;
+      if(GG_pSim_Trace)
+      {
+        Sim_Ports();
+        Trace_Write(GG_pSim_Trace, GG_u64Sim_Time, TRACE_SLEEP, 0);
+      }
+      continue;
+    }
+    u64Next = Sim_Next(&u8What);
+    if(u64Next > u64Until)
+    {
+      break;
+    }
+    GG_u64Sim_Time = u64Next;
+    Sim_Deliver();
+  }
+  if(GG_u64Sim_Time < u64Until)
+  {
+    GG_u64Sim_Time = u64Until;
+    Sim_Latch();
+  }
+
+} /* end Sim_Run */
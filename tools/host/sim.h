@@ -0,0 +1,96 @@
+/**********************************************************************
+* Header file for the timed simulator
+
+Runs the host build of the firmware against a model of Timer A, Timer1_A and the input pins,
+in ACLK counts since the reset.  MCLK is ACLK so a count is also a CPU cycle.
+
+The firmware itself takes no time on the host, so each firmware function entry is charged
+SIM_CALL_CYCLES and each interrupt SIM_ISR_ENTRY_CYCLES + SIM_RETI_CYCLES.  The call cost is an
+estimate of the average function of this firmware with -Os, see tools/wcet.py for the bounds of
+each one; the times the simulator gives for code are that estimate, the times of the timers are exact.
+An interrupt that comes due while the main loop is awake runs at the next function entry with GIE
+set, like the arrival points of model_check.
+
+Build:   part of libfirmware.a, see the Makefile
+**********************************************************************/
+
+/************************ Revision History ****************************
+YYYY-MM-DD  Comments
+-------------------------------------------------------------------------------------------
+2026-10-19  File created
+
+************************************************************************/
+
+#ifndef __SIM_HEADER
+#define __SIM_HEADER
+
+#include "host.h"
+#include "trace.h"
+
+/****************************************************************************************
+Constants
+****************************************************************************************/
+
+#define SIM_CALL_CYCLES        30        /* estimate, a call, its body and the return */
+#define SIM_ISR_ENTRY_CYCLES   6         /* MSP430x2xx user's guide, interrupt acceptance */
+#define SIM_RETI_CYCLES        5
+#define SIM_MINUTE_TICKS       240
+
+#define SIM_P2_INPUTS          (P2_1_BUTTON_0 | P2_5_LOST_POWER_IND)
+#define SIM_P3_INPUTS          (P3_6_BUTTON_2 | P3_7_BUTTON_1)
+#define SIM_PINS_IDLE_P2       SIM_P2_INPUTS   /* power present, button 0 up */
+#define SIM_PINS_IDLE_P3       SIM_P3_INPUTS   /* buttons 1 and 2 up, each button pulls its pin low */
+
+/******************************************************************************
+Type Definitions
+******************************************************************************/
+
+/* The input pins from a time on, only the SIM_P2_INPUTS and SIM_P3_INPUTS bits are used */
+typedef struct
+{
+  u64 u64Time;
+  u8 u8P2IN;
+  u8 u8P3IN;
+} SimInput;
+
+/* Gives the next change of the input pins, in time order.  Returns FALSE when there are no more */
+typedef bool (*fnSim_Input_type)(SimInput* pInput);
+
+typedef struct
+{
+  u64 u64Interrupts;
+  u64 u64Wakes;
+  u64 u64Calls;                          //firmware function entries
+  u64 u64Awake_Cycles;                   //estimated, see SIM_CALL_CYCLES
+} SimStatistics;
+
+/* A run between two wakes, everything Sim_Run needs to carry on from it */
+typedef struct
+{
+  u64 u64Time;
+  u64 u64TA_Start;
+  u64 u64TA1_Start;
+  u64 u64Latched;
+  SimStatistics sStatistics;
+  u64 u64Input_Time;                     //the next change of the inputs, already fetched
+  u8 u8Input_P2IN;
+  u8 u8Input_P3IN;
+  u8 bInput;
+  u8 u8Pending;
+  u8 au8Spare[4];
+  HostSnapshot sHost;                    //last, the firmware's RAM at its end is mostly unused
+} SimSnapshot;
+
+extern u64 GG_u64Sim_Time;
+extern TraceWriter* GG_pSim_Trace;
+extern SimStatistics GG_sSim;
+
+/************************ Function Declarations ****************************/
+
+void Sim_Reset(fnSim_Input_type pfInput);
+void Sim_Run(u64 u64Until);
+void Sim_State(TraceState* pState);
+void Sim_Save(SimSnapshot* pSnapshot);
+void Sim_Restore(const SimSnapshot* pSnapshot, fnSim_Input_type pfInput);
+
+#endif /* __SIM_HEADER */
@@ -0,0 +1,394 @@
+/**********************************************************************
+* The simulator trace format, writing and reading
+
+See trace.h for the layout.  The writer buffers the records and keeps the index in memory until
+Trace_Close, the readers map the whole file and decode from an index entry.
+**********************************************************************/
+
+/************************ Revision History ****************************
+YYYY-MM-DD  Comments
+-------------------------------------------------------------------------------------------
+2026-10-19  File created
+
+************************************************************************/
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "trace.h"
+
+/******************** Program Globals ************************/
+const char* GG_apcTrace_Source[TRACE_SOURCES] = {"tick", "sub-tick", "melody", "repeat", "release", "port2"};
+
+/******************** Function Definitions ************************/
+
+/*------------------------------------------------------------------------------
+Function: Trace_Has_Value
+
+Description: Whether records of a type end with a value byte
+
+Promises: Returns TRUE for the ports and the interrupts
+*/
+bool Trace_Has_Value(u8 u8Type)
+{
+  return (u8Type < TRACE_PORTS || u8Type == TRACE_ISR) ? TRUE : FALSE;
+
+} /* end Trace_Has_Value */
+
+/*------------------------------------------------------------------------------
+Function: Trace_Flush
+
+Description: Writes the buffered records to the file
+
+Promises: The buffer is empty
+*/
+void Trace_Flush(TraceWriter* pWriter)
+{
+  fwrite(pWriter->pu8Buffer, 1, pWriter->u32Used, pWriter->pFile);
+  pWriter->u32Used = 0;
+
+} /* end Trace_Flush */
+
+/*------------------------------------------------------------------------------
+Function: Trace_Create
+
+Description: Starts a trace file, the header is written again with the totals by Trace_Close
+
+Requires: u64Index_Interval is not 0
+
+Promises: Returns FALSE if the file cannot be created
+*/
+bool Trace_Create(TraceWriter* pWriter, const char* pcPath, u64 u64Index_Interval, const TraceState* pStart)
+{
+  memset(pWriter, 0, sizeof(*pWriter));
+  pWriter->pFile = fopen(pcPath, "wb");
+  if(!pWriter->pFile)
+  {
+    return FALSE;
+  }
+  pWriter->pu8Buffer = malloc(TRACE_BUFFER_SIZE);
+  memcpy(pWriter->sHeader.acMagic, TRACE_MAGIC, sizeof(TRACE_MAGIC));
+  pWriter->sHeader.u32Version = TRACE_VERSION;
+  pWriter->sHeader.u32Clock_Hz = TRACE_ACLK_HZ;
+  pWriter->sHeader.u64Index_Interval = u64Index_Interval;
+  pWriter->sHeader.sStart = *pStart;
+  pWriter->sState = *pStart;
+  fwrite(&pWriter->sHeader, sizeof(pWriter->sHeader), 1, pWriter->pFile);
+  pWriter->u64Offset = sizeof(pWriter->sHeader);
+  return TRUE;
+
+} /* end Trace_Create */
+
+/*------------------------------------------------------------------------------
+Function: Trace_Write
+
+Description: Adds a record, and an index entry before it when it is the first in its interval
+
+Requires: u64Time is not before the last record's
+
+Promises: The record is buffered, u8Value is ignored for the types without one
+*/
+void Trace_Write(TraceWriter* pWriter, u64 u64Time, u8 u8Type, u8 u8Value)
+{
+  u64 u64Delta = u64Time - pWriter->u64Last;
+  u8* pu8Out;
+
+  if(u64Time >= pWriter->u64Next_Index)
+  {
+    if(pWriter->sHeader.u64Index_Entries == pWriter->u64Index_Room)
+    {
+      pWriter->u64Index_Room = pWriter->u64Index_Room ? 2 * pWriter->u64Index_Room : 1024;
+      pWriter->pIndex = realloc(pWriter->pIndex, pWriter->u64Index_Room * sizeof(TraceIndex));
+    }
+    pWriter->pIndex[pWriter->sHeader.u64Index_Entries].u64Time = pWriter->u64Last;
+    pWriter->pIndex[pWriter->sHeader.u64Index_Entries].u64Offset = pWriter->u64Offset + pWriter->u32Used;
+    pWriter->pIndex[pWriter->sHeader.u64Index_Entries].u64Record = pWriter->sHeader.u64Records;
+    pWriter->pIndex[pWriter->sHeader.u64Index_Entries].sState = pWriter->sState;
+    pWriter->sHeader.u64Index_Entries++;
+    pWriter->u64Next_Index = (u64Time / pWriter->sHeader.u64Index_Interval + 1) * pWriter->sHeader.u64Index_Interval;
+  }
+
+  /* A record is at most 1 + 10 + 1 bytes */
+  if(pWriter->u32Used > TRACE_BUFFER_SIZE - 12)
+  {
+    pWriter->u64Offset += pWriter->u32Used;
+    Trace_Flush(pWriter);
+  }
+  pu8Out = pWriter->pu8Buffer + pWriter->u32Used;
+  if(u64Delta < TRACE_DELTA_LONG)
+  {
+    *pu8Out++ = (u8)(u8Type | (u64Delta << 4));
+  }
+  else
+  {
+    *pu8Out++ = (u8)(u8Type | (TRACE_DELTA_LONG << 4));
+    u64Delta -= TRACE_DELTA_LONG;
+    while(u64Delta >= 0x80)
+    {
+      *pu8Out++ = (u8)(u64Delta | 0x80);
+      u64Delta >>= 7;
+    }
+    *pu8Out++ = (u8)u64Delta;
+  }
+  if(Trace_Has_Value(u8Type))
+  {
+    *pu8Out++ = u8Value;
+  }
+  pWriter->u32Used = (u32)(pu8Out - pWriter->pu8Buffer);
+  pWriter->u64Last = u64Time;
+  pWriter->sHeader.u64Records++;
+
+  if(u8Type < TRACE_PORTS)
+  {
+    pWriter->sState.au8Port[u8Type] = u8Value;
+  }
+  else if(u8Type == TRACE_WAKE)
+  {
+    pWriter->sState.u8Awake = 1;
+  }
+  else if(u8Type == TRACE_SLEEP)
+  {
+    pWriter->sState.u8Awake = 0;
+  }
+
+} /* end Trace_Write */
+
+/*------------------------------------------------------------------------------
+Function: Trace_Close
+
+Description: Writes the rest of the records, the index and the header with the totals
+
+Promises: Returns FALSE if any write failed, the writer's memory is freed either way
+*/
+bool Trace_Close(TraceWriter* pWriter, u64 u64End_Time)
+{
+  bool bGood;
+
+  pWriter->u64Offset += pWriter->u32Used;
+  Trace_Flush(pWriter);
+  pWriter->sHeader.u64End_Time = u64End_Time > pWriter->u64Last ? u64End_Time : pWriter->u64Last;
+  pWriter->sHeader.u64Index_Offset = pWriter->u64Offset;
+  fwrite(pWriter->pIndex, sizeof(TraceIndex), pWriter->sHeader.u64Index_Entries, pWriter->pFile);
+  fseek(pWriter->pFile, 0, SEEK_SET);
+  fwrite(&pWriter->sHeader, sizeof(pWriter->sHeader), 1, pWriter->pFile);
+  bGood = ferror(pWriter->pFile) ? FALSE : TRUE;
+  if(fclose(pWriter->pFile))
+  {
+    bGood = FALSE;
+  }
+  free(pWriter->pu8Buffer);
+  free(pWriter->pIndex);
+  return bGood;
+
+} /* end Trace_Close */
+
+/*------------------------------------------------------------------------------
+Function: Trace_Open
+
+Description: Maps a trace file read only and checks its header
+
+Promises: Returns FALSE, with the reason on stderr, if it is not a whole trace of this version
+*/
+bool Trace_Open(Trace* pTrace, const char* pcPath)
+{
+  struct stat sStat;
+  int iFile = open(pcPath, O_RDONLY);
+
+  memset(pTrace, 0, sizeof(*pTrace));
+  if(iFile < 0 || fstat(iFile, &sStat) || (u64)sStat.st_size < sizeof(TraceHeader))
+  {
+    fprintf(stderr, "%s: cannot read a trace\n", pcPath);
+    if(iFile >= 0)
+    {
+      close(iFile);
+    }
+    return FALSE;
+  }
+  pTrace->u64Size = sStat.st_size;
+  pTrace->pu8Base = mmap(NULL, pTrace->u64Size, PROT_READ, MAP_SHARED, iFile, 0);
+  close(iFile);
+  if(pTrace->pu8Base == MAP_FAILED)
+  {
+    fprintf(stderr, "%s: cannot map it\n", pcPath);
+    return FALSE;
+  }
+  pTrace->pHeader = (const TraceHeader*)pTrace->pu8Base;
+  if(memcmp(pTrace->pHeader->acMagic, TRACE_MAGIC, sizeof(TRACE_MAGIC)) ||
+     pTrace->pHeader->u32Version != TRACE_VERSION ||
+     pTrace->pHeader->u64Index_Offset + pTrace->pHeader->u64Index_Entries * sizeof(TraceIndex) != pTrace->u64Size)
+  {
+    fprintf(stderr, "%s: not a version %d trace, or the run did not finish\n", pcPath, TRACE_VERSION);
+    Trace_Unmap(pTrace);
+    return FALSE;
+  }
+  pTrace->pIndex = (const TraceIndex*)(pTrace->pu8Base + pTrace->pHeader->u64Index_Offset);
+  pTrace->pu8End = pTrace->pu8Base + pTrace->pHeader->u64Index_Offset;
+  madvise((void*)pTrace->pu8Base, pTrace->u64Size, MADV_SEQUENTIAL);
+  return TRUE;
+
+} /* end Trace_Open */
+
+/*------------------------------------------------------------------------------
+Function: Trace_Unmap
+
+Description: Unmaps a trace from Trace_Open
+
+Promises: pTrace can be opened again
+*/
+void Trace_Unmap(Trace* pTrace)
+{
+  if(pTrace->pu8Base && pTrace->pu8Base != MAP_FAILED)
+  {
+    munmap((void*)pTrace->pu8Base, pTrace->u64Size);
+  }
+  memset(pTrace, 0, sizeof(*pTrace));
+
+} /* end Trace_Unmap */
+
+/*------------------------------------------------------------------------------
+Function: Trace_Start
+
+Description: Puts a cursor at an index entry, past the last one is the end of the trace
+
+Promises: Trace_Next returns the records from the entry on
+*/
+void Trace_Start(TraceCursor* pCursor, const Trace* pTrace, u64 u64Entry)
+{
+  pCursor->pTrace = pTrace;
+  if(u64Entry < pTrace->pHeader->u64Index_Entries)
+  {
+    pCursor->pu8Next = pTrace->pu8Base + pTrace->pIndex[u64Entry].u64Offset;
+    pCursor->u64Time = pTrace->pIndex[u64Entry].u64Time;
+    pCursor->u64Record = pTrace->pIndex[u64Entry].u64Record;
+    pCursor->sState = pTrace->pIndex[u64Entry].sState;
+  }
+  else if(pTrace->pHeader->u64Index_Entries)
+  {
+    /* The state at the end is only known by reading the last interval */
+    TraceRecord sRecord;
+
+    Trace_Start(pCursor, pTrace, pTrace->pHeader->u64Index_Entries - 1);
+    while(Trace_Next(pCursor, &sRecord))
+    {
+    }
+  }
+  else
+  {
+    pCursor->pu8Next = pTrace->pu8End;
+    pCursor->u64Time = 0;
+    pCursor->u64Record = 0;
+    pCursor->sState = pTrace->pHeader->sStart;
+  }
+
+} /* end Trace_Start */
+
+/*------------------------------------------------------------------------------
+Function: Trace_Decode
+
+Description: Decodes the record at pu8Next without moving the cursor
+
+Promises: Returns the byte after the record, or NULL at the end of the records
+*/
+const u8* Trace_Decode(const TraceCursor* pCursor, TraceRecord* pRecord)
+{
+  const u8* pu8In = pCursor->pu8Next;
+  u64 u64Delta;
+  u8 u8Shift = 0;
+
+  if(pu8In >= pCursor->pTrace->pu8End)
+  {
+    return NULL;
+  }
+  pRecord->u8Type = *pu8In & 0x0F;
+  u64Delta = *pu8In++ >> 4;
+  if(u64Delta == TRACE_DELTA_LONG)
+  {
+    do
+    {
+      u64Delta += (u64)(*pu8In & 0x7F) << u8Shift;
+      u8Shift += 7;
+    } while(*pu8In++ & 0x80);
+  }
+  pRecord->u64Time = pCursor->u64Time + u64Delta;
+  pRecord->u8Value = Trace_Has_Value(pRecord->u8Type) ? *pu8In++ : 0;
+  return pu8In;
+
+} /* end Trace_Decode */
+
+/*------------------------------------------------------------------------------
+Function: Trace_Next
+
+Description: Reads the next record and applies it to the cursor's state
+
+Promises: Returns FALSE at the end of the trace
+*/
+bool Trace_Next(TraceCursor* pCursor, TraceRecord* pRecord)
+{
+  const u8* pu8After = Trace_Decode(pCursor, pRecord);
+
+  if(!pu8After)
+  {
+    return FALSE;
+  }
+  pCursor->pu8Next = pu8After;
+  pCursor->u64Time = pRecord->u64Time;
+  pCursor->u64Record++;
+  if(pRecord->u8Type < TRACE_PORTS)
+  {
+    pCursor->sState.au8Port[pRecord->u8Type] = pRecord->u8Value;
+  }
+  else if(pRecord->u8Type == TRACE_WAKE)
+  {
+    pCursor->sState.u8Awake = 1;
+  }
+  else if(pRecord->u8Type == TRACE_SLEEP)
+  {
+    pCursor->sState.u8Awake = 0;
+  }
+  return TRUE;
+
+} /* end Trace_Next */
+
+/*------------------------------------------------------------------------------
+Function: Trace_Seek
+
+Description: Puts a cursor just before the first record at or after a time.  A binary search of
+the index finds the last entry at or before the time, at most one interval is decoded after it.
+
+Promises: Trace_Next returns that record, the cursor's state is the pins just before it
+*/
+void Trace_Seek(TraceCursor* pCursor, const Trace* pTrace, u64 u64Time)
+{
+  u64 u64Low = 0;
+  u64 u64High = pTrace->pHeader->u64Index_Entries;
+  TraceRecord sRecord;
+  const u8* pu8After;
+
+  if(u64High == 0)
+  {
+    Trace_Start(pCursor, pTrace, 0);
+    return;
+  }
+  while(u64High - u64Low > 1)
+  {
+    u64 u64Middle = (u64Low + u64High) / 2;
+
+    if(pTrace->pIndex[u64Middle].u64Time <= u64Time)
+    {
+      u64Low = u64Middle;
+    }
+    else
+    {
+      u64High = u64Middle;
+    }
+  }
+  Trace_Start(pCursor, pTrace, u64Low);
+  while((pu8After = Trace_Decode(pCursor, &sRecord)) && sRecord.u64Time < u64Time)
+  {
+    Trace_Next(pCursor, &sRecord);
+  }
+
+} /* end Trace_Seek */
@@ -0,0 +1,149 @@
+/**********************************************************************
+* Header file for the simulator trace format
+
+A trace is what the pins and the CPU did during a simulated run: every change of the output and
+input ports, every interrupt, every wake and sleep of the main loop and every minute boundary.
+Times are ACLK counts since the reset, which are also MCLK cycles.
+
+The file is a header, the records, then the index:
+  - a record is a byte with its type in the low 4 bits and the time since the record before it
+    in the high 4 bits.  15 there means the time is 15 plus an unsigned LEB128 number after the
+    byte.  The port and interrupt records end with their value byte.
+  - an index entry is written every u64Index_Interval counts of simulated time that have a record.
+    It has the offset of a record, the time of the record before it and the state of the pins
+    at that point, so a reader can start decoding there without anything earlier.
+Readers mmap the file and find a time with a binary search of the index, see Trace_Seek.
+A clock that ticks with the power on is about 10 records and 31 bytes a simulated second, 1 GB a year.
+**********************************************************************/
+
+/************************ Revision History ****************************
+YYYY-MM-DD  Comments
+-------------------------------------------------------------------------------------------
+2026-10-19  File created
+
+************************************************************************/
+
+#ifndef __TRACE_HEADER
+#define __TRACE_HEADER
+
+#include <stdio.h>
+#include "typedef_MSP430.h"
+
+/****************************************************************************************
+Constants
+****************************************************************************************/
+
+#define TRACE_MAGIC            "BCLKTRC"
+#define TRACE_VERSION          1
+#define TRACE_ACLK_HZ          32768
+#define TRACE_INTERVAL_DEFAULT (60UL * TRACE_ACLK_HZ)   /* an index entry a minute */
+#define TRACE_BUFFER_SIZE      (1 << 20)
+#define TRACE_DELTA_LONG       15        /* the delta nibble for a LEB128 delta */
+
+/******************************************************************************
+Type Definitions
+******************************************************************************/
+
+typedef unsigned long long u64;
+
+/* Record types, 4 bits */
+typedef enum {TRACE_P1OUT, TRACE_P2OUT, TRACE_P3OUT, TRACE_P2IN, TRACE_P3IN,     //a port, the value is the new one
+              TRACE_ISR,                                                        //an interrupt, the value is a TraceSource
+              TRACE_WAKE,                                                       //an ISR woke the main loop, at its RETI
+              TRACE_SLEEP,                                                      //the main loop went into LPM3
+              TRACE_MINUTE,                                                     //the tick that ends a minute, before its ISR
+              TRACE_TYPES} TraceType;
+
+#define TRACE_PORTS            (TRACE_P3IN + 1)
+
+/* What caused an interrupt, the vector and for Timer A which of TAIV's flags */
+typedef enum {TRACE_SOURCE_TICK, TRACE_SOURCE_SUBTICK, TRACE_SOURCE_MELODY, TRACE_SOURCE_REPEAT,
+              TRACE_SOURCE_RELEASE, TRACE_SOURCE_PORT2, TRACE_SOURCES} TraceSource;
+
+/* The pins and the CPU at a point of the trace */
+typedef struct
+{
+  u8 au8Port[TRACE_PORTS];               //P1OUT, P2OUT, P3OUT, P2IN, P3IN
+  u8 u8Awake;                            //the main loop is running
+  u8 au8Spare[2];
+} TraceState;
+
+typedef struct
+{
+  char acMagic[8];
+  u32 u32Version;                        //u32 is 8 bytes on a 64 bit host, the file layout is the host's
+  u32 u32Clock_Hz;
+  u64 u64Records;
+  u64 u64End_Time;                       //the time the run stopped, not earlier than the last record
+  u64 u64Index_Offset;
+  u64 u64Index_Entries;
+  u64 u64Index_Interval;
+  TraceState sStart;                     //the pins before the first record
+} TraceHeader;
+
+typedef struct
+{
+  u64 u64Time;                           //of the record before u64Offset, the deltas start from it
+  u64 u64Offset;
+  u64 u64Record;                         //records before u64Offset
+  TraceState sState;
+} TraceIndex;
+
+typedef struct
+{
+  u64 u64Time;
+  u8 u8Type;
+  u8 u8Value;
+} TraceRecord;
+
+/* Writing a trace, Trace_Create to Trace_Close */
+typedef struct
+{
+  FILE* pFile;
+  u8* pu8Buffer;
+  u32 u32Used;
+  u64 u64Offset;                         //of the next record in the file
+  u64 u64Last;                           //time of the last record
+  u64 u64Next_Index;                     //the first record at or after this time gets an index entry
+  TraceHeader sHeader;
+  TraceState sState;
+  TraceIndex* pIndex;
+  u64 u64Index_Room;
+} TraceWriter;
+
+/* A trace mapped for reading, Trace_Open to Trace_Unmap */
+typedef struct
+{
+  const u8* pu8Base;
+  u64 u64Size;
+  const TraceHeader* pHeader;
+  const TraceIndex* pIndex;
+  const u8* pu8End;                      //of the records
+} Trace;
+
+/* Where a reader has got to in a trace */
+typedef struct
+{
+  const Trace* pTrace;
+  const u8* pu8Next;
+  u64 u64Time;                           //of the last record read
+  u64 u64Record;                         //records read
+  TraceState sState;                     //after the last record read
+} TraceCursor;
+
+/************************ Function Declarations ****************************/
+
+bool Trace_Create(TraceWriter* pWriter, const char* pcPath, u64 u64Index_Interval, const TraceState* pStart);
+void Trace_Write(TraceWriter* pWriter, u64 u64Time, u8 u8Type, u8 u8Value);
+bool Trace_Close(TraceWriter* pWriter, u64 u64End_Time);
+
+bool Trace_Open(Trace* pTrace, const char* pcPath);
+void Trace_Unmap(Trace* pTrace);
+void Trace_Start(TraceCursor* pCursor, const Trace* pTrace, u64 u64Entry);
+void Trace_Seek(TraceCursor* pCursor, const Trace* pTrace, u64 u64Time);
+bool Trace_Next(TraceCursor* pCursor, TraceRecord* pRecord);
+bool Trace_Has_Value(u8 u8Type);
+
+extern const char* GG_apcTrace_Source[TRACE_SOURCES];
+
+#endif /* __TRACE_HEADER */
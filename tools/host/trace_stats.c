@@ -0,0 +1,659 @@
+/**********************************************************************
+* Streaming analysis of a simulator trace
+
+Reads a trace (trace.h) in one pass and reports:
+  - the duty cycle of each LED, the time its pin is high over the run
+  - a histogram of the time awake per wake, WAKE to SLEEP, in cycles
+  - the latency from each minute boundary to the display changing: to the first LED that
+    changes and to the last one of the wake that changes it (settled), with the power on
+  - the latency from LOST_POWER_IND falling to the display going still, the last change of an LED
+    pin before the power comes back, and how many LED pins are left high.  Port2ISR does not drive
+    the pins low (its Port1_LP_Sleep writes are commented out), the LEDs go dark with the supply.
+The code times in a trace are sim.c's estimate, the timer and pin times are exact.
+
+The trace is cut at its index entries into chunks that the threads take in turn, each thread adds
+into its own totals, which are only sums, counts and extremes so memory does not grow with the
+trace.  A wake, minute or power loss still open at the end of a chunk is followed into the next
+chunk by the thread that has it, and ignored by the thread that starts there.
+
+-w writes the results as a baseline, -b compares with one and exits 1 if anything got worse by
+more than -T percent: a latency or wake time that went up, a duty cycle that moved either way, or
+more minutes without an update or more LED pins left high on battery.
+
+Build:   make trace_stats
+Use:     trace_stats [-j threads] [-w baseline] [-b baseline] [-T percent] trace
+         trace_stats -b day.baseline day.trace       make check runs this on clock_sim -d 1 -c 10
+**********************************************************************/
+
+/************************ Revision History ****************************
+YYYY-MM-DD  Comments
+-------------------------------------------------------------------------------------------
+2026-10-19  File created
+
+************************************************************************/
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "trace.h"
+#include "bnclk-efwd-01.h"
+
+#define THREADS_MAX            64
+#define CHUNKS_PER_THREAD      16
+#define WAKE_BIN_CYCLES        32
+#define WAKE_BINS              64        /* the last is everything longer */
+#define TOLERANCE_DEFAULT      5.0       /* percent */
+#define DUTY_SLACK             0.01      /* percentage points a duty cycle may move whatever -T is */
+#define CYCLE_SLACK            2         /* cycles a latency may grow whatever -T is */
+#define METRICS_MAX            64
+#define NAME_SIZE              32
+
+typedef struct
+{
+  const char* pcName;
+  u8 u8Port;                             //TRACE_P1OUT to TRACE_P3OUT
+  u8 u8Pin;
+} Led;
+
+const Led aLed[] = {{"hour_0", TRACE_P3OUT, P3_2_HOUR_0}, {"hour_1", TRACE_P3OUT, P3_1_HOUR_1},
+                    {"hour_2", TRACE_P3OUT, P3_0_HOUR_2}, {"hour_3", TRACE_P2OUT, P2_2_HOUR_3},
+                    {"minute_0", TRACE_P1OUT, P1_3_MINUTE_0}, {"minute_1", TRACE_P1OUT, P1_2_MINUTE_1},
+                    {"minute_2", TRACE_P1OUT, P1_1_MINUTE_2}, {"minute_3", TRACE_P1OUT, P1_0_MINUTE_3},
+                    {"minute_4", TRACE_P2OUT, P2_4_MINUTE_4}, {"minute_5", TRACE_P2OUT, P2_3_MINUTE_5},
+                    {"pm", TRACE_P3OUT, P3_5_POMI_PM_IND}, {"tick", TRACE_P3OUT, P3_4_PIMO_TICK}};
+
+#define LEDS                   (sizeof(aLed) / sizeof(aLed[0]))
+
+/* The LED pins of each output port, and those that show the time (all but TICK) */
+const u8 au8Led_Pins[3] = {0x0F, P2_2_HOUR_3 | P2_3_MINUTE_5 | P2_4_MINUTE_4,
+                           P3_0_HOUR_2 | P3_1_HOUR_1 | P3_2_HOUR_0 | P3_4_PIMO_TICK | P3_5_POMI_PM_IND};
+const u8 au8Display_Pins[3] = {0x0F, P2_2_HOUR_3 | P2_3_MINUTE_5 | P2_4_MINUTE_4,
+                               P3_0_HOUR_2 | P3_1_HOUR_1 | P3_2_HOUR_0 | P3_5_POMI_PM_IND};
+
+/* Sums, counts and extremes of a number of samples */
+typedef struct
+{
+  u64 u64Count;
+  u64 u64Sum;
+  u64 u64Min;
+  u64 u64Max;
+} Summary;
+
+/* What one thread has added up */
+typedef struct
+{
+  u64 au64Port_Time[3][256];             //counts each output port had each value, for the duty cycles
+  u64 u64Time;                           //counts covered
+  u64 au64Wake_Bin[WAKE_BINS];
+  Summary sWake;
+  Summary sMinute_First;
+  Summary sMinute_Settled;
+  u64 u64Minute_Missed;                  //boundaries with the power on and no change before the next
+  Summary sDark;                         //loss to the last LED pin change on battery
+  u64 u64Lit_Pins;                       //LED pins high when the power came back, over all losses
+  u64 u64Records;
+} Totals;
+
+/* What is open while a chunk is read, see Chunk */
+typedef struct
+{
+  bool bWake;
+  u64 u64Wake;
+  bool bMinute;
+  u64 u64Minute;
+  bool bChanged;                         //the display has changed since u64Minute
+  u64 u64Changed;
+  bool bLoss;
+  u64 u64Loss;
+  u64 u64Loss_Still;                     //the last LED pin change since u64Loss
+} Open;
+
+typedef struct
+{
+  char acName[NAME_SIZE];
+  double dValue;
+  u8 u8Kind;                             //KIND_*
+} Metric;
+
+#define KIND_EITHER            0         /* worse if it moves either way */
+#define KIND_HIGHER            1         /* worse if it goes up */
+
+/* Options */
+int iThreads = 0;
+const char* pcWrite = NULL;
+const char* pcBaseline = NULL;
+double dTolerance = TOLERANCE_DEFAULT;
+
+/* The chunks the threads take, an index entry each or a few */
+const Trace* pTrace;
+u64 u64Chunks;
+u64 u64Chunk_Entries;
+u64 u64Next_Chunk = 0;
+
+/*------------------------------------------------------------------------------
+Function: Summary_Add
+
+Description: Adds a sample
+
+Promises: The count, sum and extremes include it
+*/
+void Summary_Add(Summary* pSummary, u64 u64Value)
+{
+  if(pSummary->u64Count == 0 || u64Value < pSummary->u64Min)
+  {
+    pSummary->u64Min = u64Value;
+  }
+  if(u64Value > pSummary->u64Max)
+  {
+    pSummary->u64Max = u64Value;
+  }
+  pSummary->u64Count++;
+  pSummary->u64Sum += u64Value;
+
+} /* end Summary_Add */
+
+/*------------------------------------------------------------------------------
+Function: Summary_Merge
+
+Description: Adds one summary into another
+
+Promises: pInto is as if it had had all of pFrom's samples too
+*/
+void Summary_Merge(Summary* pInto, const Summary* pFrom)
+{
+  if(pFrom->u64Count == 0)
+  {
+    return;
+  }
+  if(pInto->u64Count == 0 || pFrom->u64Min < pInto->u64Min)
+  {
+    pInto->u64Min = pFrom->u64Min;
+  }
+  if(pFrom->u64Max > pInto->u64Max)
+  {
+    pInto->u64Max = pFrom->u64Max;
+  }
+  pInto->u64Count += pFrom->u64Count;
+  pInto->u64Sum += pFrom->u64Sum;
+
+} /* end Summary_Merge */
+
+/*------------------------------------------------------------------------------
+Function: Lit_Pins
+
+Description: The LED pins that are high
+
+Promises: Returns how many
+*/
+u8 Lit_Pins(const TraceState* pState)
+{
+  u8 u8Lit = 0;
+
+  for(u8 i = 0; i < 3; i++)
+  {
+    u8Lit += __builtin_popcount(pState->au8Port[TRACE_P1OUT + i] & au8Led_Pins[i]);
+  }
+  return u8Lit;
+
+} /* end Lit_Pins */
+
+/*------------------------------------------------------------------------------
+Function: Loss_Close
+
+Description: The power has come back, or the trace ended, after a loss
+
+Promises: The loss is in the totals and closed
+*/
+void Loss_Close(Totals* pTotals, Open* pOpen, const TraceState* pState)
+{
+  pOpen->bLoss = FALSE;
+  Summary_Add(&pTotals->sDark, pOpen->u64Loss_Still - pOpen->u64Loss);
+  pTotals->u64Lit_Pins += Lit_Pins(pState);
+
+} /* end Loss_Close */
+
+/*------------------------------------------------------------------------------
+Function: Record
+
+Description: Acts on one record.  bStart is FALSE once the chunk is over, then only what is
+open is closed.
+
+Requires: pBefore is the state before the record
+
+Promises: The totals have what the record closed
+*/
+void Record(Totals* pTotals, Open* pOpen, const TraceRecord* pRecord, const TraceState* pBefore, bool bStart)
+{
+  u64 u64Time = pRecord->u64Time;
+  u8 u8Bin;
+
+  switch(pRecord->u8Type)
+  {
+    case TRACE_WAKE:
+      if(bStart)
+      {
+        pOpen->bWake = TRUE;
+        pOpen->u64Wake = u64Time;
+      }
+      break;
+
+    case TRACE_SLEEP:
+      if(pOpen->bWake)
+      {
+        pOpen->bWake = FALSE;
+        u8Bin = (u64Time - pOpen->u64Wake) / WAKE_BIN_CYCLES < WAKE_BINS - 1 ? (u64Time - pOpen->u64Wake) / WAKE_BIN_CYCLES
+                                                                               : WAKE_BINS - 1;
+        pTotals->au64Wake_Bin[u8Bin]++;
+        Summary_Add(&pTotals->sWake, u64Time - pOpen->u64Wake);
+      }
+      if(pOpen->bMinute && pOpen->bChanged)
+      {
+        pOpen->bMinute = FALSE;
+        Summary_Add(&pTotals->sMinute_Settled, pOpen->u64Changed - pOpen->u64Minute);
+      }
+      break;
+
+    case TRACE_MINUTE:
+      if(bStart && (pBefore->au8Port[TRACE_P2IN] & P2_5_LOST_POWER_IND))
+      {
+        if(pOpen->bMinute)
+        {
+          pTotals->u64Minute_Missed++;
+        }
+        pOpen->bMinute = TRUE;
+        pOpen->bChanged = FALSE;
+        pOpen->u64Minute = u64Time;
+      }
+      break;
+
+    case TRACE_P1OUT:
+    case TRACE_P2OUT:
+    case TRACE_P3OUT:
+      if(pOpen->bMinute && ((pBefore->au8Port[pRecord->u8Type] ^ pRecord->u8Value) & au8Display_Pins[pRecord->u8Type]))
+      {
+        if(!pOpen->bChanged)
+        {
+          Summary_Add(&pTotals->sMinute_First, u64Time - pOpen->u64Minute);
+        }
+        pOpen->bChanged = TRUE;
+        pOpen->u64Changed = u64Time;
+      }
+      if(pOpen->bLoss && ((pBefore->au8Port[pRecord->u8Type] ^ pRecord->u8Value) & au8Led_Pins[pRecord->u8Type]))
+      {
+        pOpen->u64Loss_Still = u64Time;
+      }
+      break;
+
+    case TRACE_P2IN:
+      if((pBefore->au8Port[TRACE_P2IN] & ~pRecord->u8Value) & P2_5_LOST_POWER_IND)
+      {
+        /* A minute open now would take the display going dark as its update */
+        pOpen->bMinute = FALSE;
+        if(bStart)
+        {
+          pOpen->bLoss = TRUE;
+          pOpen->u64Loss = u64Time;
+          pOpen->u64Loss_Still = u64Time;
+        }
+      }
+      else if((~pBefore->au8Port[TRACE_P2IN] & pRecord->u8Value) & P2_5_LOST_POWER_IND && pOpen->bLoss)
+      {
+        Loss_Close(pTotals, pOpen, pBefore);
+      }
+      break;
+
+    default:
+      break;
+  }
+
+} /* end Record */
+
+/*------------------------------------------------------------------------------
+Function: Chunk
+
+Description: Adds up the records from index entry u64Entry up to the one after it, then follows
+what is still open until it closes
+
+Promises: The chunk is in pTotals
+*/
+void Chunk(Totals* pTotals, u64 u64Entry, u64 u64Entries)
+{
+  const TraceHeader* pHeader = pTrace->pHeader;
+  u64 u64Last_Entry = u64Entry + u64Entries;
+  u64 u64End_Record = u64Last_Entry < pHeader->u64Index_Entries ? pTrace->pIndex[u64Last_Entry].u64Record : pHeader->u64Records;
+  u64 u64End_Time = u64Last_Entry < pHeader->u64Index_Entries ? pTrace->pIndex[u64Last_Entry].u64Time : pHeader->u64End_Time;
+  TraceCursor sCursor;
+  TraceRecord sRecord;
+  TraceState sBefore;
+  Open sOpen;
+  u64 u64Now;
+
+  memset(&sOpen, 0, sizeof(sOpen));
+  Trace_Start(&sCursor, pTrace, u64Entry);
+  u64Now = sCursor.u64Time;
+  sBefore = sCursor.sState;
+  while(sCursor.u64Record < u64End_Record && Trace_Next(&sCursor, &sRecord))
+  {
+    if(sRecord.u64Time != u64Now)
+    {
+      for(u8 i = 0; i < 3; i++)
+      {
+        pTotals->au64Port_Time[i][sBefore.au8Port[TRACE_P1OUT + i]] += sRecord.u64Time - u64Now;
+      }
+      pTotals->u64Time += sRecord.u64Time - u64Now;
+      u64Now = sRecord.u64Time;
+    }
+    Record(pTotals, &sOpen, &sRecord, &sBefore, TRUE);
+    sBefore = sCursor.sState;
+    pTotals->u64Records++;
+  }
+  for(u8 i = 0; i < 3; i++)
+  {
+    pTotals->au64Port_Time[i][sBefore.au8Port[TRACE_P1OUT + i]] += u64End_Time - u64Now;
+  }
+  pTotals->u64Time += u64End_Time - u64Now;
+
+  while((sOpen.bWake || sOpen.bMinute || sOpen.bLoss) && Trace_Next(&sCursor, &sRecord))
+  {
+    Record(pTotals, &sOpen, &sRecord, &sBefore, FALSE);
+    sBefore = sCursor.sState;
+  }
+  if(sOpen.bLoss)
+  {
+    Loss_Close(pTotals, &sOpen, &sBefore);
+  }
+
+} /* end Chunk */
+
+/*------------------------------------------------------------------------------
+Function: Worker
+
+Description: A thread, takes chunks until there are none left
+
+Promises: pvTotals has the chunks it took
+*/
+void* Worker(void* pvTotals)
+{
+  u64 u64Chunk;
+
+  while((u64Chunk = __atomic_fetch_add(&u64Next_Chunk, 1, __ATOMIC_RELAXED)) < u64Chunks)
+  {
+    u64 u64Entry = u64Chunk * u64Chunk_Entries;
+    u64 u64Count = u64Entry + u64Chunk_Entries <= pTrace->pHeader->u64Index_Entries
+                   ? u64Chunk_Entries : pTrace->pHeader->u64Index_Entries - u64Entry;
+
+    Chunk((Totals*)pvTotals, u64Entry, u64Count);
+  }
+  return NULL;
+
+} /* end Worker */
+
+/*------------------------------------------------------------------------------
+Function: Metric_Add
+
+Description: Adds a result to the list that is printed, written as a baseline and compared
+
+Promises: The list has it
+*/
+void Metric_Add(Metric* aMetric, u8* pu8Count, const char* pcName, double dValue, u8 u8Kind)
+{
+  if(*pu8Count < METRICS_MAX)
+  {
+    snprintf(aMetric[*pu8Count].acName, NAME_SIZE, "%s", pcName);
+    aMetric[*pu8Count].dValue = dValue;
+    aMetric[*pu8Count].u8Kind = u8Kind;
+    (*pu8Count)++;
+  }
+
+} /* end Metric_Add */
+
+/*------------------------------------------------------------------------------
+Function: Percentile
+
+Description: A percentile of the wake histogram
+
+Promises: Returns the top of the bin it is in, in cycles
+*/
+double Percentile(const Totals* pTotals, double dFraction)
+{
+  u64 u64Seen = 0;
+
+  for(u8 i = 0; i < WAKE_BINS; i++)
+  {
+    u64Seen += pTotals->au64Wake_Bin[i];
+    if(u64Seen >= dFraction * pTotals->sWake.u64Count)
+    {
+      return i < WAKE_BINS - 1 ? (i + 1) * WAKE_BIN_CYCLES : (double)pTotals->sWake.u64Max;
+    }
+  }
+  return 0;
+
+} /* end Percentile */
+
+/*------------------------------------------------------------------------------
+Function: Compare
+
+Description: Compares the results with a baseline file of "name value" lines
+
+Promises: Returns the number of results that got worse, each is printed
+*/
+int Compare(const Metric* aMetric, u8 u8Count, const char* pcPath)
+{
+  FILE* pFile = fopen(pcPath, "r");
+  char acName[NAME_SIZE];
+  double dBase;
+  double dSlack;
+  int iWorse = 0;
+
+  if(!pFile)
+  {
+    perror(pcPath);
+    exit(2);
+  }
+  while(fscanf(pFile, "%31s %lf", acName, &dBase) == 2)
+  {
+    for(u8 i = 0; i < u8Count; i++)
+    {
+      if(strcmp(acName, aMetric[i].acName))
+      {
+        continue;
+      }
+      dSlack = dBase * dTolerance / 100;
+      dSlack = dSlack < 0 ? -dSlack : dSlack;
+      dSlack += strncmp(acName, "duty_", 5) ? CYCLE_SLACK : DUTY_SLACK;
+      if(aMetric[i].dValue > dBase + dSlack || (aMetric[i].u8Kind == KIND_EITHER && aMetric[i].dValue < dBase - dSlack))
+      {
+        printf("REGRESSION %-24s %14.4f, baseline %.4f\n", acName, aMetric[i].dValue, dBase);
+        iWorse++;
+      }
+    }
+  }
+  fclose(pFile);
+  return iWorse;
+
+} /* end Compare */
+
+/*------------------------------------------------------------------------------
+Function: Mean
+
+Description: The mean of a summary
+
+Promises: Returns 0 for no samples
+*/
+double Mean(const Summary* pSummary)
+{
+  return pSummary->u64Count ? (double)pSummary->u64Sum / pSummary->u64Count : 0.0;
+
+} /* end Mean */
+
+/*------------------------------------------------------------------------------
+Function: Seconds
+
+Description: Wall clock time
+
+Promises: Returns seconds from an arbitrary start
+*/
+double Seconds(void)
+{
+  struct timespec sNow;
+
+  clock_gettime(CLOCK_MONOTONIC, &sNow);
+  return sNow.tv_sec + sNow.tv_nsec * 1e-9;
+
+} /* end Seconds */
+
+int main(int argc, char** argv)
+{
+  int iOption;
+  Trace sTrace;
+  pthread_t aThread[THREADS_MAX];
+  Totals aTotals[THREADS_MAX];
+  Totals sAll;
+  Metric aMetric[METRICS_MAX];
+  u8 u8Metrics = 0;
+  char acName[NAME_SIZE];
+  double dStart;
+  double dWall;
+  FILE* pFile;
+  int iWorse = 0;
+
+  while((iOption = getopt(argc, argv, "j:w:b:T:")) != -1)
+  {
+    switch(iOption)
+    {
+      case 'j': iThreads = atoi(optarg); break;
+      case 'w': pcWrite = optarg; break;
+      case 'b': pcBaseline = optarg; break;
+      case 'T': dTolerance = atof(optarg); break;
+      default:  optind = argc + 1; break;
+    }
+  }
+  if(optind != argc - 1)
+  {
+    fprintf(stderr, "usage: %s [-j threads] [-w baseline] [-b baseline] [-T percent] trace\n", argv[0]);
+    return 2;
+  }
+  if(iThreads <= 0)
+  {
+    iThreads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+  }
+  iThreads = iThreads > THREADS_MAX ? THREADS_MAX : iThreads < 1 ? 1 : iThreads;
+  if(!Trace_Open(&sTrace, argv[optind]))
+  {
+    return 2;
+  }
+  pTrace = &sTrace;
+  u64Chunk_Entries = sTrace.pHeader->u64Index_Entries / (iThreads * CHUNKS_PER_THREAD);
+  u64Chunk_Entries = u64Chunk_Entries ? u64Chunk_Entries : 1;
+  u64Chunks = (sTrace.pHeader->u64Index_Entries + u64Chunk_Entries - 1) / u64Chunk_Entries;
+
+  dStart = Seconds();
+  memset(aTotals, 0, sizeof(aTotals));
+  for(int i = 0; i < iThreads; i++)
+  {
+    pthread_create(&aThread[i], NULL, Worker, &aTotals[i]);
+  }
+  memset(&sAll, 0, sizeof(sAll));
+  for(int i = 0; i < iThreads; i++)
+  {
+    pthread_join(aThread[i], NULL);
+    for(u16 j = 0; j < 3 * 256; j++)
+    {
+      sAll.au64Port_Time[j / 256][j % 256] += aTotals[i].au64Port_Time[j / 256][j % 256];
+    }
+    for(u8 j = 0; j < WAKE_BINS; j++)
+    {
+      sAll.au64Wake_Bin[j] += aTotals[i].au64Wake_Bin[j];
+    }
+    sAll.u64Time += aTotals[i].u64Time;
+    sAll.u64Minute_Missed += aTotals[i].u64Minute_Missed;
+    sAll.u64Lit_Pins += aTotals[i].u64Lit_Pins;
+    sAll.u64Records += aTotals[i].u64Records;
+    Summary_Merge(&sAll.sWake, &aTotals[i].sWake);
+    Summary_Merge(&sAll.sMinute_First, &aTotals[i].sMinute_First);
+    Summary_Merge(&sAll.sMinute_Settled, &aTotals[i].sMinute_Settled);
+    Summary_Merge(&sAll.sDark, &aTotals[i].sDark);
+  }
+  /* The time before the first record is not in any chunk */
+  if(sTrace.pHeader->u64Index_Entries == 0)
+  {
+    sAll.u64Time = sTrace.pHeader->u64End_Time;
+  }
+  dWall = Seconds() - dStart;
+
+  printf("%s: %.2f simulated days, %llu records, %d threads, %.2f s, %.0f million records/s\n", argv[optind],
+         sAll.u64Time / (86400.0 * TRACE_ACLK_HZ), sAll.u64Records, iThreads, dWall, sAll.u64Records / dWall / 1e6);
+  printf("LED duty cycles\n");
+  for(u8 i = 0; i < LEDS; i++)
+  {
+    u64 u64High = 0;
+    double dDuty;
+
+    for(u16 j = 0; j < 256; j++)
+    {
+      u64High += (j & aLed[i].u8Pin) ? sAll.au64Port_Time[aLed[i].u8Port][j] : 0;
+    }
+    dDuty = sAll.u64Time ? 100.0 * u64High / sAll.u64Time : 0.0;
+
+    printf("  %-10s %8.4f%%\n", aLed[i].pcName, dDuty);
+    snprintf(acName, NAME_SIZE, "duty_%s", aLed[i].pcName);
+    Metric_Add(aMetric, &u8Metrics, acName, dDuty, KIND_EITHER);
+  }
+  printf("Time awake per wake, cycles (%llu wakes, mean %.1f, 50%% <= %.0f, 99%% <= %.0f, max %llu)\n",
+         sAll.sWake.u64Count, Mean(&sAll.sWake), Percentile(&sAll, 0.5), Percentile(&sAll, 0.99), sAll.sWake.u64Max);
+  for(u8 i = 0; i < WAKE_BINS; i++)
+  {
+    if(sAll.au64Wake_Bin[i])
+    {
+      int iBar = (int)(50.0 * sAll.au64Wake_Bin[i] / sAll.sWake.u64Count + 0.5);
+
+      printf("  %5d%s %12llu %.*s\n", i * WAKE_BIN_CYCLES, i < WAKE_BINS - 1 ? "- " : "+ ", sAll.au64Wake_Bin[i],
+             iBar, "##################################################");
+    }
+  }
+  Metric_Add(aMetric, &u8Metrics, "wake_mean", Mean(&sAll.sWake), KIND_HIGHER);
+  Metric_Add(aMetric, &u8Metrics, "wake_99", Percentile(&sAll, 0.99), KIND_HIGHER);
+  Metric_Add(aMetric, &u8Metrics, "wake_max", (double)sAll.sWake.u64Max, KIND_HIGHER);
+  printf("Minute boundary to display, cycles (%llu minutes, %llu without an update)\n",
+         sAll.sMinute_First.u64Count, sAll.u64Minute_Missed);
+  printf("  first LED   min %llu mean %.1f max %llu, jitter %llu\n", sAll.sMinute_First.u64Min, Mean(&sAll.sMinute_First),
+         sAll.sMinute_First.u64Max, sAll.sMinute_First.u64Max - sAll.sMinute_First.u64Min);
+  printf("  settled     min %llu mean %.1f max %llu, jitter %llu\n", sAll.sMinute_Settled.u64Min,
+         Mean(&sAll.sMinute_Settled), sAll.sMinute_Settled.u64Max, sAll.sMinute_Settled.u64Max - sAll.sMinute_Settled.u64Min);
+  Metric_Add(aMetric, &u8Metrics, "minute_first_mean", Mean(&sAll.sMinute_First), KIND_HIGHER);
+  Metric_Add(aMetric, &u8Metrics, "minute_first_max", (double)sAll.sMinute_First.u64Max, KIND_HIGHER);
+  Metric_Add(aMetric, &u8Metrics, "minute_settled_max", (double)sAll.sMinute_Settled.u64Max, KIND_HIGHER);
+  Metric_Add(aMetric, &u8Metrics, "minute_missed", (double)sAll.u64Minute_Missed, KIND_HIGHER);
+  printf("Power lost to the last LED pin change, cycles (%llu losses, %.2f LED pins left high on average)\n",
+         sAll.sDark.u64Count, sAll.sDark.u64Count ? (double)sAll.u64Lit_Pins / sAll.sDark.u64Count : 0.0);
+  printf("  min %llu mean %.1f max %llu\n", sAll.sDark.u64Min, Mean(&sAll.sDark), sAll.sDark.u64Max);
+  Metric_Add(aMetric, &u8Metrics, "dark_mean", Mean(&sAll.sDark), KIND_HIGHER);
+  Metric_Add(aMetric, &u8Metrics, "dark_max", (double)sAll.sDark.u64Max, KIND_HIGHER);
+  Metric_Add(aMetric, &u8Metrics, "dark_lit_pins", sAll.sDark.u64Count ? (double)sAll.u64Lit_Pins / sAll.sDark.u64Count : 0.0,
+             KIND_HIGHER);
+
+  if(pcWrite)
+  {
+    if(!(pFile = fopen(pcWrite, "w")))
+    {
+      perror(pcWrite);
+      return 2;
+    }
+    for(u8 i = 0; i < u8Metrics; i++)
+    {
+      fprintf(pFile, "%s %.6f\n", aMetric[i].acName, aMetric[i].dValue);
+    }
+    fclose(pFile);
+  }
+  if(pcBaseline)
+  {
+    iWorse = Compare(aMetric, u8Metrics, pcBaseline);
+    printf("%d regressions against %s (-T %.1f%%)\n", iWorse, pcBaseline, dTolerance);
+  }
+  Trace_Unmap(&sTrace);
+  return iWorse ? 1 : 0;
+
+} /* end main */
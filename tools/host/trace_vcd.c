@@ -0,0 +1,166 @@
+/**********************************************************************
+* Converts a simulator trace to a VCD file for a waveform viewer
+
+The ports are 8 bit signals, awake is 1 while the main loop runs, and each interrupt source and
+the minute boundary are VCD events.  -f and -t take a window of the run in simulated seconds; the
+start is found with the trace's index, so a window late in a long run is as quick as one at its start.
+
+Build:   make trace_vcd
+Use:     trace_vcd [-f from_seconds] [-t to_seconds] trace [out.vcd]
+         trace_vcd -f 3600 -t 3660 year.trace hour1.vcd      then gtkwave hour1.vcd
+**********************************************************************/
+
+/************************ Revision History ****************************
+YYYY-MM-DD  Comments
+-------------------------------------------------------------------------------------------
+2026-10-19  File created
+
+************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "trace.h"
+
+/* VCD identifiers, one character each */
+#define ID_PORT                '!'       /* to '%', one per port */
+#define ID_AWAKE               'a'
+#define ID_SOURCE              'i'       /* to 'n', one per TraceSource */
+#define ID_MINUTE              'z'
+
+const char* apcPort_Name[TRACE_PORTS] = {"P1OUT", "P2OUT", "P3OUT", "P2IN", "P3IN"};
+
+/*------------------------------------------------------------------------------
+Function: Nanoseconds
+
+Description: A trace time in ns, 1e9 / 32768 is 1953125 / 64
+
+Promises: Returns it rounded down, without overflow for any run under 9000 years
+*/
+u64 Nanoseconds(u64 u64Counts)
+{
+  return (u64Counts / 64) * 1953125 + (u64Counts % 64) * 1953125 / 64;
+
+} /* end Nanoseconds */
+
+/*------------------------------------------------------------------------------
+Function: Binary
+
+Description: Writes a port's value change
+
+Promises: A line "b<8 bits> <id>"
+*/
+void Binary(FILE* pOut, u8 u8Value, char cId)
+{
+  char acBits[9];
+
+  for(u8 i = 0; i < 8; i++)
+  {
+    acBits[i] = (u8Value & (0x80 >> i)) ? '1' : '0';
+  }
+  acBits[8] = '\0';
+  fprintf(pOut, "b%s %c\n", acBits, cId);
+
+} /* end Binary */
+
+int main(int argc, char** argv)
+{
+  int iOption;
+  double dFrom = 0;
+  double dTo = -1;
+  Trace sTrace;
+  TraceCursor sCursor;
+  TraceRecord sRecord;
+  FILE* pOut = stdout;
+  u64 u64From;
+  u64 u64To;
+  u64 u64Written = ~0ULL;
+  u64 u64Changes = 0;
+
+  while((iOption = getopt(argc, argv, "f:t:")) != -1)
+  {
+    switch(iOption)
+    {
+      case 'f': dFrom = atof(optarg); break;
+      case 't': dTo = atof(optarg); break;
+      default:  optind = argc + 1; break;
+    }
+  }
+  if(optind != argc - 1 && optind != argc - 2)
+  {
+    fprintf(stderr, "usage: %s [-f from_seconds] [-t to_seconds] trace [out.vcd]\n", argv[0]);
+    return 2;
+  }
+  if(!Trace_Open(&sTrace, argv[optind]))
+  {
+    return 2;
+  }
+  if(optind == argc - 2 && !(pOut = fopen(argv[optind + 1], "w")))
+  {
+    perror(argv[optind + 1]);
+    return 2;
+  }
+  u64From = (u64)(dFrom * TRACE_ACLK_HZ);
+  u64To = dTo < 0 ? sTrace.pHeader->u64End_Time : (u64)(dTo * TRACE_ACLK_HZ);
+
+  fprintf(pOut, "$version binary clock simulator trace $end\n$timescale 1ns $end\n$scope module clock $end\n");
+  for(u8 i = 0; i < TRACE_PORTS; i++)
+  {
+    fprintf(pOut, "$var wire 8 %c %s $end\n", ID_PORT + i, apcPort_Name[i]);
+  }
+  fprintf(pOut, "$var wire 1 %c awake $end\n", ID_AWAKE);
+  for(u8 i = 0; i < TRACE_SOURCES; i++)
+  {
+    fprintf(pOut, "$var event 1 %c isr_%s $end\n", ID_SOURCE + i, GG_apcTrace_Source[i]);
+  }
+  fprintf(pOut, "$var event 1 %c minute $end\n$upscope $end\n$enddefinitions $end\n", ID_MINUTE);
+
+  /* The state at the start of the window comes from the index entry before it */
+  Trace_Seek(&sCursor, &sTrace, u64From);
+  fprintf(pOut, "#%llu\n$dumpvars\n", Nanoseconds(u64From));
+  for(u8 i = 0; i < TRACE_PORTS; i++)
+  {
+    Binary(pOut, sCursor.sState.au8Port[i], ID_PORT + i);
+  }
+  fprintf(pOut, "%d%c\n$end\n", sCursor.sState.u8Awake, ID_AWAKE);
+  u64Written = Nanoseconds(u64From);
+
+  while(Trace_Next(&sCursor, &sRecord) && sRecord.u64Time <= u64To)
+  {
+    if(Nanoseconds(sRecord.u64Time) != u64Written)
+    {
+      u64Written = Nanoseconds(sRecord.u64Time);
+      fprintf(pOut, "#%llu\n", u64Written);
+    }
+    switch(sRecord.u8Type)
+    {
+      case TRACE_WAKE:
+      case TRACE_SLEEP:
+        fprintf(pOut, "%d%c\n", sRecord.u8Type == TRACE_WAKE, ID_AWAKE);
+        break;
+
+      case TRACE_ISR:
+        fprintf(pOut, "1%c\n", ID_SOURCE + sRecord.u8Value);
+        break;
+
+      case TRACE_MINUTE:
+        fprintf(pOut, "1%c\n", ID_MINUTE);
+        break;
+
+      default:
+        Binary(pOut, sRecord.u8Value, ID_PORT + sRecord.u8Type);
+        break;
+    }
+    u64Changes++;
+  }
+  fprintf(pOut, "#%llu\n", Nanoseconds(u64To));
+  fprintf(stderr, "%llu changes from %.3f s to %.3f s\n", u64Changes, (double)u64From / TRACE_ACLK_HZ,
+          (double)u64To / TRACE_ACLK_HZ);
+  if(pOut != stdout)
+  {
+    fclose(pOut);
+  }
+  Trace_Unmap(&sTrace);
+  return 0;
+
+} /* end main */
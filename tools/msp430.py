@@ -0,0 +1,467 @@
+"""Shared MSP430 image loader and disassembler for the host side analysis tools.
+
+Loads a linked image (ELF, Intel HEX or TI-TXT), its function names (from the
+ELF symbol table or an IAR XLINK map file) and decodes MSP430 (not MSP430X)
+instructions with their length, stack effect and cycle count.
+
+Cycle counts are from the MSP430x2xx Family User's Guide (SLAU144),
+tables 3-14 to 3-16.  Constant generator sources are timed as register mode.
+
+Revision History
+2026-10-19  File created
+"""
+
+import re
+import struct
+
+REG_NAMES = ["PC", "SP", "SR", "R3"] + ["R%d" % i for i in range(4, 16)]
+PC, SP, SR, CG = 0, 1, 2, 3
+
+FORMAT_I = {0x4: "MOV", 0x5: "ADD", 0x6: "ADDC", 0x7: "SUBC", 0x8: "SUB", 0x9: "CMP",
+            0xA: "DADD", 0xB: "BIT", 0xC: "BIC", 0xD: "BIS", 0xE: "XOR", 0xF: "AND"}
+FORMAT_II = ["RRC", "SWPB", "RRA", "SXT", "PUSH", "CALL", "RETI", None]
+JUMPS = ["JNE", "JEQ", "JLO", "JHS", "JN", "JGE", "JL", "JMP"]
+
+CPUOFF = 0x0010
+GIE = 0x0008
+
+VECTOR_NAMES = {0xFFE0: "vector FFE0", 0xFFE2: "vector FFE2", 0xFFE4: "PORT1", 0xFFE6: "PORT2",
+                0xFFE8: "vector FFE8", 0xFFEA: "ADC10", 0xFFEC: "USCIAB0TX", 0xFFEE: "USCIAB0RX",
+                0xFFF0: "TIMER0_A1", 0xFFF2: "TIMER0_A0", 0xFFF4: "WDT", 0xFFF6: "COMPARATORA",
+                0xFFF8: "TIMER1_A1", 0xFFFA: "TIMER1_A0", 0xFFFC: "NMI", 0xFFFE: "RESET"}
+
+
+class Image:
+    """Bytes of the linked image by address, and function names."""
+
+    def __init__(self):
+        self.memory = {}
+        self.symbols = {}         # address -> name, functions only where known
+        self.data_symbols = {}    # address -> name, objects from ELF
+
+    def word(self, address):
+        if address not in self.memory or address + 1 not in self.memory:
+            raise KeyError("no code at %04X" % address)
+        return self.memory[address] | (self.memory[address + 1] << 8)
+
+    def has(self, address):
+        return address in self.memory
+
+    def name(self, address):
+        return self.symbols.get(address, "%04X" % address)
+
+    def address_of(self, name):
+        for address, symbol in self.symbols.items():
+            if symbol == name:
+                return address
+        return None
+
+    def vectors(self):
+        """Interrupt and reset vector table entries that are programmed: vector address -> handler."""
+        table = {}
+        for vector in range(0xFFE0, 0x10000, 2):
+            if self.has(vector):
+                handler = self.word(vector)
+                if handler != 0xFFFF:
+                    table[vector] = handler
+        return table
+
+
+def load(path, map_path=None):
+    image = Image()
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:4] == b"\x7fELF":
+        _load_elf(image, data)
+    else:
+        text = data.decode("ascii", "replace")
+        if text.lstrip().startswith(":"):
+            _load_hex(image, text)
+        elif text.lstrip().startswith("@"):
+            _load_ti_txt(image, text)
+        else:
+            raise ValueError("%s: not ELF, Intel HEX or TI-TXT" % path)
+    if map_path:
+        load_map(image, map_path)
+    return image
+
+
+def _load_hex(image, text):
+    base = 0
+    for line in text.splitlines():
+        line = line.strip()
+        if not line.startswith(":"):
+            continue
+        record = bytes.fromhex(line[1:])
+        count, address, kind = record[0], (record[1] << 8) | record[2], record[3]
+        payload = record[4:4 + count]
+        if kind == 0:
+            for i, byte in enumerate(payload):
+                image.memory[base + address + i] = byte
+        elif kind == 2:
+            base = ((payload[0] << 8) | payload[1]) << 4
+        elif kind == 4:
+            base = ((payload[0] << 8) | payload[1]) << 16
+        elif kind == 1:
+            break
+
+
+def _load_ti_txt(image, text):
+    address = 0
+    for line in text.splitlines():
+        line = line.strip()
+        if line.startswith("@"):
+            address = int(line[1:], 16)
+        elif line.lower() == "q":
+            break
+        elif line:
+            for byte in line.split():
+                image.memory[address] = int(byte, 16)
+                address += 1
+
+
+def _load_elf(image, data):
+    if data[4] != 1 or data[5] != 1:
+        raise ValueError("only 32 bit little endian ELF is supported")
+    (e_phoff, e_shoff) = struct.unpack_from("<II", data, 28)
+    (e_phentsize, e_phnum, e_shentsize, e_shnum) = struct.unpack_from("<HHHH", data, 42)
+    for i in range(e_phnum):
+        p_type, p_offset, p_vaddr, p_paddr, p_filesz = struct.unpack_from("<IIIII", data, e_phoff + i * e_phentsize)
+        if p_type == 1:
+            for j in range(p_filesz):
+                image.memory[p_paddr + j] = data[p_offset + j]
+    sections = [struct.unpack_from("<IIIIIIIIII", data, e_shoff + i * e_shentsize) for i in range(e_shnum)]
+    for section in sections:
+        if section[1] != 2:      # SHT_SYMTAB
+            continue
+        strtab = sections[section[6]]
+        for offset in range(section[4], section[4] + section[5], 16):
+            st_name, st_value, st_size, st_info = struct.unpack_from("<IIIB", data, offset)
+            name_start = strtab[4] + st_name
+            name = data[name_start:data.index(b"\0", name_start)].decode()
+            if not name or name.startswith("."):
+                continue
+            if st_info & 0xF == 2:       # STT_FUNC
+                image.symbols[st_value] = name
+            elif st_info & 0xF == 1:     # STT_OBJECT
+                image.data_symbols[st_value] = name
+
+
+def load_map(image, map_path):
+    """Function names from an IAR XLINK map: any 'name  ADDRESS' pair with the address in flash."""
+    entry = re.compile(r"^\s+([A-Za-z_?][\w?]*)\s+([0-9A-Fa-f]{4})\b")
+    with open(map_path, errors="replace") as f:
+        for line in f:
+            match = entry.match(line)
+            if match:
+                address = int(match.group(2), 16)
+                if 0xF000 <= address < 0xFFE0 and image.has(address):
+                    image.symbols.setdefault(address, match.group(1))
+
+
+class Operand:
+    def __init__(self, mode, reg, value=None):
+        self.mode = mode          # "reg", "idx", "sym", "abs", "ind", "inc", "imm"
+        self.reg = reg
+        self.value = value
+
+    def __str__(self):
+        if self.mode == "reg":
+            return REG_NAMES[self.reg]
+        if self.mode == "imm":
+            return "#0x%X" % self.value
+        if self.mode == "abs":
+            return "&0x%04X" % self.value
+        if self.mode == "sym":
+            return "0x%04X" % self.value
+        if self.mode == "idx":
+            return "%d(%s)" % (self.value if self.value < 0x8000 else self.value - 0x10000, REG_NAMES[self.reg])
+        if self.mode == "ind":
+            return "@" + REG_NAMES[self.reg]
+        return "@%s+" % REG_NAMES[self.reg]
+
+
+class Instruction:
+    """One decoded instruction.
+
+    kind: "op" falls through, "jump" / "cjump" go to target, "call", "ret", "reti",
+    "branch" is BR with a known target, "computed" is an indirect branch or call.
+    stack: bytes the instruction pushes (negative for pops), None if SP is changed in a way
+    that is not a push, pop or constant adjust."""
+
+    def __init__(self, address, size, text, cycles, kind, target=None, stack=0, operands=()):
+        self.address = address
+        self.size = size
+        self.text = text
+        self.cycles = cycles
+        self.kind = kind
+        self.target = target
+        self.stack = stack
+        self.operands = operands
+
+    @property
+    def next(self):
+        return (self.address + self.size) & 0xFFFF
+
+
+def _source(image, address, reg, mode_bits, words):
+    if reg == CG:
+        return Operand("imm", CG, [0, 1, 2, 0xFFFF][mode_bits]), True
+    if reg == SR and mode_bits >= 2:
+        return Operand("imm", SR, [None, None, 4, 8][mode_bits]), True
+    if mode_bits == 0:
+        return Operand("reg", reg), False
+    if mode_bits == 1:
+        word = image.word(address + 2 * len(words) + 2)
+        words.append(word)
+        if reg == PC:
+            return Operand("sym", PC, (address + 2 * len(words) + word) & 0xFFFF), False
+        if reg == SR:
+            return Operand("abs", SR, word), False
+        return Operand("idx", reg, word), False
+    if mode_bits == 2:
+        return Operand("ind", reg), False
+    if reg == PC:
+        word = image.word(address + 2 * len(words) + 2)
+        words.append(word)
+        return Operand("imm", PC, word), False
+    return Operand("inc", reg), False
+
+
+def _destination(image, address, reg, mode_bit, words):
+    if mode_bit == 0:
+        return Operand("reg", reg)
+    word = image.word(address + 2 * len(words) + 2)
+    words.append(word)
+    if reg == PC:
+        return Operand("sym", PC, (address + 2 * len(words) + word) & 0xFFFF)
+    if reg == SR:
+        return Operand("abs", SR, word)
+    return Operand("idx", reg, word)
+
+
+def _format_i_cycles(src, src_cg, dst):
+    if src.mode == "reg" or src_cg:
+        src_class = "reg"
+    elif src.mode == "ind":
+        src_class = "ind"
+    elif src.mode in ("inc", "imm"):
+        src_class = "inc"
+    else:
+        src_class = "mem"
+    if dst.mode == "reg":
+        if dst.reg == PC:
+            return {"reg": 2, "ind": 2, "inc": 3, "mem": 3}[src_class]
+        return {"reg": 1, "ind": 2, "inc": 2, "mem": 3}[src_class]
+    return {"reg": 4, "ind": 5, "inc": 5, "mem": 6}[src_class]
+
+
+def decode(image, address):
+    word = image.word(address)
+    words = []
+
+    if word & 0xE000 == 0x2000:
+        condition = (word >> 10) & 7
+        offset = word & 0x3FF
+        if offset & 0x200:
+            offset -= 0x400
+        target = (address + 2 + 2 * offset) & 0xFFFF
+        kind = "jump" if condition == 7 else "cjump"
+        return Instruction(address, 2, "%s 0x%04X" % (JUMPS[condition], target), 2, kind, target)
+
+    opcode = word >> 12
+    if opcode in FORMAT_I:
+        mnemonic = FORMAT_I[opcode]
+        byte = ".B" if word & 0x40 else ""
+        src, src_cg = _source(image, address, (word >> 8) & 0xF, (word >> 4) & 3, words)
+        dst = _destination(image, address, word & 0xF, (word >> 7) & 1, words)
+        size = 2 + 2 * len(words)
+        cycles = _format_i_cycles(src, src_cg, dst)
+        text = "%s%s %s, %s" % (mnemonic, byte, src, dst)
+        kind, target, stack = "op", None, 0
+        writes = mnemonic not in ("CMP", "BIT")
+
+        if dst.mode == "reg" and dst.reg == PC and writes:
+            if mnemonic == "MOV" and src.mode == "inc" and src.reg == SP:
+                kind, text, stack = "ret", "RET", -2
+            elif mnemonic == "MOV" and src.mode == "imm" and not src_cg:
+                kind, target, text = "branch", src.value, "BR #0x%04X" % src.value
+            else:
+                kind = "computed"
+        elif dst.mode == "reg" and dst.reg == SP and writes:
+            if mnemonic == "SUB" and src.mode == "imm":
+                stack = src.value
+            elif mnemonic == "ADD" and src.mode == "imm":
+                stack = -src.value if src.value < 0x8000 else 0x10000 - src.value
+            elif mnemonic == "MOV" and src.mode == "imm":
+                stack = None
+                kind = "setsp"
+            else:
+                stack = None
+        if src.mode == "inc" and src.reg == SP:
+            if kind != "ret":
+                stack = -2
+                if mnemonic == "MOV":
+                    text = "POP%s %s" % (byte, dst)
+        return Instruction(address, size, text, cycles, kind, target, stack, (src, dst))
+
+    if word & 0xFC00 == 0x1000:
+        operation = FORMAT_II[(word >> 7) & 7]
+        if operation is None:
+            raise ValueError("%04X: undefined opcode %04X" % (address, word))
+        if operation == "RETI":
+            return Instruction(address, 2, "RETI", 5, "reti", stack=-4)
+        byte = ".B" if word & 0x40 else ""
+        src, src_cg = _source(image, address, word & 0xF, (word >> 4) & 3, words)
+        size = 2 + 2 * len(words)
+        if src.mode == "reg" or src_cg:
+            cycles = {"RRC": 1, "SWPB": 1, "RRA": 1, "SXT": 1, "PUSH": 3, "CALL": 4}[operation]
+        elif src.mode == "ind":
+            cycles = {"PUSH": 4, "CALL": 4}.get(operation, 3)
+        elif src.mode == "inc":
+            cycles = {"PUSH": 5, "CALL": 5}.get(operation, 3)
+        elif src.mode == "imm":
+            cycles = {"PUSH": 4, "CALL": 5}.get(operation, 3)
+        else:
+            cycles = {"PUSH": 5, "CALL": 5}.get(operation, 4)
+        text = "%s%s %s" % (operation, byte, src)
+        if operation == "PUSH":
+            return Instruction(address, size, text, cycles, "op", stack=2, operands=(src,))
+        if operation == "CALL":
+            if src.mode == "imm" and not src_cg:
+                return Instruction(address, size, text, cycles, "call", src.value, operands=(src,))
+            return Instruction(address, size, text, cycles, "computedcall", operands=(src,))
+        stack = None if src.mode == "reg" and src.reg == SP else 0
+        return Instruction(address, size, text, cycles, "op", stack=stack, operands=(src,))
+
+    raise ValueError("%04X: undefined opcode %04X" % (address, word))
+
+
+def sleeps(instruction):
+    """True for BIS #x, SR that sets CPUOFF, the C __bis_SR_register(LPMx_bits)."""
+    if not instruction.text.startswith("BIS") or len(instruction.operands) != 2:
+        return False
+    src, dst = instruction.operands
+    return dst.mode == "reg" and dst.reg == SR and src.mode == "imm" and (src.value & CPUOFF) != 0
+
+
+def enables_interrupts(instruction):
+    """True for EINT and any BIS #x, SR that sets GIE."""
+    if not instruction.text.startswith("BIS") or len(instruction.operands) != 2:
+        return False
+    src, dst = instruction.operands
+    return dst.mode == "reg" and dst.reg == SR and src.mode == "imm" and (src.value & GIE) != 0
+
+
+def jump_table(image, instruction):
+    """For ADD x, PC (a switch, as IAR generates for __even_in_range) the JMPs of the table that follows."""
+    targets = []
+    if instruction.kind != "computed" or not instruction.text.startswith("ADD"):
+        return targets
+    address = instruction.next
+    while len(targets) < 32 and image.has(address):
+        entry = decode(image, address)
+        if entry.kind != "jump":
+            break
+        targets.append(entry.address)
+        address = entry.next
+    return targets
+
+
+class Function:
+    def __init__(self, entry):
+        self.entry = entry
+        self.instructions = {}    # address -> Instruction
+        self.calls = set()        # direct call and tail call targets
+        self.computed_calls = []  # addresses of calls and branches through pointers
+        self.enables_interrupts = False
+
+
+class Program:
+    """The functions reachable from the vectors, found by following the code.
+
+    Calls through pointers (CALL R15, CALL &GG_fpCLOCKSM) are taken to reach every function
+    whose address the program loads as a constant.  With symbols only named functions count,
+    without them any even constant in the code range does.  More targets can be given with
+    indirect, a list of addresses."""
+
+    def __init__(self, image, indirect=(), code_start=0xF000, code_end=0xFFE0):
+        self.image = image
+        self.code_start = code_start
+        self.code_end = code_end
+        self.functions = {}
+        self.taken = set(indirect)
+        self.warnings = []
+        self.roots = dict((handler, VECTOR_NAMES.get(vector, "%04X" % vector))
+                          for vector, handler in image.vectors().items())
+        pending = list(self.roots)
+        while pending:
+            while pending:
+                entry = pending.pop()
+                if entry not in self.functions:
+                    pending.extend(self._explore(entry))
+            for entry in self.taken:
+                if entry not in self.functions:
+                    pending.append(entry)
+
+    def is_entry(self, address):
+        return address in self.image.symbols or address in self.functions or address in self.roots
+
+    def _explore(self, entry):
+        function = Function(entry)
+        self.functions[entry] = function
+        found = []
+        work = [entry]
+        while work:
+            address = work.pop()
+            if address in function.instructions:
+                continue
+            try:
+                instruction = decode(self.image, address)
+            except (ValueError, KeyError) as error:
+                self.warnings.append("%s: %s" % (self.image.name(entry), error))
+                continue
+            function.instructions[address] = instruction
+            if enables_interrupts(instruction):
+                function.enables_interrupts = True
+            for operand in instruction.operands:
+                if (operand.mode == "imm" and operand.reg == PC and self.code_start <= operand.value < self.code_end
+                        and not operand.value & 1 and instruction.kind not in ("call", "branch")):
+                    if not self.image.symbols or operand.value in self.image.symbols:
+                        self.taken.add(operand.value)
+            if instruction.kind == "call":
+                function.calls.add(instruction.target)
+                found.append(instruction.target)
+                work.append(instruction.next)
+            elif instruction.kind == "computedcall":
+                function.computed_calls.append(address)
+                work.append(instruction.next)
+            elif instruction.kind == "branch":
+                if self.is_entry(instruction.target) and instruction.target != entry:
+                    function.calls.add(instruction.target)
+                    found.append(instruction.target)
+                else:
+                    work.append(instruction.target)
+            elif instruction.kind == "jump":
+                work.append(instruction.target)
+            elif instruction.kind == "cjump":
+                work.append(instruction.target)
+                work.append(instruction.next)
+            elif instruction.kind == "computed":
+                table = jump_table(self.image, instruction)
+                if table:
+                    work.extend(table)
+                else:
+                    function.computed_calls.append(address)
+                    self.warnings.append("%s: computed branch at %04X is treated as a tail call through a pointer"
+                                         % (self.image.name(entry), address))
+            elif instruction.kind in ("op", "setsp"):
+                work.append(instruction.next)
+        return found
+
+    def callees(self, function):
+        """Every function a function can call: direct calls, tail calls and calls through pointers."""
+        targets = set(function.calls)
+        if function.computed_calls:
+            targets |= self.taken
+        return targets
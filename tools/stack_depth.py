@@ -0,0 +1,195 @@
+#!/usr/bin/env python3
+"""Worst case stack depth of the binary clock firmware from its linked image.
+
+Follows the code from the reset vector and every interrupt vector, tracks SP through
+PUSH, POP, SUB/ADD #n,SP and CALL, and adds up the deepest chain of calls.  Calls through
+GG_fpCLOCKSM and other function pointers reach every function whose address the code loads,
+see msp430.Program.
+
+The worst case is the deepest main loop chain plus the deepest interrupt, 4 bytes for the
+PC and SR it pushes and its own chain.  The ISRs do not enable interrupts so they do not
+nest; if one does it is reported and every ISR is added on top.
+
+Usage:
+    stack_depth.py image [--map file.map] [--stack-size bytes] [--indirect name_or_address ...]
+
+image is the linked output, ELF (GNU build) or Intel HEX / TI-TXT (IAR, with --map for names).
+--stack-size is the CSTACK size to compare against, the console W command reads it on the board.
+
+Revision History
+2026-10-19  File created
+"""
+
+import argparse
+import sys
+
+import msp430
+
+ISR_FRAME = 4        # PC and SR pushed when an interrupt is accepted
+
+
+class StackAnalysis:
+    def __init__(self, program):
+        self.program = program
+        self.image = program.image
+        self.depth = {}          # entry -> deepest bytes below the entry SP, not counting the return address
+        self.deepest_call = {}   # entry -> callee on the deepest chain, or None
+        self.frame = {}          # entry -> own bytes, without calls
+        self.active = set()
+        self.recursive = set()
+
+    def function_depth(self, entry):
+        if entry in self.depth:
+            return self.depth[entry]
+        if entry in self.active:
+            self.recursive.add(entry)
+            return 0
+        if entry not in self.program.functions:
+            self.program.warnings.append("%s: not decoded, counted as 0" % self.image.name(entry))
+            return 0
+        self.active.add(entry)
+        function = self.program.functions[entry]
+        offsets = {}
+        work = [(entry, 0)]
+        deepest, deepest_call, frame = 0, None, 0
+        while work:
+            address, offset = work.pop()
+            if address in offsets and offsets[address] >= offset:
+                continue
+            if address in offsets:
+                self.program.warnings.append("%s: SP differs on two paths to %04X" % (self.image.name(entry), address))
+            offsets[address] = offset
+            instruction = function.instructions.get(address)
+            if instruction is None:
+                continue
+
+            callees = []
+            if instruction.kind == "call":
+                callees = [(instruction.target, 2)]
+            elif instruction.kind == "computedcall":
+                callees = [(target, 2) for target in self.program.taken]
+            elif instruction.kind == "branch" and instruction.target in function.calls:
+                callees = [(instruction.target, 0)]
+            elif instruction.kind == "computed" and address in function.computed_calls:
+                callees = [(target, 0) for target in self.program.taken]
+            for callee, return_address in callees:
+                depth = offset + return_address + self.function_depth(callee)
+                if depth > deepest:
+                    deepest, deepest_call = depth, callee
+
+            if instruction.kind == "setsp":
+                following = 0                       # cstartup setting SP to the top of CSTACK
+            elif instruction.stack is None:
+                self.program.warnings.append("%s: SP changed at %04X by %s, not followed"
+                                             % (self.image.name(entry), address, instruction.text))
+                following = offset
+            else:
+                following = offset + instruction.stack
+            if following > deepest:
+                deepest, deepest_call = following, None
+            frame = max(frame, following)
+
+            if instruction.kind in ("op", "setsp", "call", "computedcall"):
+                work.append((instruction.next, following))
+            elif instruction.kind == "jump":
+                work.append((instruction.target, following))
+            elif instruction.kind == "cjump":
+                work.append((instruction.target, following))
+                work.append((instruction.next, following))
+            elif instruction.kind == "branch" and instruction.target not in function.calls:
+                work.append((instruction.target, following))
+            elif instruction.kind == "computed" and address not in function.computed_calls:
+                for target in msp430.jump_table(self.image, instruction):
+                    work.append((target, following))
+
+        self.active.discard(entry)
+        self.depth[entry] = deepest
+        self.deepest_call[entry] = deepest_call
+        self.frame[entry] = frame
+        return deepest
+
+    def chain(self, entry):
+        names = [self.image.name(entry)]
+        seen = {entry}
+        while self.deepest_call.get(entry) is not None:
+            entry = self.deepest_call[entry]
+            if entry in seen:
+                break
+            seen.add(entry)
+            names.append(self.image.name(entry))
+        return " -> ".join(names)
+
+
+def reachable(program, entry):
+    found = {entry}
+    work = [entry]
+    while work:
+        function = program.functions.get(work.pop())
+        if function is None:
+            continue
+        for callee in program.callees(function):
+            if callee not in found:
+                found.add(callee)
+                work.append(callee)
+    return [entry for entry in found if entry in program.functions]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("image")
+    parser.add_argument("--map", help="IAR XLINK map file for function names")
+    parser.add_argument("--stack-size", type=int, help="CSTACK bytes, to report the headroom")
+    parser.add_argument("--indirect", nargs="*", default=[], help="more targets of calls through pointers")
+    parser.add_argument("--all", action="store_true", help="list every function, not only the roots")
+    arguments = parser.parse_args()
+
+    image = msp430.load(arguments.image, arguments.map)
+    indirect = []
+    for target in arguments.indirect:
+        address = image.address_of(target)
+        indirect.append(address if address is not None else int(target, 16))
+    program = msp430.Program(image, indirect)
+    analysis = StackAnalysis(program)
+
+    reset = image.vectors().get(0xFFFE)
+    if reset is None:
+        sys.exit("no reset vector in the image")
+    main_depth = analysis.function_depth(reset)
+    print("%-12s %5d  %s" % ("RESET", main_depth, analysis.chain(reset)))
+
+    isr_depths = []
+    nesting = []
+    for handler, vector_name in sorted(program.roots.items(), key=lambda item: item[1]):
+        if handler == reset:
+            continue
+        depth = ISR_FRAME + analysis.function_depth(handler)
+        isr_depths.append(depth)
+        print("%-12s %5d  %s" % (vector_name, depth, analysis.chain(handler)))
+        if any(program.functions[entry].enables_interrupts for entry in reachable(program, handler)):
+            nesting.append(vector_name)
+
+    if nesting:
+        worst = main_depth + sum(isr_depths)
+        print("\nInterrupts are enabled inside %s, every ISR is counted as nested" % ", ".join(nesting))
+    else:
+        worst = main_depth + max(isr_depths or [0])
+    print("\nWorst case stack: %d bytes (main loop %d + deepest interrupt %d)"
+          % (worst, main_depth, worst - main_depth))
+    if arguments.stack_size:
+        print("CSTACK %d bytes, headroom %d bytes" % (arguments.stack_size, arguments.stack_size - worst))
+
+    if analysis.recursive:
+        print("\nRecursion, depth is NOT bounded: %s" % ", ".join(image.name(entry) for entry in analysis.recursive))
+    if program.taken:
+        print("\nCalled through pointers: %s" % ", ".join(sorted(image.name(entry) for entry in program.taken)))
+    if arguments.all:
+        print("\n%-32s %5s %5s" % ("function", "frame", "depth"))
+        for entry in sorted(analysis.depth, key=lambda entry: -analysis.depth[entry]):
+            print("%-32s %5d %5d" % (image.name(entry), analysis.frame[entry], analysis.depth[entry]))
+    for warning in sorted(set(program.warnings)):
+        print("warning: " + warning, file=sys.stderr)
+    return 1 if analysis.recursive or (arguments.stack_size and worst > arguments.stack_size) else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
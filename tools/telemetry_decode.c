@@ -0,0 +1,229 @@
+/**********************************************************************
+* Host side decoder for the binary clock telemetry log
+*
+* The clock sends the log over the console, in hex, as the reply to the
+* E command ("E 6103C2..." ).  An empty reply ("E ") means the log is empty.
+*
+* Build:   cc -O2 -o telemetry_decode telemetry_decode.c
+* Use:     telemetry_decode < transcript.txt     decode the E lines of a saved console session
+*          telemetry_decode /dev/ttyUSB0         drain the clock's log directly, 9600 8N1
+*
+* The clock must be in MODE_CONSOLE for the second form.
+**********************************************************************/
+
+/************************ Revision History ****************************
+YYYY-MM-DD  Comments
+-------------------------------------------------------------------------------------------
+2026-10-19  File created
+
+************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+/* Must match telemetry.h */
+#define TELEMETRY_EVENT_SHIFT  5
+#define TELEMETRY_DELTA_LONG   0x1F
+#define EVENT_RESET            0
+#define EVENT_HOUR             6
+#define EVENT_HAS_DATA(event)  ((event) == EVENT_RESET || (event) == EVENT_HOUR)
+#define TICK_SECONDS           0.25
+
+#define LINE_SIZE              256
+#define LOG_SIZE               4096
+
+const char* apcEvent_Name[] = {"reset", "power lost", "power back", "button 0", "button 1", "button 2",
+                               "hour", "time set"};
+
+unsigned char au8Log[LOG_SIZE];
+int iLog_Count = 0;
+
+/*------------------------------------------------------------------------------
+Function: Add_Line
+
+Description: Adds the hex bytes of one E reply line to the log, other lines are ignored
+
+Promises: Returns 1 if the line was an E reply with at least one byte, 0 otherwise
+*/
+int Add_Line(const char* pcLine)
+{
+  int iAdded = 0;
+  unsigned int uByte;
+
+  while(*pcLine == '\r' || *pcLine == '\n' || *pcLine == ' ')
+  {
+    pcLine++;
+  }
+  if(pcLine[0] != 'E' || pcLine[1] != ' ')
+  {
+    return 0;
+  }
+  pcLine += 2;
+  while(isxdigit((unsigned char)pcLine[0]) && isxdigit((unsigned char)pcLine[1]) && iLog_Count < LOG_SIZE)
+  {
+    sscanf(pcLine, "%2x", &uByte);
+    au8Log[iLog_Count++] = (unsigned char)uByte;
+    pcLine += 2;
+    iAdded = 1;
+  }
+  return iAdded;
+
+} /* end Add_Line */
+
+/*------------------------------------------------------------------------------
+Function: Read_Serial
+
+Description: Sends E to the clock until it answers with an empty log
+
+Promises: Returns 0 on success
+*/
+int Read_Serial(const char* pcDevice)
+{
+  struct termios Tty;
+  char acLine[LINE_SIZE];
+  int iFd;
+  int iLength;
+  int iTimeouts;
+  char c;
+
+  iFd = open(pcDevice, O_RDWR | O_NOCTTY);
+  if(iFd < 0)
+  {
+    perror(pcDevice);
+    return 1;
+  }
+  tcgetattr(iFd, &Tty);
+  cfmakeraw(&Tty);
+  cfsetispeed(&Tty, B9600);
+  cfsetospeed(&Tty, B9600);
+  Tty.c_cflag |= CLOCAL | CREAD;
+  Tty.c_cc[VMIN] = 0;
+  Tty.c_cc[VTIME] = 10;           //1 second per read
+  tcsetattr(iFd, TCSANOW, &Tty);
+  tcflush(iFd, TCIOFLUSH);
+
+  do
+  {
+    //one command at a time, the clock's transmit ring only holds one reply
+    write(iFd, "E\r", 2);
+    iLength = 0;
+    iTimeouts = 0;
+    while(iTimeouts < 3)
+    {
+      if(read(iFd, &c, 1) != 1)
+      {
+        iTimeouts++;
+        continue;
+      }
+      if(c == '\n')
+      {
+        break;
+      }
+      if(iLength < LINE_SIZE - 1)
+      {
+        acLine[iLength++] = c;
+      }
+    }
+    acLine[iLength] = '\0';
+    if(iTimeouts == 3)
+    {
+      fprintf(stderr, "%s: no reply, is the clock in console mode?\n", pcDevice);
+      close(iFd);
+      return 1;
+    }
+  } while(Add_Line(acLine));
+
+  close(iFd);
+  return 0;
+
+} /* end Read_Serial */
+
+/*------------------------------------------------------------------------------
+Function: Decode
+
+Description: Prints the log, one record per line.  Times are seconds from the first record, a reset
+restarts the clock's tick count so the time after one is only known from the next hour record.
+*/
+void Decode()
+{
+  int i = 0;
+  int iEvent;
+  int iData;
+  unsigned int uDelta;
+  double dTime = 0;
+  int iSegment = 0;
+
+  while(i < iLog_Count)
+  {
+    iEvent = au8Log[i] >> TELEMETRY_EVENT_SHIFT;
+    uDelta = au8Log[i] & TELEMETRY_DELTA_LONG;
+    i++;
+    if(uDelta == TELEMETRY_DELTA_LONG)
+    {
+      if(i + 2 > iLog_Count)
+      {
+        printf("truncated record\n");
+        return;
+      }
+      uDelta = au8Log[i] | (au8Log[i + 1] << 8);
+      i += 2;
+    }
+    iData = -1;
+    if(EVENT_HAS_DATA(iEvent))
+    {
+      if(i + 1 > iLog_Count)
+      {
+        printf("truncated record\n");
+        return;
+      }
+      iData = au8Log[i++];
+    }
+
+    if(iEvent == EVENT_RESET)
+    {
+      iSegment++;
+      dTime = 0;
+      printf("---- segment %d\n", iSegment);
+    }
+    dTime += uDelta * TICK_SECONDS;
+    printf("%10.2f  %-10s", dTime, apcEvent_Name[iEvent]);
+    if(iEvent == EVENT_RESET)
+    {
+      printf("  IFG1 0x%02X%s%s%s%s", iData, (iData & 0x01) ? " WDT" : "", (iData & 0x04) ? " POR" : "",
+             (iData & 0x08) ? " RST" : "", (iData & 0x10) ? " NMI" : "");
+    }
+    else if(iEvent == EVENT_HOUR)
+    {
+      printf("  %02d:00", iData);
+    }
+    printf("\n");
+  }
+
+} /* end Decode */
+
+int main(int argc, char** argv)
+{
+  char acLine[LINE_SIZE];
+
+  if(argc > 1)
+  {
+    if(Read_Serial(argv[1]))
+    {
+      return 1;
+    }
+  }
+  else
+  {
+    while(fgets(acLine, sizeof(acLine), stdin))
+    {
+      Add_Line(acLine);
+    }
+  }
+  Decode();
+  return 0;
+}
@@ -0,0 +1,245 @@
+#!/usr/bin/env python3
+"""Worst case execution time bounds for the binary clock firmware from its linked image.
+
+Bounds the cycles of every interrupt handler and every state function (the functions called
+through GG_fpCLOCKSM) and checks that the work of one 250ms Timer A tick fits in the 8192
+cycles MCLK runs in that time (MCLK is the 32768Hz crystal).
+
+Each function is bounded by its longest path: instruction cycles from msp430.py, plus the
+bound of every function it calls, with each loop counted as its bound times its longest body.
+A state function's path ends where it goes to sleep (BIS #LPMx, SR) or returns.  Loop bounds
+come from the C source and are in LOOP_BOUNDS by function name; a loop with no bound uses
+--default-bound and is listed as assumed.  Loops the compiler has unrolled need no bound.
+
+The tick budget is the worst wake of the main loop plus the interrupts of one tick:
+    ClockSM_Tick, the state it hands over to without sleeping, then ClockSM_Tick again
+    + each ISR's bound times how often it can run in a tick, INTERRUPTS_PER_TICK
+Both tables describe the firmware as it is, change them with the code.
+
+Usage:
+    wcet.py image [--map file.map] [--bound name=n[,n...]] [--rate vector=n] [--default-bound n]
+
+Revision History
+2026-10-19  File created
+"""
+
+import argparse
+import re
+import sys
+
+import msp430
+
+TICK_CYCLES = 8192             # TIMERA_PERIOD, MCLK = ACLK = 32768Hz
+INTERRUPT_ENTRY = 6            # cycles to accept an interrupt, RETI is counted in the handler
+
+# Most times each loop body runs, per function, in the order of the loops in the code.
+# The last value is used for any further loops of the function.
+LOOP_BOUNDS = {
+    "Update_Display": [4, 3],          # the minute and hour LED bits
+    "Display_Frame": [4, 3],
+    "Update_Display_Hours": [4],       # LEDS_FOR_HOURS
+    "ClockSM_Button_Press": [11],      # subtracting the minute step of 5 from at most 59
+    "Alarm_Select_Next": [3],          # ALARM_COUNT + 1
+    "ClockSM_Console": [8],            # command lines, at most CONSOLE_RX_SIZE / 2
+    "Console_Reply": [12],             # TELEMETRY_BURST
+    "Console_Read_Line": [8, 16],      # lines, bytes of CONSOLE_RX_SIZE
+    "Console_Numbers": [16, 5],        # CONSOLE_LINE_SIZE, digits of a u16
+    "Console_Put_String": [31],        # CONSOLE_TX_SIZE - 1
+    "Console_Put_Number": [10, 10, 10],   # digits of a u32
+    "Counters_Initialize": [10],       # COUNTERS
+    "Profile_Initialize": [5, 8],      # PROFILE_SITES, PROFILE_OVERHEAD_RUNS
+    "Profile_Cancel": [5],
+    "Stack_Used": [256],               # words of RAM
+    "Telemetry_Log": [5],              # records dropped for the record and the byte kept free, at most 4 + 1
+    "Telemetry_Drain": [12, 4],        # TELEMETRY_BURST, record length
+}
+# Compiler library helpers, by name pattern
+LIBRARY_BOUNDS = [(re.compile(r"Div|Mod|div|mod"), 32), (re.compile(r"Mul|mul|mpy"), 16),
+                  (re.compile(r"memzero|memcpy|memset"), 512)]
+
+# Most times each interrupt can run in one 250ms tick
+INTERRUPTS_PER_TICK = {
+    "TIMER0_A1": 1 + 4 + 12,   # TAIFG, 4 fast button samples, melody notes at most every NOTE_GAP
+    "PORT2": 2,                # power loss and button 0
+    "TIMER1_A0": 1,            # auto-repeat
+    "TIMER1_A1": 32,           # release sampling every TIME_SET_SAMPLE (256 counts) while held
+    "USCIAB0TX": 128 + 31,     # the 4096Hz tone needs a byte every 64 cycles, and a console reply
+    "USCIAB0RX": 16,           # one command line; a host that does not wait for replies can send 240
+}
+
+
+class Wcet:
+    def __init__(self, program, default_bound, bounds):
+        self.program = program
+        self.image = program.image
+        self.default_bound = default_bound
+        self.bounds = bounds
+        self.cycles = {}
+        self.active = set()
+        self.recursive = set()
+        self.assumed = []
+
+    def loop_bounds(self, entry):
+        name = self.image.symbols.get(entry)
+        if name in self.bounds:
+            return self.bounds[name]
+        for pattern, bound in LIBRARY_BOUNDS:
+            if name and pattern.search(name):
+                return [bound]
+        return None
+
+    def call_cycles(self, function, instruction):
+        if instruction.kind == "call":
+            return self.function_cycles(instruction.target)
+        if instruction.kind == "branch" and instruction.target in function.calls:
+            return self.function_cycles(instruction.target)
+        if instruction.kind == "computedcall" or (instruction.kind == "computed"
+                                                   and instruction.address in function.computed_calls):
+            return max([self.function_cycles(target) for target in self.program.taken] or [0])
+        return 0
+
+    def successors(self, function, instruction):
+        if msp430.sleeps(instruction):
+            return []
+        kind = instruction.kind
+        if kind in ("op", "setsp", "call", "computedcall"):
+            return [instruction.next]
+        if kind == "jump":
+            return [] if instruction.target == instruction.address else [instruction.target]
+        if kind == "cjump":
+            return [instruction.target, instruction.next]
+        if kind == "branch" and instruction.target not in function.calls:
+            return [instruction.target]
+        if kind == "computed" and instruction.address not in function.computed_calls:
+            return msp430.jump_table(self.image, instruction)
+        return []
+
+    def function_cycles(self, entry):
+        if entry in self.cycles:
+            return self.cycles[entry]
+        if entry in self.active:
+            self.recursive.add(entry)
+            return 0
+        function = self.program.functions.get(entry)
+        if function is None:
+            return 0
+        self.active.add(entry)
+
+        cost = {}
+        forward = {}
+        back = {}
+        for address, instruction in function.instructions.items():
+            cost[address] = instruction.cycles + self.call_cycles(function, instruction)
+            forward[address] = []
+            for target in self.successors(function, instruction):
+                if target not in function.instructions:
+                    continue
+                if target <= address:
+                    back.setdefault(target, []).append(address)
+                else:
+                    forward[address].append(target)
+        order = sorted(function.instructions)
+
+        # Loops, innermost (shortest) first, each adds (bound - 1) bodies to its header
+        loops = sorted(((header, max(latches)) for header, latches in back.items()), key=lambda loop: loop[1] - loop[0])
+        bounds = self.loop_bounds(entry)
+        by_address = sorted(header for header, latch in loops)
+        for header, latch in loops:
+            index = by_address.index(header)
+            if bounds:
+                bound = bounds[min(index, len(bounds) - 1)]
+                if index >= len(bounds):
+                    self.assumed.append("%s loop %d at %04X: more loops than bounds, used %d"
+                                        % (self.image.name(entry), index + 1, header, bound))
+            else:
+                bound = self.default_bound
+                self.assumed.append("%s loop at %04X: no bound, assumed %d" % (self.image.name(entry), header, bound))
+            body = self.longest(order, forward, cost, header, lambda address: address == latch, header, latch)
+            cost[header] += (bound - 1) * body
+
+        exits = lambda address: not self.successors(function, function.instructions[address])
+        total = self.longest(order, forward, cost, entry, exits, 0, 0x10000)
+        self.active.discard(entry)
+        self.cycles[entry] = total
+        return total
+
+    @staticmethod
+    def longest(order, forward, cost, start, is_end, low, high):
+        """Longest path in cycles from start to an end, over the forward edges between low and high."""
+        best = {start: cost[start]}
+        result = 0
+        for address in order:
+            if address not in best or address < low or address > high:
+                continue
+            if is_end(address):
+                result = max(result, best[address])
+            for target in forward[address]:
+                if low <= target <= high:
+                    best[target] = max(best.get(target, 0), best[address] + cost[target])
+        return result
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("image")
+    parser.add_argument("--map", help="IAR XLINK map file for function names")
+    parser.add_argument("--bound", action="append", default=[], help="loop bounds, name=n[,n...]")
+    parser.add_argument("--rate", action="append", default=[], help="interrupts per tick, vector=n")
+    parser.add_argument("--default-bound", type=int, default=16)
+    arguments = parser.parse_args()
+
+    bounds = dict(LOOP_BOUNDS)
+    for text in arguments.bound:
+        name, values = text.split("=")
+        bounds[name] = [int(value) for value in values.split(",")]
+    rates = dict(INTERRUPTS_PER_TICK)
+    for text in arguments.rate:
+        name, value = text.split("=")
+        rates[name] = int(value)
+
+    image = msp430.load(arguments.image, arguments.map)
+    program = msp430.Program(image)
+    wcet = Wcet(program, arguments.default_bound, bounds)
+    reset = image.vectors().get(0xFFFE)
+
+    print("%-12s %7s %6s %8s" % ("interrupt", "cycles", "/tick", "per tick"))
+    interrupt_load = 0
+    for handler, vector_name in sorted(program.roots.items(), key=lambda item: item[1]):
+        if handler == reset:
+            continue
+        cycles = INTERRUPT_ENTRY + wcet.function_cycles(handler)
+        rate = rates.get(vector_name, 1)
+        interrupt_load += cycles * rate
+        print("%-12s %7d %6d %8d" % (vector_name, cycles, rate, cycles * rate))
+
+    print("\n%-32s %7s" % ("state", "cycles"))
+    states = {}
+    for entry in sorted(program.taken, key=image.name):
+        states[entry] = wcet.function_cycles(entry)
+        print("%-32s %7d" % (image.name(entry), states[entry]))
+
+    tick = image.address_of("ClockSM_Tick")
+    if tick in states:
+        others = [cycles for entry, cycles in states.items() if entry != tick]
+        wake = 2 * states[tick] + max(others or [0])
+        wake_text = "2 x ClockSM_Tick + the longest other state"
+    else:
+        wake = 2 * max(states.values() or [0])
+        wake_text = "no names, 2 x the longest state"
+    demand = wake + interrupt_load
+    print("\nWorst wake %d cycles (%s)" % (wake, wake_text))
+    print("Interrupts %d cycles per tick" % interrupt_load)
+    print("Tick %d of %d cycles, %.0f%%, slack %d cycles" % (demand, TICK_CYCLES, 100.0 * demand / TICK_CYCLES,
+                                                             TICK_CYCLES - demand))
+
+    if wcet.recursive:
+        print("\nRecursion, NOT bounded: %s" % ", ".join(image.name(entry) for entry in wcet.recursive))
+    for note in wcet.assumed:
+        print("assumed: " + note, file=sys.stderr)
+    for warning in sorted(set(program.warnings)):
+        print("warning: " + warning, file=sys.stderr)
+    return 1 if wcet.recursive or demand > TICK_CYCLES else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())